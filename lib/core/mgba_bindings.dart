@@ -1,3 +1,4 @@
+import 'dart:async';
 import 'dart:ffi';
 import 'dart:io';
 import 'dart:typed_data';
@@ -78,6 +79,103 @@ typedef MgbaCoreSetColorPalette = void Function(
 typedef MgbaCoreSetSgbBordersNative = Void Function(NativeCore core, Int32 enabled);
 typedef MgbaCoreSetSgbBorders = void Function(NativeCore core, int enabled);
 
+// ── Output pixel format ──────────────────────────────────────────────
+typedef YageCoreSetOutputFormatNative = Int32 Function(NativeCore core, Int32 format);
+typedef YageCoreSetOutputFormat = int Function(NativeCore core, int format);
+typedef YageCoreGetOutputBppNative = Int32 Function(NativeCore core);
+typedef YageCoreGetOutputBpp = int Function(NativeCore core);
+typedef YageCoreGetVideoFormatNative = Int32 Function(NativeCore core);
+typedef YageCoreGetVideoFormat = int Function(NativeCore core);
+typedef YageFrameLoopGetDisplayFormatNative = Int32 Function(NativeCore core);
+typedef YageFrameLoopGetDisplayFormat = int Function(NativeCore core);
+typedef YageCoreGetOutputPaletteNative = Int32 Function(NativeCore core, Pointer<Uint32> colors);
+typedef YageCoreGetOutputPalette = int Function(NativeCore core, Pointer<Uint32> colors);
+typedef YageFrameLoopSetScalerNative = Int32 Function(NativeCore core, Int32 mode, Int32 factor);
+typedef YageFrameLoopSetScaler = int Function(NativeCore core, int mode, int factor);
+typedef YageFrameLoopSetFrameBlendNative = Void Function(
+    NativeCore core, Int32 mode, Int32 weightPct);
+typedef YageFrameLoopSetFrameBlend = void Function(NativeCore core, int mode, int weightPct);
+typedef YageFrameLoopSetSkipDupeCallbacksNative = Void Function(NativeCore core, Int32 enabled);
+typedef YageFrameLoopSetSkipDupeCallbacks = void Function(NativeCore core, int enabled);
+typedef YageFrameLoopGetPresentStatsNative = Void Function(
+    NativeCore core, Pointer<Uint32> presented, Pointer<Uint32> skipped);
+typedef YageFrameLoopGetPresentStats = void Function(
+    NativeCore core, Pointer<Uint32> presented, Pointer<Uint32> skipped);
+typedef YageFrameLoopSetPipelinedNative = Void Function(NativeCore core, Int32 enabled);
+typedef YageFrameLoopSetPipelined = void Function(NativeCore core, int enabled);
+typedef YageFrameLoopGetPipelineStatsNative = Void Function(
+    NativeCore core, Pointer<Uint32> handoffs, Pointer<Uint32> replaced);
+typedef YageFrameLoopGetPipelineStats = void Function(
+    NativeCore core, Pointer<Uint32> handoffs, Pointer<Uint32> replaced);
+
+// Gameplay recording
+typedef YageRecordStartNative = Int32 Function(NativeCore core, Pointer<Utf8> path);
+typedef YageRecordStart = int Function(NativeCore core, Pointer<Utf8> path);
+typedef YageRecordStopNative = Void Function(NativeCore core);
+typedef YageRecordStop = void Function(NativeCore core);
+typedef YageRecordIsActiveNative = Int32 Function(NativeCore core);
+typedef YageRecordIsActive = int Function(NativeCore core);
+typedef YageRecordGetStatsNative = Void Function(NativeCore core, Pointer<Uint32> written,
+    Pointer<Uint32> dropped, Pointer<Uint32> audioDropped);
+typedef YageRecordGetStats = void Function(NativeCore core, Pointer<Uint32> written,
+    Pointer<Uint32> dropped, Pointer<Uint32> audioDropped);
+
+// Screenshots — callback(request_id, result)
+typedef NativeScreenshotCallback = Void Function(Int32 requestId, Int32 result);
+typedef YageScreenshotSaveNative = Int32 Function(NativeCore core, Pointer<Utf8> path,
+    Int32 format, Int32 maxWidth, Int32 maxHeight,
+    Pointer<NativeFunction<NativeScreenshotCallback>> callback);
+typedef YageScreenshotSave = int Function(NativeCore core, Pointer<Utf8> path, int format,
+    int maxWidth, int maxHeight, Pointer<NativeFunction<NativeScreenshotCallback>> callback);
+
+// Instant replay
+typedef YageReplayConfigureNative = Int32 Function(NativeCore core, Int32 seconds, Int64 maxBytes);
+typedef YageReplayConfigure = int Function(NativeCore core, int seconds, int maxBytes);
+typedef YageReplayDumpNative = Int32 Function(NativeCore core, Pointer<Utf8> path);
+typedef YageReplayDump = int Function(NativeCore core, Pointer<Utf8> path);
+typedef YageReplayGetStatsNative = Void Function(
+    NativeCore core, Pointer<Uint32> frames, Pointer<Uint32> bytes, Pointer<Uint32> dropped);
+typedef YageReplayGetStats = void Function(
+    NativeCore core, Pointer<Uint32> frames, Pointer<Uint32> bytes, Pointer<Uint32> dropped);
+
+// Shared-memory frame export
+typedef YageFrameExportStartNative = Int32 Function(
+    NativeCore core, Pointer<Utf8> name, Int32 slots);
+typedef YageFrameExportStart = int Function(NativeCore core, Pointer<Utf8> name, int slots);
+typedef YageFrameExportStopNative = Void Function(NativeCore core);
+typedef YageFrameExportStop = void Function(NativeCore core);
+typedef YageFrameExportIsActiveNative = Int32 Function(NativeCore core);
+typedef YageFrameExportIsActive = int Function(NativeCore core);
+typedef YageFrameExportGetStatsNative = Void Function(
+    NativeCore core, Pointer<Uint32> published, Pointer<Uint32> dropped);
+typedef YageFrameExportGetStats = void Function(
+    NativeCore core, Pointer<Uint32> published, Pointer<Uint32> dropped);
+
+// Audio pull stream
+typedef YageAudioReadNative = Int32 Function(NativeCore core, Pointer<Int16> dst, Int32 maxFrames);
+typedef YageAudioRead = int Function(NativeCore core, Pointer<Int16> dst, int maxFrames);
+typedef YageAudioReadAvailableNative = Int32 Function(NativeCore core);
+typedef YageAudioReadAvailable = int Function(NativeCore core);
+typedef YageAudioReadRateNative = Double Function(NativeCore core);
+typedef YageAudioReadRate = double Function(NativeCore core);
+
+// Audio output
+typedef YageAudioOutputStartNative = Int32 Function(
+    NativeCore core, Int32 backend, Pointer<Utf8> target);
+typedef YageAudioOutputStart = int Function(NativeCore core, int backend, Pointer<Utf8> target);
+typedef YageAudioOutputStopNative = Void Function(NativeCore core);
+typedef YageAudioOutputStop = void Function(NativeCore core);
+typedef YageAudioOutputGetBackendNative = Int32 Function(NativeCore core);
+typedef YageAudioOutputGetBackend = int Function(NativeCore core);
+typedef YageAudioOutputGetStatsNative = Void Function(
+    NativeCore core, Pointer<Uint32> underruns, Pointer<Uint32> overflows, Pointer<Int32> buffered);
+typedef YageAudioOutputGetStats = void Function(
+    NativeCore core, Pointer<Uint32> underruns, Pointer<Uint32> overflows, Pointer<Int32> buffered);
+typedef YageAudioOutputSetFastForwardNative = Void Function(NativeCore core, Int32 mode);
+typedef YageAudioOutputSetFastForward = void Function(NativeCore core, int mode);
+typedef YageAudioOutputGetTelemetryNative = Void Function(NativeCore core, Pointer<Uint8> out);
+typedef YageAudioOutputGetTelemetry = void Function(NativeCore core, Pointer<Uint8> out);
+
 // Battery/SRAM save functions
 typedef MgbaCoreGetSramSizeNative = Int32 Function(NativeCore core);
 typedef MgbaCoreGetSramSize = int Function(NativeCore core);
@@ -190,6 +288,109 @@ typedef YageTextureBlit = int Function(NativeCore core);
 typedef YageTextureIsAttachedNative = Int32 Function(NativeCore core);
 typedef YageTextureIsAttached = int Function(NativeCore core);
 
+/// Output pixel layouts for [MGBACore.setOutputFormat]
+/// (mirrors YAGE_OUTPUT_* in yage_libretro.h).
+class YageOutputFormat {
+  static const int rgba8888 = 0;
+  static const int bgra8888 = 1;
+  static const int rgb565 = 2;
+
+  /// GB palette shade 0..3 per byte; recoloured via [MGBACore.getOutputPalette].
+  static const int index8 = 3;
+
+  static int bytesPerPixel(int format) =>
+      format == index8 ? 1 : (format == rgb565 ? 2 : 4);
+}
+
+/// Display upscalers for [MGBACore.setScaler]
+/// (mirrors YAGE_SCALER_* in yage_libretro.h).
+class YageScaler {
+  static const int none = 0;
+  static const int nearest = 1;
+  static const int scale2x = 2;
+  static const int scale3x = 3;
+  static const int xbr2x = 4;
+}
+
+/// LCD ghosting modes for [MGBACore.setFrameBlend]
+/// (mirrors YAGE_FRAME_BLEND_* in yage_libretro.h).
+class YageFrameBlend {
+  static const int off = 0;
+  static const int mix = 1;
+  static const int decay = 2;
+}
+
+/// Screenshot file formats for [MGBACore.saveScreenshot]
+/// (mirrors YAGE_IMAGE_* in yage_libretro.h).
+class YageImageFormat {
+  static const int png = 0;
+  static const int qoi = 1;
+}
+
+/// Audio output backends for [MGBACore.startAudioOutput]
+/// (mirrors YAGE_AUDIO_BACKEND_* in yage_libretro.h).
+class YageAudioBackend {
+  static const int auto = 0;
+  static const int alsa = 1;
+  static const int none = 2; // NULL sink: discards samples in real time
+  static const int wav = 3;
+  static const int external = 4;
+}
+
+/// Fast-forward audio handling for [MGBACore.setAudioFastForward]
+/// (mirrors YAGE_AUDIO_FF_* in yage_libretro.h).
+class YageAudioFastForward {
+  static const int auto = 0;     // stretch up to 3×, decimate above
+  static const int stretch = 1;  // pitch preserved
+  static const int decimate = 2; // pitch rises with speed
+}
+
+/// Audio telemetry snapshot from [MGBACore.getAudioTelemetry]
+/// (mirrors YageAudioStats in yage_libretro.h).  Fill levels are what the
+/// device has yet to play from the engine's ring; the min / max and the
+/// histogram cover the last [windowSeconds].
+class YageAudioStats {
+  /// Fill histogram bucket width (YAGE_AUDIO_FILL_BUCKET_MS); the last
+  /// bucket also counts everything above it.
+  static const int bucketMs = 5;
+  static const int bucketCount = 16;
+  static const int sizeInBytes = 136;
+
+  final double deviceRate;     // Hz, 0 when no output is open
+  final double coreRate;       // Hz the core produces
+  final double resampleRatio;  // device frames per resampler input frame
+  final double speed;          // emulation speed played back
+  final double fillMs;
+  final double fillMinMs;
+  final double fillMaxMs;
+  final double targetMs;
+  final double latencyMs;      // estimated core sample → device output
+  final double windowSeconds;
+  final int underruns;
+  final int overflows;
+  final int pullDropped;       // frames the pull stream dropped
+  final int backend;           // [YageAudioBackend], -1 = none
+  final List<int> fillHistogram; // device periods per [bucketMs] of fill
+
+  const YageAudioStats({
+    required this.deviceRate,
+    required this.coreRate,
+    required this.resampleRatio,
+    required this.speed,
+    required this.fillMs,
+    required this.fillMinMs,
+    required this.fillMaxMs,
+    required this.targetMs,
+    required this.latencyMs,
+    required this.windowSeconds,
+    required this.underruns,
+    required this.overflows,
+    required this.pullDropped,
+    required this.backend,
+    required this.fillHistogram,
+  });
+}
+
 /// Gamepad key codes (bitmask).
 ///
 /// Bits 0-9 match the original mGBA/GBA layout. Bits 10-11 are used for
@@ -256,6 +457,84 @@ class MGBABindings {
   MgbaCoreSetSgbBorders? coreSetSgbBorders;
   bool _sgbBordersLoaded = false;
   bool get isSgbBordersLoaded => _sgbBordersLoaded;
+
+  // Output pixel format (optional)
+  YageCoreSetOutputFormat? coreSetOutputFormat;
+  YageCoreGetOutputBpp? coreGetOutputBpp;
+  YageFrameLoopGetDisplayFormat? frameLoopGetDisplayFormat;
+  YageCoreGetVideoFormat? coreGetVideoFormat;
+  bool _outputFormatLoaded = false;
+  bool get isOutputFormatLoaded => _outputFormatLoaded;
+
+  // Indexed output palette (optional)
+  YageCoreGetOutputPalette? coreGetOutputPalette;
+
+  // Display upscaler (optional)
+  YageFrameLoopSetScaler? frameLoopSetScaler;
+  bool _scalerLoaded = false;
+  bool get isScalerLoaded => _scalerLoaded;
+
+  // LCD ghosting (optional)
+  YageFrameLoopSetFrameBlend? frameLoopSetFrameBlend;
+  bool _frameBlendLoaded = false;
+  bool get isFrameBlendLoaded => _frameBlendLoaded;
+
+  // Gameplay recording (optional)
+  YageRecordStart? recordStart;
+  YageRecordStop? recordStop;
+  YageRecordIsActive? recordIsActive;
+  YageRecordGetStats? recordGetStats;
+  bool _recordLoaded = false;
+  bool get isRecordLoaded => _recordLoaded;
+
+  // Native screenshot encoder (optional)
+  YageScreenshotSave? screenshotSave;
+  bool _screenshotLoaded = false;
+  bool get isScreenshotLoaded => _screenshotLoaded;
+
+  // Instant replay (optional)
+  YageReplayConfigure? replayConfigure;
+  YageReplayDump? replayDump;
+  YageReplayGetStats? replayGetStats;
+  bool _replayLoaded = false;
+  bool get isReplayLoaded => _replayLoaded;
+
+  // Shared-memory frame export (optional)
+  YageFrameExportStart? frameExportStart;
+  YageFrameExportStop? frameExportStop;
+  YageFrameExportIsActive? frameExportIsActive;
+  YageFrameExportGetStats? frameExportGetStats;
+  bool _frameExportLoaded = false;
+  bool get isFrameExportLoaded => _frameExportLoaded;
+
+  // Audio output (optional)
+  YageAudioRead? audioRead;
+  YageAudioReadAvailable? audioReadAvailable;
+  YageAudioReadRate? audioReadRate;
+  bool _audioReadLoaded = false;
+  bool get isAudioReadLoaded => _audioReadLoaded;
+
+  YageAudioOutputStart? audioOutputStart;
+  YageAudioOutputStop? audioOutputStop;
+  YageAudioOutputGetBackend? audioOutputGetBackend;
+  YageAudioOutputGetStats? audioOutputGetStats;
+  bool _audioOutputLoaded = false;
+  bool get isAudioOutputLoaded => _audioOutputLoaded;
+
+  YageAudioOutputSetFastForward? audioOutputSetFastForward;
+  YageAudioOutputGetTelemetry? audioOutputGetTelemetry;
+
+  // Duplicate-frame presents (optional)
+  YageFrameLoopSetSkipDupeCallbacks? frameLoopSetSkipDupeCallbacks;
+  YageFrameLoopGetPresentStats? frameLoopGetPresentStats;
+  bool _presentStatsLoaded = false;
+  bool get isPresentStatsLoaded => _presentStatsLoaded;
+
+  // Conversion pipeline (optional)
+  YageFrameLoopSetPipelined? frameLoopSetPipelined;
+  YageFrameLoopGetPipelineStats? frameLoopGetPipelineStats;
+  bool _pipelineLoaded = false;
+  bool get isPipelineLoaded => _pipelineLoaded;
   late final MgbaCoreRewindInit coreRewindInit;
   late final MgbaCoreRewindDeinit coreRewindDeinit;
   late final MgbaCoreRewindPush coreRewindPush;
@@ -291,7 +570,7 @@ class MGBABindings {
   bool _frameLoopLoaded = false;
   bool get isFrameLoopLoaded => _frameLoopLoaded;
 
-  // Android texture rendering (optional — Android only via ANativeWindow)
+  // Texture rendering (optional — Android ANativeWindow, Linux runner texture)
   YageTextureBlit? textureBlit;
   YageTextureIsAttached? textureIsAttached;
   bool _textureLoaded = false;
@@ -604,6 +883,227 @@ class MGBABindings {
         _sgbBordersLoaded = false;
       }
 
+      // ── Optional: try to load output pixel format symbols ──
+      try {
+        coreSetOutputFormat = lib
+            .lookup<NativeFunction<YageCoreSetOutputFormatNative>>('yage_core_set_output_format')
+            .asFunction<YageCoreSetOutputFormat>();
+        coreGetOutputBpp = lib
+            .lookup<NativeFunction<YageCoreGetOutputBppNative>>('yage_core_get_output_bytes_per_pixel')
+            .asFunction<YageCoreGetOutputBpp>();
+        frameLoopGetDisplayFormat = lib
+            .lookup<NativeFunction<YageFrameLoopGetDisplayFormatNative>>('yage_frame_loop_get_display_format')
+            .asFunction<YageFrameLoopGetDisplayFormat>();
+        _outputFormatLoaded = true;
+        debugPrint('Output format symbols loaded successfully');
+      } catch (e) {
+        debugPrint('Output format control not available: $e');
+        _outputFormatLoaded = false;
+      }
+      try {
+        coreGetOutputPalette = lib
+            .lookup<NativeFunction<YageCoreGetOutputPaletteNative>>('yage_core_get_output_palette')
+            .asFunction<YageCoreGetOutputPalette>();
+      } catch (e) {
+        debugPrint('Indexed output palette not available: $e');
+      }
+      try {
+        coreGetVideoFormat = lib
+            .lookup<NativeFunction<YageCoreGetVideoFormatNative>>('yage_core_get_video_format')
+            .asFunction<YageCoreGetVideoFormat>();
+      } catch (e) {
+        debugPrint('Video buffer format query not available: $e');
+      }
+
+      // ── Optional: try to load display upscaler symbol ──
+      try {
+        frameLoopSetScaler = lib
+            .lookup<NativeFunction<YageFrameLoopSetScalerNative>>('yage_frame_loop_set_scaler')
+            .asFunction<YageFrameLoopSetScaler>();
+        _scalerLoaded = true;
+        debugPrint('Display scaler symbol loaded successfully');
+      } catch (e) {
+        debugPrint('Display scaler not available: $e');
+        _scalerLoaded = false;
+      }
+
+      // ── Optional: try to load LCD ghosting symbol ──
+      try {
+        frameLoopSetFrameBlend = lib
+            .lookup<NativeFunction<YageFrameLoopSetFrameBlendNative>>('yage_frame_loop_set_frame_blend')
+            .asFunction<YageFrameLoopSetFrameBlend>();
+        _frameBlendLoaded = true;
+        debugPrint('Frame blend symbol loaded successfully');
+      } catch (e) {
+        debugPrint('Frame blend not available: $e');
+        _frameBlendLoaded = false;
+      }
+
+      // ── Optional: try to load duplicate-frame present symbols ──
+      try {
+        frameLoopSetSkipDupeCallbacks = lib
+            .lookup<NativeFunction<YageFrameLoopSetSkipDupeCallbacksNative>>(
+                'yage_frame_loop_set_skip_duplicate_callbacks')
+            .asFunction<YageFrameLoopSetSkipDupeCallbacks>();
+        frameLoopGetPresentStats = lib
+            .lookup<NativeFunction<YageFrameLoopGetPresentStatsNative>>(
+                'yage_frame_loop_get_present_stats')
+            .asFunction<YageFrameLoopGetPresentStats>();
+        _presentStatsLoaded = true;
+        debugPrint('Present stats symbols loaded successfully');
+      } catch (e) {
+        debugPrint('Present stats not available: $e');
+        _presentStatsLoaded = false;
+      }
+
+      // ── Optional: try to load conversion pipeline symbols ──
+      try {
+        frameLoopSetPipelined = lib
+            .lookup<NativeFunction<YageFrameLoopSetPipelinedNative>>(
+                'yage_frame_loop_set_pipelined')
+            .asFunction<YageFrameLoopSetPipelined>();
+        frameLoopGetPipelineStats = lib
+            .lookup<NativeFunction<YageFrameLoopGetPipelineStatsNative>>(
+                'yage_frame_loop_get_pipeline_stats')
+            .asFunction<YageFrameLoopGetPipelineStats>();
+        _pipelineLoaded = true;
+        debugPrint('Conversion pipeline symbols loaded successfully');
+      } catch (e) {
+        debugPrint('Conversion pipeline not available: $e');
+        _pipelineLoaded = false;
+      }
+
+      // ── Optional: try to load gameplay recording symbols ──
+      try {
+        recordStart = lib
+            .lookup<NativeFunction<YageRecordStartNative>>('yage_record_start')
+            .asFunction<YageRecordStart>();
+        recordStop = lib
+            .lookup<NativeFunction<YageRecordStopNative>>('yage_record_stop')
+            .asFunction<YageRecordStop>();
+        recordIsActive = lib
+            .lookup<NativeFunction<YageRecordIsActiveNative>>('yage_record_is_active')
+            .asFunction<YageRecordIsActive>();
+        recordGetStats = lib
+            .lookup<NativeFunction<YageRecordGetStatsNative>>('yage_record_get_stats')
+            .asFunction<YageRecordGetStats>();
+        _recordLoaded = true;
+        debugPrint('Recording symbols loaded successfully');
+      } catch (e) {
+        debugPrint('Recording not available: $e');
+        _recordLoaded = false;
+      }
+
+      // ── Optional: try to load native screenshot symbol ──
+      try {
+        screenshotSave = lib
+            .lookup<NativeFunction<YageScreenshotSaveNative>>('yage_screenshot_save')
+            .asFunction<YageScreenshotSave>();
+        _screenshotLoaded = true;
+        debugPrint('Screenshot symbol loaded successfully');
+      } catch (e) {
+        debugPrint('Native screenshots not available: $e');
+        _screenshotLoaded = false;
+      }
+
+      // ── Optional: try to load instant replay symbols ──
+      try {
+        replayConfigure = lib
+            .lookup<NativeFunction<YageReplayConfigureNative>>('yage_replay_buffer_configure')
+            .asFunction<YageReplayConfigure>();
+        replayDump = lib
+            .lookup<NativeFunction<YageReplayDumpNative>>('yage_replay_buffer_dump')
+            .asFunction<YageReplayDump>();
+        replayGetStats = lib
+            .lookup<NativeFunction<YageReplayGetStatsNative>>('yage_replay_buffer_get_stats')
+            .asFunction<YageReplayGetStats>();
+        _replayLoaded = true;
+        debugPrint('Instant replay symbols loaded successfully');
+      } catch (e) {
+        debugPrint('Instant replay not available: $e');
+        _replayLoaded = false;
+      }
+
+      // ── Optional: try to load shared-memory frame export symbols ──
+      try {
+        frameExportStart = lib
+            .lookup<NativeFunction<YageFrameExportStartNative>>('yage_frame_export_start')
+            .asFunction<YageFrameExportStart>();
+        frameExportStop = lib
+            .lookup<NativeFunction<YageFrameExportStopNative>>('yage_frame_export_stop')
+            .asFunction<YageFrameExportStop>();
+        frameExportIsActive = lib
+            .lookup<NativeFunction<YageFrameExportIsActiveNative>>('yage_frame_export_is_active')
+            .asFunction<YageFrameExportIsActive>();
+        frameExportGetStats = lib
+            .lookup<NativeFunction<YageFrameExportGetStatsNative>>('yage_frame_export_get_stats')
+            .asFunction<YageFrameExportGetStats>();
+        _frameExportLoaded = true;
+        debugPrint('Frame export symbols loaded successfully');
+      } catch (e) {
+        debugPrint('Frame export not available: $e');
+        _frameExportLoaded = false;
+      }
+
+      // ── Optional: try to load audio pull stream symbols ──
+      try {
+        audioRead = lib
+            .lookup<NativeFunction<YageAudioReadNative>>('yage_audio_read')
+            .asFunction<YageAudioRead>();
+        audioReadAvailable = lib
+            .lookup<NativeFunction<YageAudioReadAvailableNative>>('yage_audio_read_available')
+            .asFunction<YageAudioReadAvailable>();
+        audioReadRate = lib
+            .lookup<NativeFunction<YageAudioReadRateNative>>('yage_audio_read_rate')
+            .asFunction<YageAudioReadRate>();
+        _audioReadLoaded = true;
+        debugPrint('Audio pull stream symbols loaded successfully');
+      } catch (e) {
+        debugPrint('Audio pull stream not available: $e');
+        _audioReadLoaded = false;
+      }
+
+      // ── Optional: try to load audio output symbols ──
+      try {
+        audioOutputStart = lib
+            .lookup<NativeFunction<YageAudioOutputStartNative>>('yage_audio_output_start')
+            .asFunction<YageAudioOutputStart>();
+        audioOutputStop = lib
+            .lookup<NativeFunction<YageAudioOutputStopNative>>('yage_audio_output_stop')
+            .asFunction<YageAudioOutputStop>();
+        audioOutputGetBackend = lib
+            .lookup<NativeFunction<YageAudioOutputGetBackendNative>>('yage_audio_output_get_backend')
+            .asFunction<YageAudioOutputGetBackend>();
+        audioOutputGetStats = lib
+            .lookup<NativeFunction<YageAudioOutputGetStatsNative>>('yage_audio_output_get_stats')
+            .asFunction<YageAudioOutputGetStats>();
+        _audioOutputLoaded = true;
+        debugPrint('Audio output symbols loaded successfully');
+      } catch (e) {
+        debugPrint('Audio output not available: $e');
+        _audioOutputLoaded = false;
+      }
+
+      // ── Optional: try to load fast-forward audio symbol ──
+      try {
+        audioOutputSetFastForward = lib
+            .lookup<NativeFunction<YageAudioOutputSetFastForwardNative>>(
+                'yage_audio_output_set_fast_forward')
+            .asFunction<YageAudioOutputSetFastForward>();
+      } catch (e) {
+        debugPrint('Fast-forward audio mode not available: $e');
+      }
+
+      // ── Optional: try to load audio telemetry symbol ──
+      try {
+        audioOutputGetTelemetry = lib
+            .lookup<NativeFunction<YageAudioOutputGetTelemetryNative>>(
+                'yage_audio_output_get_telemetry')
+            .asFunction<YageAudioOutputGetTelemetry>();
+      } catch (e) {
+        debugPrint('Audio telemetry not available: $e');
+      }
+
       // ── Optional: try to load core selection symbol (multi-core) ──
       try {
         coreSetCore = lib
@@ -800,7 +1300,8 @@ class MGBACore {
   /// Get video buffer as RGBA pixel data.
   /// Native side stores pixels in ABGR uint32 format which maps to
   /// R,G,B,A bytes in little-endian memory — exactly what Flutter expects
-  /// for PixelFormat.rgba8888.
+  /// for PixelFormat.rgba8888.  Other output formats are converted to
+  /// RGBA8888, so the result is always width × height × 4 bytes.
   ///
   /// Returns a **copy** of the native buffer so the caller can safely hold
   /// the reference across frames without risking use-after-free or data
@@ -812,10 +1313,19 @@ class MGBACore {
       final buffer = _bindings.coreGetVideoBuffer(_corePtr as Pointer<Void>);
       if (buffer == nullptr || buffer.address == 0) return null;
 
-      final byteCount = _width * _height * 4;
-      // Copy native memory into a Dart-owned Uint8List so the data remains
-      // valid even after the native side reuses the buffer on the next frame.
-      return Uint8List.fromList(buffer.cast<Uint8>().asTypedList(byteCount));
+      // The layout of this buffer, which can differ from the one requested
+      // (INDEX8 falls back to RGBA8888 while the GB palette is off)
+      final format = _bindings.coreGetVideoFormat
+              ?.call(_corePtr as Pointer<Void>) ??
+          YageOutputFormat.rgba8888;
+      final pixelCount = _width * _height;
+      final bytes = buffer
+          .cast<Uint8>()
+          .asTypedList(pixelCount * YageOutputFormat.bytesPerPixel(format));
+      // Copy native memory into a Dart-owned RGBA8888 buffer so the data
+      // remains valid even after the native side reuses the buffer on the
+      // next frame.
+      return _toRgba(bytes, format);
     } catch (e) {
       debugPrint('MGBACore.getVideoBuffer: FFI error — $e');
       return null;
@@ -935,6 +1445,49 @@ class MGBACore {
   /// Whether the SGB border control API is available.
   bool get isSgbBordersSupported => _bindings.isSgbBordersLoaded && _corePtr != null;
 
+  /// Select the pixel layout of the video/display buffers and the texture
+  /// blit (see [YageOutputFormat]).  [getVideoBuffer] and [getDisplayBuffer]
+  /// still hand Dart RGBA8888.  Returns false if unsupported.
+  bool setOutputFormat(int format) {
+    if (_corePtr == null || _bindings.coreSetOutputFormat == null) return false;
+    return _bindings.coreSetOutputFormat!(_corePtr as Pointer<Void>, format) == 0;
+  }
+
+  /// The 4 shades [YageOutputFormat.index8] frames are shown in, as RGBA
+  /// bytes (lightest first), or null if unsupported.
+  Uint8List? getOutputPalette() {
+    if (_corePtr == null || _bindings.coreGetOutputPalette == null) return null;
+    final out = calloc<Uint32>(4);
+    try {
+      _bindings.coreGetOutputPalette!(_corePtr as Pointer<Void>, out);
+      return Uint8List.fromList(out.cast<Uint8>().asTypedList(16));
+    } finally {
+      calloc.free(out);
+    }
+  }
+
+  /// Upscale presented frames (see [YageScaler]); [factor] is used by
+  /// [YageScaler.nearest] only.  The display width/height then report the
+  /// scaled size.  Returns the effective scale factor (1 if unsupported).
+  int setScaler(int mode, {int factor = 2}) {
+    if (_corePtr == null || _bindings.frameLoopSetScaler == null) return 1;
+    return _bindings.frameLoopSetScaler!(_corePtr as Pointer<Void>, mode, factor);
+  }
+
+  /// Imitate LCD ghosting on presented frames (see [YageFrameBlend]).
+  /// [historyPercent] is the previous frame's share of each pixel.
+  void setFrameBlend(int mode, {int historyPercent = 50}) {
+    if (_corePtr == null || _bindings.frameLoopSetFrameBlend == null) return;
+    _bindings.frameLoopSetFrameBlend!(_corePtr as Pointer<Void>, mode, historyPercent);
+  }
+
+  /// Bytes per pixel of the frames being produced: 4, 2 for RGB565, 1 for
+  /// INDEX8 (which falls back to 4 while the GB palette is off).
+  int get outputBytesPerPixel {
+    if (_corePtr == null || _bindings.coreGetOutputBpp == null) return 4;
+    return _bindings.coreGetOutputBpp!(_corePtr as Pointer<Void>);
+  }
+
   /// Initialize rewind ring buffer with given capacity (number of snapshots)
   int rewindInit(int capacity) {
     if (_corePtr == null) return -1;
@@ -1075,6 +1628,286 @@ class MGBACore {
         _corePtr as Pointer<Void>, enabled ? 1 : 0);
   }
 
+  /// Drop frame callbacks for duplicate frames (a 2 Hz heartbeat remains).
+  /// Keep disabled while the callback drives per-frame work such as link
+  /// cable polling.
+  void frameLoopSetSkipDuplicateCallbacks({required bool enabled}) {
+    if (_corePtr == null || _bindings.frameLoopSetSkipDupeCallbacks == null) return;
+    _bindings.frameLoopSetSkipDupeCallbacks!(
+        _corePtr as Pointer<Void>, enabled ? 1 : 0);
+  }
+
+  /// Frames shown and duplicate frames skipped since the frame loop
+  /// started, or null if unsupported.
+  ({int presented, int skipped})? getPresentStats() {
+    if (_corePtr == null || _bindings.frameLoopGetPresentStats == null) return null;
+    final out = calloc<Uint32>(2);
+    try {
+      _bindings.frameLoopGetPresentStats!(_corePtr as Pointer<Void>, out, out + 1);
+      return (presented: out[0], skipped: out[1]);
+    } finally {
+      calloc.free(out);
+    }
+  }
+
+  /// Convert and present frames on a native worker, overlapped with the
+  /// next emulated frame.  Takes effect between frames.
+  void frameLoopSetPipelined({required bool enabled}) {
+    if (_corePtr == null || _bindings.frameLoopSetPipelined == null) return;
+    _bindings.frameLoopSetPipelined!(_corePtr as Pointer<Void>, enabled ? 1 : 0);
+  }
+
+  /// Frames handed to the conversion worker, and hand-offs replaced by a
+  /// newer frame before it took them, or null if unsupported.
+  ({int handoffs, int replaced})? getPipelineStats() {
+    if (_corePtr == null || _bindings.frameLoopGetPipelineStats == null) return null;
+    final out = calloc<Uint32>(2);
+    try {
+      _bindings.frameLoopGetPipelineStats!(_corePtr as Pointer<Void>, out, out + 1);
+      return (handoffs: out[0], replaced: out[1]);
+    } finally {
+      calloc.free(out);
+    }
+  }
+
+  /// Start recording gameplay to `[basePath].y4m` and `[basePath].wav`.
+  bool startRecording(String basePath) {
+    if (_corePtr == null || _bindings.recordStart == null) return false;
+    final pathPtr = basePath.toNativeUtf8();
+    try {
+      return _bindings.recordStart!(_corePtr as Pointer<Void>, pathPtr) == 0;
+    } finally {
+      malloc.free(pathPtr);
+    }
+  }
+
+  /// Stop recording and finish both files.
+  void stopRecording() {
+    if (_corePtr == null || _bindings.recordStop == null) return;
+    _bindings.recordStop!(_corePtr as Pointer<Void>);
+  }
+
+  bool get isRecording {
+    if (_corePtr == null || _bindings.recordIsActive == null) return false;
+    return _bindings.recordIsActive!(_corePtr as Pointer<Void>) != 0;
+  }
+
+  /// Frames written / dropped and audio frames dropped by the recorder.
+  ({int written, int dropped, int audioDropped})? getRecordingStats() {
+    if (_corePtr == null || _bindings.recordGetStats == null) return null;
+    final out = calloc<Uint32>(3);
+    try {
+      _bindings.recordGetStats!(_corePtr as Pointer<Void>, out, out + 1, out + 2);
+      return (written: out[0], dropped: out[1], audioDropped: out[2]);
+    } finally {
+      calloc.free(out);
+    }
+  }
+
+  bool get isNativeScreenshotSupported => _bindings.isScreenshotLoaded && _corePtr != null;
+
+  /// Save the current frame to [path] as PNG or QOI ([YageImageFormat]),
+  /// shrunk to fit [maxWidth] × [maxHeight] (0 = no limit).  The frame is
+  /// captured right away; conversion and encoding run on a native thread,
+  /// and the future completes when the file is written.
+  Future<bool> saveScreenshot(String path,
+      {int format = YageImageFormat.png, int maxWidth = 0, int maxHeight = 0}) {
+    if (_corePtr == null || _bindings.screenshotSave == null) return Future.value(false);
+    final completer = Completer<bool>();
+    late final NativeCallable<NativeScreenshotCallback> callable;
+    callable = NativeCallable<NativeScreenshotCallback>.listener((int requestId, int result) {
+      callable.close();
+      completer.complete(result == 0);
+    });
+    final pathPtr = path.toNativeUtf8();
+    try {
+      final id = _bindings.screenshotSave!(_corePtr as Pointer<Void>, pathPtr, format,
+          maxWidth, maxHeight, callable.nativeFunction);
+      if (id < 0) {
+        callable.close();
+        return Future.value(false);
+      }
+    } finally {
+      malloc.free(pathPtr);
+    }
+    return completer.future;
+  }
+
+  /// Keep the last [seconds] of gameplay compressed in memory (at most
+  /// [maxBytes], 0 = native default).  0 seconds turns the buffer off.
+  bool configureReplayBuffer(int seconds, {int maxBytes = 0}) {
+    if (_corePtr == null || _bindings.replayConfigure == null) return false;
+    return _bindings.replayConfigure!(_corePtr as Pointer<Void>, seconds, maxBytes) == 0;
+  }
+
+  /// Write the replay buffer to `[basePath].y4m` / `.wav`.  Blocks while
+  /// encoding; returns the number of frames written, or -1.
+  int dumpReplayBuffer(String basePath) {
+    if (_corePtr == null || _bindings.replayDump == null) return -1;
+    final pathPtr = basePath.toNativeUtf8();
+    try {
+      return _bindings.replayDump!(_corePtr as Pointer<Void>, pathPtr);
+    } finally {
+      malloc.free(pathPtr);
+    }
+  }
+
+  /// Frames and compressed bytes held by the replay buffer, and frames it
+  /// dropped.
+  ({int frames, int bytes, int dropped})? getReplayBufferStats() {
+    if (_corePtr == null || _bindings.replayGetStats == null) return null;
+    final out = calloc<Uint32>(3);
+    try {
+      _bindings.replayGetStats!(_corePtr as Pointer<Void>, out, out + 1, out + 2);
+      return (frames: out[0], bytes: out[1], dropped: out[2]);
+    } finally {
+      calloc.free(out);
+    }
+  }
+
+  /// Export every presented frame to the POSIX shared-memory object [name]
+  /// (e.g. `/yage-frames`) as a ring of [slots] frames (0 = native
+  /// default) for external capture tools.  Linux / macOS only.
+  bool startFrameExport(String name, {int slots = 0}) {
+    if (_corePtr == null || _bindings.frameExportStart == null) return false;
+    final namePtr = name.toNativeUtf8();
+    try {
+      return _bindings.frameExportStart!(_corePtr as Pointer<Void>, namePtr, slots) == 0;
+    } finally {
+      malloc.free(namePtr);
+    }
+  }
+
+  void stopFrameExport() {
+    if (_corePtr == null || _bindings.frameExportStop == null) return;
+    _bindings.frameExportStop!(_corePtr as Pointer<Void>);
+  }
+
+  bool get isFrameExporting {
+    if (_corePtr == null || _bindings.frameExportIsActive == null) return false;
+    return _bindings.frameExportIsActive!(_corePtr as Pointer<Void>) != 0;
+  }
+
+  /// Frames published to the shared-memory ring, and frames too large for
+  /// its slots.
+  ({int published, int dropped})? getFrameExportStats() {
+    if (_corePtr == null || _bindings.frameExportGetStats == null) return null;
+    final out = calloc<Uint32>(2);
+    try {
+      _bindings.frameExportGetStats!(_corePtr as Pointer<Void>, out, out + 1);
+      return (published: out[0], dropped: out[1]);
+    } finally {
+      calloc.free(out);
+    }
+  }
+
+  /// Drain up to [maxFrames] stereo frames of the native audio stream
+  /// (interleaved, at [audioReadRate] Hz, volume applied).  Every frame's
+  /// audio is queued, however the core delivers it; the first call starts
+  /// the stream.  Returns null when nothing is queued.
+  Int16List? readAudio({int maxFrames = 8192}) {
+    if (_corePtr == null || _bindings.audioRead == null || maxFrames <= 0) return null;
+    final buffer = calloc<Int16>(maxFrames * 2);
+    try {
+      final frames = _bindings.audioRead!(_corePtr as Pointer<Void>, buffer, maxFrames);
+      if (frames <= 0) return null;
+      return Int16List.fromList(buffer.asTypedList(frames * 2));
+    } finally {
+      calloc.free(buffer);
+    }
+  }
+
+  /// Stereo frames queued for [readAudio].
+  int get audioReadAvailable {
+    if (_corePtr == null || _bindings.audioReadAvailable == null) return 0;
+    return _bindings.audioReadAvailable!(_corePtr as Pointer<Void>);
+  }
+
+  /// Sample rate of the [readAudio] stream in Hz.
+  double get audioReadRate {
+    if (_corePtr == null || _bindings.audioReadRate == null) return 0;
+    return _bindings.audioReadRate!(_corePtr as Pointer<Void>);
+  }
+
+  /// Play audio through [backend] (a [YageAudioBackend] value) on a native
+  /// thread.  [target] is the ALSA device name or the WAV file path.
+  /// Linux / macOS only — Android plays through OpenSL ES automatically.
+  bool startAudioOutput(int backend, {String? target}) {
+    if (_corePtr == null || _bindings.audioOutputStart == null) return false;
+    final targetPtr = target != null ? target.toNativeUtf8() : nullptr;
+    try {
+      return _bindings.audioOutputStart!(_corePtr as Pointer<Void>, backend, targetPtr) == 0;
+    } finally {
+      if (targetPtr != nullptr) malloc.free(targetPtr);
+    }
+  }
+
+  void stopAudioOutput() {
+    if (_corePtr == null || _bindings.audioOutputStop == null) return;
+    _bindings.audioOutputStop!(_corePtr as Pointer<Void>);
+  }
+
+  /// Backend currently playing ([YageAudioBackend]), or -1.
+  int get audioOutputBackend {
+    if (_corePtr == null || _bindings.audioOutputGetBackend == null) return -1;
+    return _bindings.audioOutputGetBackend!(_corePtr as Pointer<Void>);
+  }
+
+  /// Underrun and overflow episodes since the output opened, and the
+  /// stereo frames currently buffered.
+  ({int underruns, int overflows, int buffered})? getAudioOutputStats() {
+    if (_corePtr == null || _bindings.audioOutputGetStats == null) return null;
+    final out = calloc<Uint32>(2);
+    final buffered = calloc<Int32>();
+    try {
+      _bindings.audioOutputGetStats!(_corePtr as Pointer<Void>, out, out + 1, buffered);
+      return (underruns: out[0], overflows: out[1], buffered: buffered.value);
+    } finally {
+      calloc.free(out);
+      calloc.free(buffered);
+    }
+  }
+
+  /// How audio is played while the frame loop runs faster than 1×
+  /// (a [YageAudioFastForward] value).
+  void setAudioFastForward(int mode) {
+    if (_corePtr == null || _bindings.audioOutputSetFastForward == null) return;
+    _bindings.audioOutputSetFastForward!(_corePtr as Pointer<Void>, mode);
+  }
+
+  /// Audio pipeline telemetry: ring fill now and over the last seconds,
+  /// underruns / overflows, rates and the estimated output latency.
+  YageAudioStats? getAudioTelemetry() {
+    if (_corePtr == null || _bindings.audioOutputGetTelemetry == null) return null;
+    final buf = calloc<Uint8>(YageAudioStats.sizeInBytes);
+    try {
+      _bindings.audioOutputGetTelemetry!(_corePtr as Pointer<Void>, buf);
+      double f64(int offset) => (buf + offset).cast<Double>().value;
+      double f32(int offset) => (buf + offset).cast<Float>().value;
+      int u32(int offset) => (buf + offset).cast<Uint32>().value;
+      return YageAudioStats(
+        deviceRate: f64(0),
+        coreRate: f64(8),
+        resampleRatio: f64(16),
+        speed: f64(24),
+        fillMs: f32(32),
+        fillMinMs: f32(36),
+        fillMaxMs: f32(40),
+        targetMs: f32(44),
+        latencyMs: f32(48),
+        windowSeconds: f32(52),
+        underruns: u32(56),
+        overflows: u32(60),
+        pullDropped: u32(64),
+        backend: (buf + 68).cast<Int32>().value,
+        fillHistogram: List<int>.generate(
+            YageAudioStats.bucketCount, (i) => u32(72 + i * 4)),
+      );
+    } finally {
+      calloc.free(buf);
+    }
+  }
+
   /// Get FPS from the native frame loop (returns fps × 100).
   double getFrameLoopFps() {
     if (_corePtr == null || _bindings.frameLoopGetFpsX100 == null) return 0;
@@ -1082,7 +1915,8 @@ class MGBACore {
   }
 
   /// Get the display buffer snapshot from the native frame loop.
-  /// Returns a Dart-owned copy of the pixel data, or null if unavailable.
+  /// Returns a Dart-owned RGBA8888 copy of the pixel data whatever the
+  /// output format, or null if unavailable.
   Uint8List? getDisplayBuffer() {
     if (_corePtr == null || !_bindings.isFrameLoopLoaded) return null;
 
@@ -1094,14 +1928,63 @@ class MGBACore {
       final h = _bindings.frameLoopGetDisplayHeight!(_corePtr as Pointer<Void>);
       if (w <= 0 || h <= 0) return null;
 
-      final byteCount = w * h * 4;
-      return Uint8List.fromList(buffer.cast<Uint8>().asTypedList(byteCount));
+      final format = _bindings.frameLoopGetDisplayFormat
+              ?.call(_corePtr as Pointer<Void>) ??
+          YageOutputFormat.rgba8888;
+      final byteCount = w * h * YageOutputFormat.bytesPerPixel(format);
+      return _toRgba(buffer.cast<Uint8>().asTypedList(byteCount), format);
     } catch (e) {
       debugPrint('MGBACore.getDisplayBuffer: FFI error — $e');
       return null;
     }
   }
 
+  /// Convert a frame in output [format] into a new RGBA8888 buffer:
+  /// BGRA8888 has R and B swapped back, RGB565 is widened the way the native
+  /// converters widen it, and [YageOutputFormat.index8] shade numbers are
+  /// recoloured with the current palette.  RGBA8888 is copied as is.
+  Uint8List? _toRgba(Uint8List bytes, int format) {
+    if (format == YageOutputFormat.index8) {
+      final palette = getOutputPalette();
+      if (palette == null) return null;
+      final rgba = Uint8List(bytes.length * 4);
+      for (var i = 0; i < bytes.length; i++) {
+        final p = (bytes[i] & 3) * 4;
+        final o = i * 4;
+        rgba[o] = palette[p];
+        rgba[o + 1] = palette[p + 1];
+        rgba[o + 2] = palette[p + 2];
+        rgba[o + 3] = palette[p + 3];
+      }
+      return rgba;
+    }
+    if (format == YageOutputFormat.rgb565) {
+      final pixels = bytes.length >> 1;
+      final rgba = Uint8List(pixels * 4);
+      for (var i = 0; i < pixels; i++) {
+        final p = bytes[i * 2] | (bytes[i * 2 + 1] << 8);
+        final r = (p >> 11) & 0x1F;
+        final g = (p >> 5) & 0x3F;
+        final b = p & 0x1F;
+        final o = i * 4;
+        rgba[o] = (r << 3) | (r >> 2);
+        rgba[o + 1] = (g << 2) | (g >> 4);
+        rgba[o + 2] = (b << 3) | (b >> 2);
+        rgba[o + 3] = 0xFF;
+      }
+      return rgba;
+    }
+    final rgba = Uint8List.fromList(bytes);
+    if (format == YageOutputFormat.bgra8888) {
+      for (var o = 0; o + 3 < rgba.length; o += 4) {
+        final b = rgba[o];
+        rgba[o] = rgba[o + 2];
+        rgba[o + 2] = b;
+      }
+    }
+    return rgba;
+  }
+
   /// Display dimensions from the native frame loop (may differ from core
   /// width/height during SGB mode transitions).
   int get displayWidth {
@@ -68,8 +68,9 @@ class EmulatorService extends ChangeNotifier {
   /// Must stay alive as long as the native thread is running.
   NativeCallable<NativeFrameCallback>? _nativeFrameCallable;
 
-  /// True when frames are delivered via Android Texture widget
-  /// (ANativeWindow), bypassing decodeImageFromPixels entirely.
+  /// True when frames are delivered via a Texture widget (Android
+  /// ANativeWindow, Linux pixel buffer texture), bypassing
+  /// decodeImageFromPixels entirely.
   bool _useTextureRendering = false;
   bool get useTextureRendering => _useTextureRendering;
 
@@ -85,11 +86,25 @@ class EmulatorService extends ChangeNotifier {
   int _flushedPlayTimeSeconds = 0;
   
   /// Link cable service for network multiplayer (set externally).
-  LinkCableService? linkCable;
+  LinkCableService? _linkCable;
+  LinkCableService? get linkCable => _linkCable;
+  set linkCable(LinkCableService? value) {
+    _linkCable = value;
+    // Link cable polling rides on the frame callback, so duplicate frames
+    // may only skip it while no cable is attached.
+    if (_useNativeFrameLoop) {
+      _core?.frameLoopSetSkipDuplicateCallbacks(enabled: value == null);
+    }
+  }
 
   /// Native rcheevos client for per-frame achievement processing (set externally).
   RcheevosClient? rcheevosClient;
 
+  /// Frames shown and identical frames skipped by the native frame loop,
+  /// or null when it is not running / unsupported.
+  ({int presented, int skipped})? get presentStats =>
+      _useNativeFrameLoop ? _core?.getPresentStats() : null;
+
   /// Expose the native core for memory reading (used by RA runtime).
   MGBACore? get core => _core;
 
@@ -631,6 +646,7 @@ class EmulatorService extends ChangeNotifier {
       interval: _rewindCaptureInterval,
     );
     core.frameLoopSetRcheevos(enabled: rcheevosClient != null);
+    core.frameLoopSetSkipDuplicateCallbacks(enabled: linkCable == null);
 
     final ok = core.startFrameLoop(_nativeFrameCallable!.nativeFunction);
     if (ok) {
@@ -1139,11 +1155,9 @@ class EmulatorService extends ChangeNotifier {
       success = _core!.saveState(slot);
     }
     if (success) {
-      await _saveStateScreenshot(slot);
       final statePath = getStatePath(slot);
-      final screenshotPath = getStateScreenshotPath(slot);
       if (statePath != null) _syncSaveToUserFolder(statePath);
-      if (screenshotPath != null) _syncSaveToUserFolder(screenshotPath);
+      await _saveStateScreenshot(slot);
     }
 
     if (wasNative && _state == EmulatorState.running) _startNativeFrameLoop();
@@ -1177,11 +1191,32 @@ class EmulatorService extends ChangeNotifier {
     return success;
   }
 
+  /// Thumbnails larger than this are shrunk by the native encoder.
+  static const int _thumbnailMaxWidth = 256;
+  static const int _thumbnailMaxHeight = 224;
+
   /// Capture the current video frame and save as PNG for save state thumbnail
   Future<void> _saveStateScreenshot(int slot) async {
     final path = getStateScreenshotPath(slot);
     if (path == null) return;
 
+    if (!_useStub && (_core?.isNativeScreenshotSupported ?? false)) {
+      // The frame is captured before this returns (the frame loop is
+      // stopped); encoding finishes in the background, so the loop can
+      // resume right away.
+      unawaited(_core!
+          .saveScreenshot(path,
+              maxWidth: _thumbnailMaxWidth, maxHeight: _thumbnailMaxHeight)
+          .then((ok) {
+        if (ok) {
+          _syncSaveToUserFolder(path);
+        } else {
+          debugPrint('Error saving state screenshot: native encoder failed');
+        }
+      }));
+      return;
+    }
+
     final pixels = getVideoBufferRaw();
     if (pixels == null) return;
 
@@ -1203,6 +1238,7 @@ class EmulatorService extends ChangeNotifier {
 
       if (byteData != null) {
         await File(path).writeAsBytes(byteData.buffer.asUint8List());
+        _syncSaveToUserFolder(path);
       }
     } catch (e) {
       debugPrint('Error saving state screenshot: $e');
@@ -1214,6 +1250,27 @@ class EmulatorService extends ChangeNotifier {
   Future<String?> captureScreenshot() async {
     if (_currentRom == null) return null;
 
+    final saveDir = _getRomSaveDir(_currentRom!);
+    final romName = p.basenameWithoutExtension(_currentRom!.path);
+    final ts = DateTime.now();
+    final stamp = '${ts.year}${ts.month.toString().padLeft(2, '0')}'
+        '${ts.day.toString().padLeft(2, '0')}_'
+        '${ts.hour.toString().padLeft(2, '0')}'
+        '${ts.minute.toString().padLeft(2, '0')}'
+        '${ts.second.toString().padLeft(2, '0')}';
+    final filePath = p.join(saveDir, '${romName}_$stamp.png');
+
+    if (!_useStub && (_core?.isNativeScreenshotSupported ?? false)) {
+      // Captured on the emulation thread, encoded off the UI thread
+      final ok = await _core!.saveScreenshot(filePath);
+      if (!ok) {
+        debugPrint('Error capturing screenshot: native encoder failed');
+        return null;
+      }
+      debugPrint('Screenshot saved to $filePath');
+      return filePath;
+    }
+
     final pixels = getVideoBufferRaw();
     if (pixels == null) return null;
 
@@ -1234,16 +1291,6 @@ class EmulatorService extends ChangeNotifier {
 
       if (byteData == null) return null;
 
-      final saveDir = _getRomSaveDir(_currentRom!);
-      final romName = p.basenameWithoutExtension(_currentRom!.path);
-      final ts = DateTime.now();
-      final stamp = '${ts.year}${ts.month.toString().padLeft(2, '0')}'
-          '${ts.day.toString().padLeft(2, '0')}_'
-          '${ts.hour.toString().padLeft(2, '0')}'
-          '${ts.minute.toString().padLeft(2, '0')}'
-          '${ts.second.toString().padLeft(2, '0')}';
-      final filePath = p.join(saveDir, '${romName}_$stamp.png');
-
       await File(filePath).writeAsBytes(byteData.buffer.asUint8List());
       debugPrint('Screenshot saved to $filePath');
       return filePath;
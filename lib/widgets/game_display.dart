@@ -8,14 +8,16 @@ import 'package:flutter/services.dart';
 import '../services/emulator_service.dart';
 import '../utils/theme.dart';
 
-/// Method channel for texture creation/destruction (Android only).
+/// Method channel for texture creation/destruction (Android and Linux).
 const _channel = MethodChannel('com.yourmateapps.retropal/device');
 
 /// Widget for displaying the emulator game screen.
 ///
 /// On Android, uses a platform `Texture` widget backed by an ANativeWindow
 /// for zero-copy frame delivery — no `decodeImageFromPixels`, no `ui.Image`
-/// allocations, no GC pressure at 60 fps.
+/// allocations, no GC pressure at 60 fps.  On Linux the GTK runner provides
+/// the same texture as an `FlPixelBufferTexture` over the native display
+/// slots.
 ///
 /// On other platforms (or if texture creation fails), falls back to the
 /// traditional `decodeImageFromPixels` → `CustomPaint` pipeline.
@@ -36,7 +38,7 @@ class GameDisplay extends StatefulWidget {
 }
 
 class _GameDisplayState extends State<GameDisplay> {
-  // ── Texture rendering (Android zero-copy path) ──
+  // ── Texture rendering (Android / Linux zero-copy path) ──
   int? _textureId;
   bool _textureRequested = false;
 
@@ -86,11 +88,11 @@ class _GameDisplayState extends State<GameDisplay> {
   }
 
   // ═══════════════════════════════════════════════════════════════════
-  //  Texture path (Android)
+  //  Texture path (Android, Linux)
   // ═══════════════════════════════════════════════════════════════════
 
   Future<void> _tryCreateTexture() async {
-    if (!Platform.isAndroid) {
+    if (!Platform.isAndroid && !Platform.isLinux) {
       // Texture rendering not supported — use fallback
       _registerFallbackCallback();
       return;
@@ -256,7 +258,7 @@ class _GameDisplayState extends State<GameDisplay> {
   }
 
   Widget _buildDisplay() {
-    // ── Texture path (Android zero-copy) ──
+    // ── Texture path (Android / Linux zero-copy) ──
     // Guard: never build texture UI after dispose (async create may complete late).
     if (!_isDisposed && _textureId != null) {
       return _buildTextureDisplay();
@@ -1,19 +1,169 @@
 #include "my_application.h"
 
+#include <dlfcn.h>
 #include <flutter_linux/flutter_linux.h>
 #ifdef GDK_WINDOWING_X11
 #include <gdk/gdkx.h>
 #endif
 
+#include <cstdint>
+#include <cstring>
+
 #include "flutter/generated_plugin_registrant.h"
 
+// Channel shared with the Android host for the game display texture.
+static constexpr char kDeviceChannel[] = "com.yourmateapps.retropal/device";
+
+// libyage_core entry points (see native/yage_libretro.h). The library is
+// loaded by Dart FFI; the runner only looks the symbols up.
+typedef void (*YageFrameAvailableFn)(void* user_data);
+typedef void (*YageTextureAttachFn)(YageFrameAvailableFn frame_available,
+                                    void* user_data);
+typedef const uint8_t* (*YageTextureAcquireFn)(uint32_t* width,
+                                               uint32_t* height);
+
+// Pixel buffer texture showing the newest display slot of libyage_core.
+// copy_pixels hands Flutter the slot in place; nothing is copied here.
+G_DECLARE_FINAL_TYPE(YageGameTexture,
+                     yage_game_texture,
+                     YAGE,
+                     GAME_TEXTURE,
+                     FlPixelBufferTexture)
+
+struct _YageGameTexture {
+  FlPixelBufferTexture parent_instance;
+  YageTextureAcquireFn acquire;
+};
+
+G_DEFINE_TYPE(YageGameTexture,
+              yage_game_texture,
+              fl_pixel_buffer_texture_get_type())
+
+// Implements FlPixelBufferTexture::copy_pixels.
+static gboolean yage_game_texture_copy_pixels(FlPixelBufferTexture* texture,
+                                              const uint8_t** out_buffer,
+                                              uint32_t* width,
+                                              uint32_t* height,
+                                              GError** error) {
+  YageGameTexture* self = YAGE_GAME_TEXTURE(texture);
+  *out_buffer = self->acquire(width, height);
+  return TRUE;
+}
+
+static void yage_game_texture_class_init(YageGameTextureClass* klass) {
+  FL_PIXEL_BUFFER_TEXTURE_CLASS(klass)->copy_pixels =
+      yage_game_texture_copy_pixels;
+}
+
+static void yage_game_texture_init(YageGameTexture* self) {}
+
 struct _MyApplication {
   GtkApplication parent_instance;
   char** dart_entrypoint_arguments;
+  FlMethodChannel* device_channel;
+  FlTextureRegistrar* texture_registrar;
+  FlTexture* game_texture;
+  void* yage_library;
+  YageTextureAttachFn yage_texture_attach;
+  YageTextureAcquireFn yage_texture_acquire_pixels;
 };
 
 G_DEFINE_TYPE(MyApplication, my_application, GTK_TYPE_APPLICATION)
 
+// Resolves the libyage_core texture entry points. Returns FALSE if the
+// library or the symbols are unavailable.
+static gboolean load_yage_core(MyApplication* self) {
+  if (self->yage_texture_attach != nullptr) {
+    return TRUE;
+  }
+  if (self->yage_library == nullptr) {
+    self->yage_library = dlopen("libyage_core.so", RTLD_NOW);
+  }
+  if (self->yage_library == nullptr) {
+    g_warning("Game texture: %s", dlerror());
+    return FALSE;
+  }
+  auto attach = reinterpret_cast<YageTextureAttachFn>(
+      dlsym(self->yage_library, "yage_texture_attach"));
+  auto acquire = reinterpret_cast<YageTextureAcquireFn>(
+      dlsym(self->yage_library, "yage_texture_acquire_pixels"));
+  if (attach == nullptr || acquire == nullptr) {
+    g_warning("Game texture: libyage_core has no texture entry points");
+    return FALSE;
+  }
+  self->yage_texture_attach = attach;
+  self->yage_texture_acquire_pixels = acquire;
+  return TRUE;
+}
+
+// Called by libyage_core on its frame loop thread after each new frame.
+static void game_texture_frame_available_cb(void* user_data) {
+  MyApplication* self = MY_APPLICATION(user_data);
+  fl_texture_registrar_mark_texture_frame_available(self->texture_registrar,
+                                                    self->game_texture);
+}
+
+static void destroy_game_texture(MyApplication* self) {
+  if (self->game_texture == nullptr) {
+    return;
+  }
+  // Detaching waits for an in-flight notification, so game_texture is no
+  // longer referenced from the frame loop thread afterwards.
+  self->yage_texture_attach(nullptr, nullptr);
+  fl_texture_registrar_unregister_texture(self->texture_registrar,
+                                          self->game_texture);
+  g_clear_object(&self->game_texture);
+}
+
+// Returns the texture ID, or null to make Dart fall back to image frames.
+static FlMethodResponse* create_game_texture(MyApplication* self) {
+  destroy_game_texture(self);
+  if (!load_yage_core(self)) {
+    return FL_METHOD_RESPONSE(fl_method_success_response_new(nullptr));
+  }
+
+  YageGameTexture* texture = YAGE_GAME_TEXTURE(
+      g_object_new(yage_game_texture_get_type(), nullptr));
+  texture->acquire = self->yage_texture_acquire_pixels;
+  self->game_texture = FL_TEXTURE(texture);
+  if (!fl_texture_registrar_register_texture(self->texture_registrar,
+                                             self->game_texture)) {
+    g_clear_object(&self->game_texture);
+    return FL_METHOD_RESPONSE(fl_method_success_response_new(nullptr));
+  }
+  self->yage_texture_attach(game_texture_frame_available_cb, self);
+
+  g_autoptr(FlValue) result =
+      fl_value_new_int(fl_texture_get_id(self->game_texture));
+  return FL_METHOD_RESPONSE(fl_method_success_response_new(result));
+}
+
+// Handles calls on the device channel.
+static void device_method_call_cb(FlMethodChannel* channel,
+                                  FlMethodCall* method_call,
+                                  gpointer user_data) {
+  MyApplication* self = MY_APPLICATION(user_data);
+  const gchar* method = fl_method_call_get_name(method_call);
+
+  g_autoptr(FlMethodResponse) response = nullptr;
+  if (strcmp(method, "createGameTexture") == 0) {
+    response = create_game_texture(self);
+  } else if (strcmp(method, "destroyGameTexture") == 0) {
+    destroy_game_texture(self);
+    response = FL_METHOD_RESPONSE(fl_method_success_response_new(nullptr));
+  } else if (strcmp(method, "updateGameTextureSize") == 0) {
+    // The texture takes its size from each display slot.
+    response = FL_METHOD_RESPONSE(fl_method_success_response_new(nullptr));
+  } else {
+    response = FL_METHOD_RESPONSE(fl_method_not_implemented_response_new());
+  }
+
+  g_autoptr(GError) error = nullptr;
+  if (!fl_method_call_respond(method_call, response, &error)) {
+    g_warning("Failed to send response: %s", error->message);
+  }
+}
+
 // Called when first Flutter frame received.
 static void first_frame_cb(MyApplication* self, FlView* view) {
   gtk_widget_show(gtk_widget_get_toplevel(GTK_WIDGET(view)));
@@ -75,6 +225,18 @@ static void my_application_activate(GApplication* application) {
 
   fl_register_plugins(FL_PLUGIN_REGISTRY(view));
 
+  g_autoptr(FlPluginRegistrar) registrar =
+      fl_plugin_registry_get_registrar_for_plugin(FL_PLUGIN_REGISTRY(view),
+                                                  "YageGameTexture");
+  self->texture_registrar = FL_TEXTURE_REGISTRAR(
+      g_object_ref(fl_plugin_registrar_get_texture_registrar(registrar)));
+  g_autoptr(FlStandardMethodCodec) codec = fl_standard_method_codec_new();
+  self->device_channel =
+      fl_method_channel_new(fl_plugin_registrar_get_messenger(registrar),
+                            kDeviceChannel, FL_METHOD_CODEC(codec));
+  fl_method_channel_set_method_call_handler(
+      self->device_channel, device_method_call_cb, self, nullptr);
+
   gtk_widget_grab_focus(GTK_WIDGET(view));
 }
 
@@ -121,6 +283,13 @@ static void my_application_shutdown(GApplication* application) {
 static void my_application_dispose(GObject* object) {
   MyApplication* self = MY_APPLICATION(object);
   g_clear_pointer(&self->dart_entrypoint_arguments, g_strfreev);
+  destroy_game_texture(self);
+  g_clear_object(&self->device_channel);
+  g_clear_object(&self->texture_registrar);
+  if (self->yage_library != nullptr) {
+    dlclose(self->yage_library);
+    self->yage_library = nullptr;
+  }
   G_OBJECT_CLASS(my_application_parent_class)->dispose(object);
 }
 
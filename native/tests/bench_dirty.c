@@ -0,0 +1,138 @@
+/*
+ * Dirty-row benchmark
+ *
+ * Replays synthetic RGB565 sequences shaped like typical play through
+ * video_refresh_callback and the video buffer, once with dirty-row
+ * tracking and once forcing every frame to be a full one, which is what
+ * the path did before the shadow existed:
+ *   GB   160x144  a sprite walking across a static background, a HUD
+ *                 counter redrawn every 8th frame, idle frames with no
+ *                 change and a full-screen scroll every 4 s;
+ *   GBA  240x160  the same, plus a 16-row animated water band redrawn
+ *                 every 2nd frame and a second sprite.
+ *
+ * For each run it reports the bytes the row converters wrote, the bytes a
+ * display copy of the changed rows moves (one bounding band of rows, as
+ * the dirty rect reports them, so it can exceed what was converted), the
+ * source bytes compared against the shadow and the time per frame.
+ *
+ *   yage_dirty_bench [frames, default 36000]
+ */
+
+#include "yage_libretro.c"
+
+/* The achievements runtime is not linked into the benchmark */
+void yage_rc_do_frame(void) {}
+
+#define BENCH_MAX_W 240
+#define BENCH_MAX_H 160
+#define BENCH_BPP   4      /* RGBA8888 output */
+
+static uint16_t g_bench_fb[BENCH_MAX_W * BENCH_MAX_H];
+
+static yage_pixconv_row_fn g_bench_real_row;
+static uint64_t g_bench_converted;
+
+/* Counts the output bytes of every row converted, then converts it */
+static void bench_count_row(void* dst, const void* src, int width, const uint32_t* table) {
+    g_bench_converted += (uint64_t)width * BENCH_BPP;
+    g_bench_real_row(dst, src, width, table);
+}
+
+static void bench_sprite(int w, int x0, int y0, uint16_t c) {
+    for (int y = y0; y < y0 + 16; y++)
+        for (int x = x0; x < x0 + 16; x++) g_bench_fb[y * w + x] = c;
+}
+
+static void bench_draw(int k, int w, int h, int gba) {
+    /* Background tiles */
+    for (int y = 0; y < h; y++) {
+        int scroll = (k % 240) < 8 ? (k % 240) * 8 + k / 240 : k / 240;
+        for (int x = 0; x < w; x++)
+            g_bench_fb[y * w + x] = (uint16_t)((((x + scroll) >> 3) ^ (y >> 3)) * 0x0841);
+    }
+    /* Animated water band, redrawn every 2nd frame */
+    if (gba) {
+        int phase = k / 2;
+        for (int y = 100; y < 116; y++)
+            for (int x = 0; x < w; x++)
+                g_bench_fb[y * w + x] = (uint16_t)(0x001F | (((x + y + phase) & 7) << 6));
+    }
+    /* A 16x16 sprite walking right, standing still every 5th frame */
+    bench_sprite(w, (k - k / 5) % (w - 16), 64, 0xF800);
+    if (gba) bench_sprite(w, w - 16 - (k / 3) % (w - 16), 30, 0x07E0);
+    /* HUD counter on the bottom 8 rows, redrawn every 8th frame */
+    int hud = k / 8;
+    for (int y = h - 8; y < h; y++)
+        for (int x = 0; x < 48; x++)
+            g_bench_fb[y * w + x] = (uint16_t)(((hud >> (x / 6)) & 1) ? 0xFFFF : 0);
+}
+
+static double bench_now(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (double)t.tv_sec + (double)t.tv_nsec * 1e-9;
+}
+
+static void bench(YageCore* core, int frames, int w, int h, int gba, int dirty_rows) {
+    g_bench_converted = 0;
+    uint64_t copied = 0, compared = 0;
+    uint32_t shown = g_video_serial;
+    g_video_force_full = 1;
+
+    double t0 = bench_now();
+    for (int i = 0; i < frames; i++) {
+        bench_draw(i, w, h, gba);
+        if (!dirty_rows) g_video_force_full = 1;
+        else compared += (uint64_t)w * 2 * h;
+        video_refresh_callback(g_bench_fb, w, h, w * 2);
+        yage_core_get_video_buffer(core);
+
+        /* What a display copy of the changed rows moves */
+        int top, bottom;
+        if (video_dirty_rows(shown, h, &top, &bottom) > 0)
+            copied += (uint64_t)(bottom - top + 1) * w * BENCH_BPP;
+        shown = g_video_serial;
+    }
+    double t = bench_now() - t0;
+
+    uint64_t full = (uint64_t)frames * w * h * BENCH_BPP;
+    printf("%-3s %-11s converted %7.2f MB (%5.1f%%)  copied %7.2f MB (%5.1f%%)  "
+           "compared %7.2f MB  %6.2f us/frame\n",
+           gba ? "GBA" : "GB", dirty_rows ? "dirty rows" : "full frames",
+           g_bench_converted / 1e6, 100.0 * (double)g_bench_converted / (double)full,
+           copied / 1e6, 100.0 * (double)copied / (double)full, compared / 1e6,
+           t / frames * 1e6);
+}
+
+static void bench_content(YageCore* core, int frames, int gba) {
+    int w = gba ? 240 : 160, h = gba ? 160 : 144;
+
+    /* Settle the converter at this size, then count through it */
+    if (g_bench_real_row) g_convert_row = g_bench_real_row;
+    bench_draw(0, w, h, gba);
+    video_refresh_callback(g_bench_fb, w, h, w * 2);
+    yage_core_get_video_buffer(core);
+    g_bench_real_row = g_convert_row;
+    g_convert_row = bench_count_row;
+
+    bench(core, frames, w, h, gba, 0);
+    bench(core, frames, w, h, gba, 1);
+}
+
+int main(int argc, char** argv) {
+    int frames = argc > 1 ? atoi(argv[1]) : 36000;
+    if (frames <= 0) frames = 36000;
+
+    YageCore* core = yage_core_create();
+    if (!core) return 1;
+    int fmt = RETRO_PIXEL_FORMAT_RGB565;
+    environment_callback(10, &fmt);   /* RETRO_ENVIRONMENT_SET_PIXEL_FORMAT */
+
+    printf("%d frames per run, RGB565 -> RGBA8888\n", frames);
+    bench_content(core, frames, 0);
+    bench_content(core, frames, 1);
+
+    yage_core_destroy(core);
+    return 0;
+}
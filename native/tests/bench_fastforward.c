@@ -0,0 +1,107 @@
+/*
+ * Fast-forward benchmark
+ *
+ * Runs the real frame loop at 800% speed over a fake core that costs
+ * `cpu` microseconds per frame to emulate plus `ppu` microseconds when it
+ * renders video, and honours RETRO_ENVIRONMENT_GET_AUDIO_VIDEO_ENABLE by
+ * skipping the render when the video bit is clear.  Run once with the
+ * core asking for the bits (only the frame about to be shown renders) and
+ * once ignoring them (every frame renders, as before the loop reported
+ * them), and report the frames per second reached against the 800%
+ * target.
+ *
+ *   yage_fastforward_bench [seconds, default 5] [cpu us, default 400]
+ *                          [ppu us, default 3000]
+ */
+
+#include "yage_libretro.c"
+
+/* The achievements runtime is not linked into the benchmark */
+void yage_rc_do_frame(void) {}
+
+#define BENCH_W 160
+#define BENCH_H 144
+#define BENCH_BASE_FPS 59.7275   /* the loop's default (GBA) rate */
+
+static uint16_t g_bench_fb[BENCH_W * BENCH_H];
+static int g_bench_honor;
+static int g_bench_cpu_us, g_bench_ppu_us;
+static atomic_int g_bench_frames, g_bench_rendered;
+
+static int64_t bench_now_ns(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (int64_t)t.tv_sec * 1000000000LL + t.tv_nsec;
+}
+
+/* Stand-in for emulation work the compiler cannot drop */
+static void bench_spin(int us) {
+    int64_t end = bench_now_ns() + (int64_t)us * 1000;
+    while (bench_now_ns() < end) {}
+}
+
+static void bench_run(void) {
+    int frame = atomic_fetch_add(&g_bench_frames, 1);
+    int av = RETRO_AV_ENABLE_VIDEO | RETRO_AV_ENABLE_AUDIO;
+    if (g_bench_honor) environment_callback(47, &av);   /* GET_AUDIO_VIDEO_ENABLE */
+
+    bench_spin(g_bench_cpu_us);
+    if (!(av & RETRO_AV_ENABLE_VIDEO)) return;
+
+    bench_spin(g_bench_ppu_us);
+    for (int i = 0; i < BENCH_W * BENCH_H; i++) g_bench_fb[i] = (uint16_t)(i * 7 + frame);
+    video_refresh_callback(g_bench_fb, BENCH_W, BENCH_H, BENCH_W * 2);
+    atomic_fetch_add(&g_bench_rendered, 1);
+}
+
+static void bench_frame_cb(int32_t frames_run) { (void)frames_run; }
+
+static void bench(YageCore* core, double seconds, int honor) {
+    g_bench_honor = honor;
+    atomic_store(&g_bench_frames, 0);
+    atomic_store(&g_bench_rendered, 0);
+    yage_frame_loop_set_speed(core, 800);
+
+    int64_t t0 = bench_now_ns();
+    if (yage_frame_loop_start(core, bench_frame_cb) != 0) {
+        printf("frame loop failed to start\n");
+        return;
+    }
+    struct timespec ts = { (time_t)seconds, (long)((seconds - (time_t)seconds) * 1e9) };
+    nanosleep(&ts, NULL);
+    yage_frame_loop_stop(core);
+    double t = (double)(bench_now_ns() - t0) * 1e-9;
+
+    int frames = atomic_load(&g_bench_frames);
+    int rendered = atomic_load(&g_bench_rendered);
+    double fps = frames / t;
+    printf("%-22s %7.1f fps  (%4.0f%% speed, target 800%%)  rendered %d of %d frames\n",
+           honor ? "AV enable honoured" : "every frame rendered", fps,
+           fps / BENCH_BASE_FPS * 100.0, rendered, frames);
+}
+
+int main(int argc, char** argv) {
+    double seconds = argc > 1 ? atof(argv[1]) : 5.0;
+    g_bench_cpu_us = argc > 2 ? atoi(argv[2]) : 400;
+    g_bench_ppu_us = argc > 3 ? atoi(argv[3]) : 3000;
+    if (seconds <= 0) seconds = 5.0;
+
+    YageCore* core = yage_core_create();
+    if (!core) return 1;
+    core->retro_run = (retro_run_t)bench_run;
+    core->game_loaded = 1;
+    int fmt = RETRO_PIXEL_FORMAT_RGB565;
+    environment_callback(10, &fmt);   /* RETRO_ENVIRONMENT_SET_PIXEL_FORMAT */
+    g_width = BENCH_W;
+    g_height = BENCH_H;
+
+    printf("%.1f s per run at 800%%, core: %d us/frame + %d us to render\n",
+           seconds, g_bench_cpu_us, g_bench_ppu_us);
+    bench(core, seconds, 0);
+    bench(core, seconds, 1);
+
+    core->retro_run = NULL;
+    core->game_loaded = 0;
+    yage_core_destroy(core);
+    return 0;
+}
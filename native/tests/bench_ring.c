@@ -0,0 +1,112 @@
+/*
+ * yage_ring throughput benchmark
+ *
+ * Pushes 131072 Hz stereo (the fast-forward / GB APU rate) through one
+ * ring, producer and consumer on their own threads as the emulation and
+ * audio threads are: the producer writes one 60 Hz frame's worth (2185
+ * frames) at a time, the consumer reads device-period sized blocks and
+ * checks the samples arrive in order.  Reports frames/s and how many
+ * times real time that is, then the same with yage_ring_gain applied to
+ * every block (at unity, so the order check still holds).
+ *
+ *   yage_ring_bench [seconds of audio, default 600]
+ */
+
+#define _GNU_SOURCE
+#include "yage_ring.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define RATE          131072
+#define FRAME_BLOCK   2185     /* 131072 / 59.97 */
+#define PERIOD_BLOCK  1024
+#define RING_FRAMES   65536
+
+static YageRing* g_ring;
+static size_t g_total;
+static atomic_int g_corrupt;
+
+static double now(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (double)t.tv_sec + (double)t.tv_nsec * 1e-9;
+}
+
+static void* consumer(void* arg) {
+    (void)arg;
+    static int16_t out[PERIOD_BLOCK * 2];
+    size_t got = 0;
+    uint16_t expect = 0;
+    while (got < g_total) {
+        size_t n = yage_ring_read(g_ring, out, PERIOD_BLOCK);
+        if (n == 0) {
+            sched_yield();
+            continue;
+        }
+        for (size_t i = 0; i < n; i++, expect++) {
+            if ((uint16_t)out[i * 2] != expect) atomic_store(&g_corrupt, 1);
+        }
+        got += n;
+    }
+    return NULL;
+}
+
+static double run(int gain) {
+    static int16_t block[FRAME_BLOCK * 2], scaled[FRAME_BLOCK * 2];
+    yage_ring_reset(g_ring);
+
+    pthread_t thread;
+    double t0 = now();
+    pthread_create(&thread, NULL, consumer, NULL);
+    uint16_t next = 0;
+    for (size_t sent = 0; sent < g_total;) {
+        size_t n = g_total - sent < FRAME_BLOCK ? g_total - sent : FRAME_BLOCK;
+        for (size_t i = 0; i < n; i++) {
+            block[i * 2] = (int16_t)(uint16_t)(next + i);
+            block[i * 2 + 1] = (int16_t)(uint16_t)~(next + i);
+        }
+        const int16_t* src = block;
+        if (gain) {
+            yage_ring_gain(scaled, block, n * 2, 256);
+            src = scaled;
+        }
+        size_t done = 0;
+        while (done < n) {
+            size_t w = yage_ring_write(g_ring, src + done * 2, n - done);
+            if (w == 0) sched_yield();
+            done += w;
+        }
+        next = (uint16_t)(next + n);
+        sent += n;
+    }
+    pthread_join(thread, NULL);
+    return now() - t0;
+}
+
+int main(int argc, char** argv) {
+    double seconds = argc > 1 ? atof(argv[1]) : 600.0;
+    if (seconds <= 0) seconds = 600.0;
+    g_total = (size_t)(seconds * RATE);
+    g_ring = yage_ring_create(RING_FRAMES);
+    if (!g_ring) return 1;
+
+    printf("%.0f s of %d Hz stereo, %d-frame writes, %d-frame reads, %zu-frame ring\n",
+           seconds, RATE, FRAME_BLOCK, PERIOD_BLOCK, yage_ring_capacity(g_ring));
+    for (int gain = 0; gain <= 1; gain++) {
+        double t = run(gain);
+        printf("%-16s %8.1f Mframes/s  %7.0fx real time  (%.3f s)\n",
+               gain ? "write+gain/read" : "write/read", (double)g_total / t / 1e6,
+               (double)g_total / t / RATE, t);
+    }
+    yage_ring_destroy(g_ring);
+    if (atomic_load(&g_corrupt)) {
+        printf("FAIL: samples arrived out of order\n");
+        return 1;
+    }
+    return 0;
+}
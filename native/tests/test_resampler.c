@@ -0,0 +1,222 @@
+/*
+ * yage_resampler quality test
+ *
+ * - 1 kHz sines at the rates the cores use (32768 Hz for the GBA, 131072
+ *   Hz for fast-forward / the GB APU) resampled to 48 kHz: the signal to
+ *   noise-and-distortion ratio and the THD of the output must clear a
+ *   fixed floor.
+ * - yage_resampler_drc never leaves ±YAGE_RESAMPLER_MAX_ADJUST and moves
+ *   the right way; set_adjust is clamped to the same range.
+ * - DC in, DC out: a constant input stays constant whatever sub-sample
+ *   phase the kernel lands on, with the ratio nudged between calls.
+ *
+ * Input is fed in odd-sized chunks so the history carried between calls
+ * is exercised too.
+ */
+
+#include "yage_resampler.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define OUT_RATE   48000.0
+#define TONE_HZ    1000.0
+#define AMPLITUDE  16384.0
+#define SECONDS    2
+#define CHUNK      997
+#define SETTLE     (YAGE_RESAMPLER_MAX_TAPS * 4 + 480)   /* output frames */
+
+#define MIN_SINAD_DB 72.0    /* signal / (noise + distortion) */
+#define MAX_THD_DB  -85.0    /* harmonics 2..10 / fundamental */
+#define MAX_DC_LSB   1       /* peak deviation from a constant input */
+
+static int g_failures = 0;
+
+static void expect(int ok, const char* what) {
+    printf("%-4s %s\n", ok ? "ok" : "FAIL", what);
+    if (!ok) g_failures++;
+}
+
+/* Power of the `hz` component of `x` (least squares over whole cycles) */
+static double tone_power(const double* x, size_t n, double hz, double rate,
+                         double* c_out, double* s_out) {
+    double c = 0, s = 0;
+    for (size_t i = 0; i < n; i++) {
+        double w = 2.0 * M_PI * hz * (double)i / rate;
+        c += x[i] * cos(w);
+        s += x[i] * sin(w);
+    }
+    c *= 2.0 / (double)n;
+    s *= 2.0 / (double)n;
+    if (c_out) *c_out = c;
+    if (s_out) *s_out = s;
+    return (c * c + s * s) / 2.0;
+}
+
+/* Resample `in_frames` of `in` through `rs`, CHUNK frames per call;
+ * returns the output frame count (allocated into *out). */
+static size_t run(YageResampler* rs, const int16_t* in, size_t in_frames, int16_t** out,
+                  int nudge) {
+    size_t cap = yage_resampler_max_output(rs, in_frames) + CHUNK;
+    int16_t* buf = malloc(cap * 2 * sizeof(int16_t));
+    size_t n = 0;
+    int step = 0;
+    for (size_t pos = 0; pos < in_frames; pos += CHUNK, step++) {
+        size_t frames = in_frames - pos < CHUNK ? in_frames - pos : CHUNK;
+        if (nudge) {
+            /* Walk the adjustment across its whole range */
+            yage_resampler_set_adjust(rs, 1.0 + YAGE_RESAMPLER_MAX_ADJUST *
+                                              sin((double)step * 0.37));
+        }
+        n += yage_resampler_process(rs, in + pos * 2, frames, buf + n * 2, cap - n);
+    }
+    *out = buf;
+    return n;
+}
+
+static void test_sine(double in_rate) {
+    char what[128];
+    size_t in_frames = (size_t)(in_rate * SECONDS);
+    int16_t* in = malloc(in_frames * 2 * sizeof(int16_t));
+    for (size_t i = 0; i < in_frames; i++) {
+        double v = AMPLITUDE * sin(2.0 * M_PI * TONE_HZ * (double)i / in_rate);
+        in[i * 2] = (int16_t)lrint(v);
+        in[i * 2 + 1] = (int16_t)lrint(-v);
+    }
+
+    YageResampler* rs = yage_resampler_create(in_rate, OUT_RATE);
+    if (!rs) {
+        snprintf(what, sizeof(what), "create %.0f -> %.0f", in_rate, OUT_RATE);
+        expect(0, what);
+        free(in);
+        return;
+    }
+    int16_t* out;
+    size_t n = run(rs, in, in_frames, &out, 0);
+
+    /* Up to half a kernel of input is still waiting for lookahead */
+    double expected = (double)in_frames * OUT_RATE / in_rate;
+    double held = YAGE_RESAMPLER_MAX_TAPS / 2 * OUT_RATE / in_rate + 2.0;
+    snprintf(what, sizeof(what), "%.0f -> %.0f: %zu frames out (%.0f expected)",
+             in_rate, OUT_RATE, n, expected);
+    expect((double)n <= expected + 2.0 && (double)n >= expected - held, what);
+
+    /* Skip the kernel's settling time, analyse a whole number of cycles */
+    size_t skip = SETTLE;
+    size_t len = (size_t)(OUT_RATE / TONE_HZ) * 1500;   /* 1.5 s at 48 kHz */
+    if (skip + len > n) len = n > skip ? (n - skip) / 48 * 48 : 0;
+    for (int ch = 0; ch < 2 && len > 0; ch++) {
+        double* x = malloc(len * sizeof(double));
+        for (size_t i = 0; i < len; i++) x[i] = out[(skip + i) * 2 + ch];
+
+        double c, s;
+        double signal = tone_power(x, len, TONE_HZ, OUT_RATE, &c, &s);
+        double residual = 0;
+        for (size_t i = 0; i < len; i++) {
+            double w = 2.0 * M_PI * TONE_HZ * (double)i / OUT_RATE;
+            double e = x[i] - (c * cos(w) + s * sin(w));
+            residual += e * e;
+        }
+        residual /= (double)len;
+        double harmonics = 0;
+        for (int h = 2; h <= 10; h++)
+            harmonics += tone_power(x, len, TONE_HZ * h, OUT_RATE, NULL, NULL);
+
+        double sinad = 10.0 * log10(signal / (residual > 1e-12 ? residual : 1e-12));
+        double thd = 10.0 * log10((harmonics > 1e-12 ? harmonics : 1e-12) / signal);
+        snprintf(what, sizeof(what), "%.0f -> %.0f ch%d: SINAD %.1f dB (>= %.0f)",
+                 in_rate, OUT_RATE, ch, sinad, MIN_SINAD_DB);
+        expect(sinad >= MIN_SINAD_DB, what);
+        snprintf(what, sizeof(what), "%.0f -> %.0f ch%d: THD %.1f dB (<= %.0f)",
+                 in_rate, OUT_RATE, ch, thd, MAX_THD_DB);
+        expect(thd <= MAX_THD_DB, what);
+        free(x);
+    }
+    if (len == 0) expect(0, "not enough output to analyse");
+
+    free(out);
+    free(in);
+    yage_resampler_destroy(rs);
+}
+
+static void test_drc(void) {
+    const size_t target = 4800;
+    int bounded = 1, monotonic = 1;
+    double prev = 2.0;
+    for (size_t fill = 0; fill <= target * 4; fill += 7) {
+        double a = yage_resampler_drc(fill, target, YAGE_RESAMPLER_MAX_ADJUST);
+        if (a < 1.0 - YAGE_RESAMPLER_MAX_ADJUST - 1e-12 ||
+            a > 1.0 + YAGE_RESAMPLER_MAX_ADJUST + 1e-12)
+            bounded = 0;
+        if (a > prev + 1e-12) monotonic = 0;
+        prev = a;
+    }
+    expect(bounded, "drc stays within 1 +/- MAX_ADJUST for fill 0..4x target");
+    expect(monotonic, "drc never speeds up as the buffer fills");
+    expect(yage_resampler_drc(0, target, YAGE_RESAMPLER_MAX_ADJUST) ==
+               1.0 + YAGE_RESAMPLER_MAX_ADJUST &&
+           yage_resampler_drc(target, target, YAGE_RESAMPLER_MAX_ADJUST) == 1.0 &&
+           yage_resampler_drc(target * 3, target, YAGE_RESAMPLER_MAX_ADJUST) ==
+               1.0 - YAGE_RESAMPLER_MAX_ADJUST,
+           "drc is +max when empty, 1 at target, -max when over-full");
+    expect(yage_resampler_drc(123, 0, YAGE_RESAMPLER_MAX_ADJUST) == 1.0,
+           "drc with no target is neutral");
+
+    /* A second of input at an out-of-range adjustment: the output count
+     * gives the ratio actually used */
+    static int16_t silence[32768 * 2];
+    static int16_t out[(32768 * 2) * 2];
+    double ratio[2];
+    for (int i = 0; i < 2; i++) {
+        YageResampler* rs = yage_resampler_create(32768.0, OUT_RATE);
+        yage_resampler_set_adjust(rs, i == 0 ? 1.5 : 0.5);
+        size_t n = yage_resampler_process(rs, silence, 32768, out, sizeof(out) / 4);
+        ratio[i] = (double)n / OUT_RATE;
+        yage_resampler_destroy(rs);
+    }
+    double slack = (YAGE_RESAMPLER_MAX_TAPS + 2) / OUT_RATE;
+    expect(ratio[0] <= 1.0 + YAGE_RESAMPLER_MAX_ADJUST + 1e-4 &&
+           ratio[0] >= 1.0 + YAGE_RESAMPLER_MAX_ADJUST - slack &&
+           ratio[1] <= 1.0 - YAGE_RESAMPLER_MAX_ADJUST + 1e-4 &&
+           ratio[1] >= 1.0 - YAGE_RESAMPLER_MAX_ADJUST - slack,
+           "set_adjust clamps to 1 +/- MAX_ADJUST");
+}
+
+static void test_dc(double in_rate, int16_t level) {
+    char what[128];
+    size_t in_frames = (size_t)in_rate / 2;
+    int16_t* in = malloc(in_frames * 2 * sizeof(int16_t));
+    for (size_t i = 0; i < in_frames * 2; i++) in[i] = level;
+
+    YageResampler* rs = yage_resampler_create(in_rate, OUT_RATE);
+    int16_t* out;
+    size_t n = run(rs, in, in_frames, &out, 1);
+    size_t skip = SETTLE;
+    int worst = 0;
+    for (size_t i = skip * 2; i < n * 2; i++) {
+        int d = abs(out[i] - level);
+        if (d > worst) worst = d;
+    }
+    snprintf(what, sizeof(what), "DC %d at %.0f -> %.0f (nudged): peak error %d LSB over %zu frames",
+             level, in_rate, OUT_RATE, worst, n > skip ? n - skip : 0);
+    expect(n > skip && worst <= MAX_DC_LSB, what);
+    free(out);
+    free(in);
+    yage_resampler_destroy(rs);
+}
+
+int main(void) {
+    test_sine(32768.0);
+    test_sine(131072.0);
+    test_drc();
+    test_dc(32768.0, 12345);
+    test_dc(44100.0, -20000);
+    test_dc(131072.0, 32767);
+    printf("resampler: %d failed\n", g_failures);
+    return g_failures == 0 ? 0 : 1;
+}
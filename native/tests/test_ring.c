@@ -0,0 +1,112 @@
+/*
+ * yage_ring test
+ *
+ * yage_ring_gain's vector path (SSE2 or NEON, whichever the build has)
+ * must match the scalar formula exactly: every gain 0..256 over all
+ * 65,536 sample values, odd lengths for the tail, in place as the pull
+ * stream uses it, and out-of-range gains clamped.  Plus single-threaded
+ * write/read/skip wrap-around with a counting pattern.
+ */
+
+#include "yage_ring.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SAMPLES (65536 + 7)
+
+static int g_failures = 0;
+
+static void expect(int ok, const char* what) {
+    printf("%-4s %s\n", ok ? "ok" : "FAIL", what);
+    if (!ok) g_failures++;
+}
+
+static int16_t scalar_gain(int16_t x, int gain_q8) {
+    if (gain_q8 < 0) gain_q8 = 0;
+    if (gain_q8 > 256) gain_q8 = 256;
+    return (int16_t)((x * gain_q8) >> 8);
+}
+
+static void test_gain(void) {
+    static int16_t src[SAMPLES], dst[SAMPLES + 1], inplace[SAMPLES];
+    for (int i = 0; i < SAMPLES; i++) src[i] = (int16_t)(uint16_t)(i * 40503u);
+    src[0] = -32768;
+    src[1] = 32767;
+
+    int bad_gain = -1, bad_tail = -1, bad_inplace = -1;
+    for (int gain = 0; gain <= 256; gain++) {
+        dst[SAMPLES] = 0x5A5A;
+        yage_ring_gain(dst, src, SAMPLES, gain);
+        for (int i = 0; i < SAMPLES && bad_gain < 0; i++)
+            if (dst[i] != scalar_gain(src[i], gain)) bad_gain = gain;
+        if (dst[SAMPLES] != 0x5A5A && bad_gain < 0) bad_gain = gain;
+
+        for (int len = 0; len <= 17 && bad_tail < 0; len++) {
+            memset(dst, 0x5A, sizeof(dst));
+            yage_ring_gain(dst, src + 3, (size_t)len, gain);
+            for (int i = 0; i < len; i++)
+                if (dst[i] != scalar_gain(src[3 + i], gain)) bad_tail = gain;
+            if (dst[len] != 0x5A5A) bad_tail = gain;
+        }
+
+        memcpy(inplace, src, sizeof(inplace));
+        yage_ring_gain(inplace, inplace, SAMPLES, gain);
+        for (int i = 0; i < SAMPLES && bad_inplace < 0; i++)
+            if (inplace[i] != scalar_gain(src[i], gain)) bad_inplace = gain;
+    }
+    expect(bad_gain < 0, "gain 0..256 matches scalar for all sample values");
+    if (bad_gain >= 0) printf("     first mismatch at gain %d\n", bad_gain);
+    expect(bad_tail < 0, "gain tails (0..17 samples) match scalar and stop at the end");
+    expect(bad_inplace < 0, "gain in place matches scalar");
+
+    int clamp_ok = 1;
+    yage_ring_gain(dst, src, SAMPLES, -40);
+    for (int i = 0; i < SAMPLES; i++) clamp_ok &= dst[i] == 0;
+    yage_ring_gain(dst, src, SAMPLES, 1000);
+    clamp_ok &= memcmp(dst, src, sizeof(src)) == 0;
+    expect(clamp_ok, "gain below 0 mutes, above 256 passes through");
+}
+
+static void test_wrap(void) {
+    YageRing* ring = yage_ring_create(1000);   /* rounds up to 1024 */
+    expect(ring && yage_ring_capacity(ring) == 1024, "capacity rounds up to a power of two");
+    if (!ring) return;
+
+    static int16_t in[2 * 700], out[2 * 700];
+    int16_t next_in = 0, next_out = 0;
+    int ok = 1;
+    for (int step = 0; step < 5000 && ok; step++) {
+        size_t n = (size_t)(step * 131 % 700);
+        for (size_t i = 0; i < n; i++) {
+            in[i * 2] = (int16_t)(next_in + i);
+            in[i * 2 + 1] = (int16_t)~(next_in + i);
+        }
+        size_t w = yage_ring_write(ring, in, n);
+        if (w > n || yage_ring_available(ring) > yage_ring_capacity(ring)) ok = 0;
+        next_in = (int16_t)(next_in + w);
+
+        size_t m = (size_t)(step * 257 % 700);
+        size_t r = step % 7 == 0 ? yage_ring_skip(ring, m) : yage_ring_read(ring, out, m);
+        if (step % 7 != 0) {
+            for (size_t i = 0; i < r; i++) {
+                if (out[i * 2] != (int16_t)(next_out + i) ||
+                    out[i * 2 + 1] != (int16_t)~(next_out + i)) ok = 0;
+            }
+        }
+        next_out = (int16_t)(next_out + r);
+        if (yage_ring_available(ring) + yage_ring_space(ring) != yage_ring_capacity(ring)) ok = 0;
+    }
+    expect(ok, "write/read/skip keep order and accounting across wrap-around");
+    yage_ring_reset(ring);
+    expect(yage_ring_available(ring) == 0, "reset empties the ring");
+    yage_ring_destroy(ring);
+}
+
+int main(void) {
+    test_gain();
+    test_wrap();
+    printf("ring: %d failed\n", g_failures);
+    return g_failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,746 @@
+/*
+ * YAGE Audio Engine — Implementation
+ *
+ * Ring: a yage_ring of AUDIO_RING_FRAMES, created with the first open and
+ * kept, so a stats call racing a close never sees it freed.  A skip
+ * request from the producer is handed over in g_skip and applied by the
+ * consumer.
+ *
+ * Fast-forward: effective_speed() turns the requested speed into the one
+ * to play at.  While the host keeps up that is the requested speed
+ * itself (the frame loop paces it exactly); a measurement over
+ * AUDIO_SPEED_WINDOW only takes over when the core clearly delivers less,
+ * since stretching to the requested speed would then starve the device.
+ * Decimation follows the speed through the resampler's input rate,
+ * which is only moved when it drifts by more than AUDIO_RATE_TOLERANCE
+ * so the kernel is not re-tabulated on every push.
+ *
+ * Telemetry: the consumer samples the ring fill once per period into two
+ * AUDIO_TELEMETRY_WINDOW windows, the current one and the last complete
+ * one, and publishes their combined min / max and histogram.  The
+ * producer publishes the ratio, speed and pipeline delay with every push.
+ * All of it goes through relaxed atomics: each value is consistent on its
+ * own, the snapshot as a whole only roughly.
+ *
+ * Shutdown: the producer brackets every push with g_pushing, and
+ * yage_audio_close() clears g_active then waits for g_pushing to drain
+ * before the resampler goes away (both sequentially consistent, as in
+ * yage_record.c).
+ */
+
+#include "yage_audio.h"
+#include "yage_libretro.h"  /* YAGE_AUDIO_BACKEND_*, YageAudioStats */
+
+#include <string.h>
+
+#ifndef _WIN32
+#include <math.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "yage_record.h"     /* WAV header */
+#include "yage_resampler.h"
+#include "yage_ring.h"
+#include "yage_stretch.h"
+
+#define AUDIO_RING_FRAMES  16384                 /* ~340 ms at 48 kHz */
+#define AUDIO_TARGET_PERIODS 6                   /* DRC target fill */
+
+#define AUDIO_FF_MIN_SPEED      1.02   /* slower than this plays as 1× */
+#define AUDIO_STRETCH_MAX_SPEED 3.0    /* AUTO: stretch up to here, then decimate */
+#define AUDIO_SPEED_WINDOW      0.25   /* seconds per achieved-speed measurement */
+#define AUDIO_SPEED_GAP         0.1    /* a longer pause between pushes restarts it */
+#define AUDIO_SPEED_SHORTFALL   0.97   /* measured / requested that counts as lagging */
+#define AUDIO_RATE_TOLERANCE    0.0025 /* decimation ratio drift left to DRC */
+#define AUDIO_TELEMETRY_WINDOW  5.0    /* seconds per fill histogram window */
+
+static YageRing*  g_ring = NULL;
+static atomic_int g_skip = 0;         /* frames the consumer should drop */
+
+static atomic_int g_active  = 0;      /* producer may push */
+static atomic_int g_pushing = 0;      /* producer inside a push */
+static atomic_int g_backend = -1;
+static double     g_device_rate = 48000.0;
+static int        g_period_frames = 256;
+static int        g_target_frames = 256 * AUDIO_TARGET_PERIODS;
+
+static atomic_uint g_underruns = 0;
+static atomic_uint g_overflows = 0;
+static atomic_int  g_ff_mode = YAGE_AUDIO_FF_AUTO;
+static atomic_int  g_device_frames = 256;   /* held by the device past the ring */
+
+/* Published telemetry (see the top of the file) */
+static atomic_uint g_fill_now = 0;          /* frames */
+static atomic_uint g_fill_min = 0;
+static atomic_uint g_fill_max = 0;
+static atomic_uint g_fill_periods = 0;      /* periods g_fill_hist spans */
+static atomic_uint g_fill_hist[YAGE_AUDIO_FILL_BUCKETS];
+static atomic_uint g_ratio_ppm = 0;         /* resampler ratio × 10^6 */
+static atomic_uint g_speed_ppm = 1000000;   /* tempo × 10^6 */
+static atomic_uint g_pipe_frames = 0;       /* resampler + stretch delay, device frames */
+
+/* Producer-side state */
+static YageResampler* g_rs = NULL;
+static double   g_rs_rate = 0;         /* resampler input rate */
+static int16_t* g_rs_out = NULL;
+static size_t   g_rs_out_frames = 0;
+static YageStretch* g_st = NULL;
+static int16_t* g_st_out = NULL;
+static size_t   g_st_out_frames = 0;
+static int      g_stretching = 0;      /* g_st holds a pending overlap */
+static double   g_speed_requested = 1.0;
+static double   g_speed = 1.0;         /* speed being played at */
+static double   g_speed_t0 = 0;        /* measurement window start */
+static double   g_speed_last = 0;      /* previous push */
+static double   g_speed_audio = 0;     /* seconds of audio pushed since t0 */
+
+/* Consumer-side state */
+static int     g_started = 0;         /* pre-buffer reached */
+static int     g_starved = 0;         /* inside an underrun episode */
+static int     g_fade = 0;
+static int16_t g_last_l = 0;
+static int16_t g_last_r = 0;
+static uint32_t g_bucket_frames = 240;   /* device frames per histogram bucket */
+static uint32_t g_window_periods = 938;  /* periods per telemetry window */
+static uint32_t g_hist_cur[YAGE_AUDIO_FILL_BUCKETS];
+static uint32_t g_hist_prev[YAGE_AUDIO_FILL_BUCKETS];
+static uint32_t g_cur_periods = 0, g_cur_min = 0, g_cur_max = 0;
+static uint32_t g_prev_periods = 0, g_prev_min = 0, g_prev_max = 0;
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/* Grow a producer scratch buffer to hold `frames` stereo frames */
+static int reserve_frames(int16_t** buffer, size_t* capacity, size_t frames) {
+    if (frames <= *capacity) return 0;
+    int16_t* grown = (int16_t*)realloc(*buffer, frames * 2 * sizeof(int16_t));
+    if (!grown) return -1;
+    *buffer = grown;
+    *capacity = frames;
+    return 0;
+}
+
+static double effective_speed(size_t frames, double source_rate, double speed) {
+    if (speed < AUDIO_FF_MIN_SPEED) {
+        g_speed_requested = g_speed = 1.0;
+        return 1.0;
+    }
+    double now = now_seconds();
+    if (speed != g_speed_requested) {
+        g_speed_requested = g_speed = speed;
+        g_speed_t0 = now;
+        g_speed_audio = 0;
+    } else if (now - g_speed_last > AUDIO_SPEED_GAP) {
+        /* Paused in between: the gap says nothing about the host */
+        g_speed_t0 = now;
+        g_speed_audio = 0;
+    } else {
+        g_speed_audio += (double)frames / source_rate;
+        if (now - g_speed_t0 >= AUDIO_SPEED_WINDOW) {
+            double measured = g_speed_audio / (now - g_speed_t0);
+            if (measured >= speed * AUDIO_SPEED_SHORTFALL) g_speed = speed;
+            else g_speed = measured > 1.0 ? measured : 1.0;
+            g_speed_t0 = now;
+            g_speed_audio = 0;
+        }
+    }
+    g_speed_last = now;
+    return g_speed;
+}
+
+/* Consumer: account one period's fill */
+static void record_fill(uint32_t fill) {
+    uint32_t bucket = fill / g_bucket_frames;
+    if (bucket >= YAGE_AUDIO_FILL_BUCKETS) bucket = YAGE_AUDIO_FILL_BUCKETS - 1;
+    if (g_cur_periods == 0 || fill < g_cur_min) g_cur_min = fill;
+    if (g_cur_periods == 0 || fill > g_cur_max) g_cur_max = fill;
+    g_hist_cur[bucket]++;
+    g_cur_periods++;
+
+    if (g_cur_periods >= g_window_periods) {
+        /* Window complete: it becomes the previous one */
+        memcpy(g_hist_prev, g_hist_cur, sizeof(g_hist_prev));
+        memset(g_hist_cur, 0, sizeof(g_hist_cur));
+        g_prev_periods = g_cur_periods;
+        g_prev_min = g_cur_min;
+        g_prev_max = g_cur_max;
+        g_cur_periods = 0;
+        for (int b = 0; b < YAGE_AUDIO_FILL_BUCKETS; b++)
+            atomic_store_explicit(&g_fill_hist[b], g_hist_prev[b], memory_order_relaxed);
+    } else {
+        atomic_store_explicit(&g_fill_hist[bucket], g_hist_prev[bucket] + g_hist_cur[bucket],
+                              memory_order_relaxed);
+    }
+
+    uint32_t lo = g_cur_min, hi = g_cur_max;
+    if (g_cur_periods == 0 || (g_prev_periods > 0 && g_prev_min < lo)) lo = g_prev_min;
+    if (g_cur_periods == 0 || (g_prev_periods > 0 && g_prev_max > hi)) hi = g_prev_max;
+    atomic_store_explicit(&g_fill_min, lo, memory_order_relaxed);
+    atomic_store_explicit(&g_fill_max, hi, memory_order_relaxed);
+    atomic_store_explicit(&g_fill_periods, g_prev_periods + g_cur_periods, memory_order_relaxed);
+    atomic_store_explicit(&g_fill_now, fill, memory_order_relaxed);
+}
+
+static void telemetry_reset(void) {
+    memset(g_hist_cur, 0, sizeof(g_hist_cur));
+    memset(g_hist_prev, 0, sizeof(g_hist_prev));
+    g_cur_periods = g_prev_periods = 0;
+    for (int b = 0; b < YAGE_AUDIO_FILL_BUCKETS; b++) atomic_store(&g_fill_hist[b], 0);
+    atomic_store(&g_fill_now, 0);
+    atomic_store(&g_fill_min, 0);
+    atomic_store(&g_fill_max, 0);
+    atomic_store(&g_fill_periods, 0);
+    atomic_store(&g_ratio_ppm, 0);
+    atomic_store(&g_speed_ppm, 1000000);
+    atomic_store(&g_pipe_frames, 0);
+}
+
+static void ring_reset(void) {
+    yage_ring_reset(g_ring);
+    atomic_store(&g_skip, 0);
+    g_started = 0;
+    g_starved = 0;
+    g_fade = 0;
+    g_last_l = 0;
+    g_last_r = 0;
+    telemetry_reset();
+}
+
+void yage_audio_push(const int16_t* samples, size_t frames, double source_rate, double speed) {
+    atomic_fetch_add(&g_pushing, 1);
+    if (!atomic_load(&g_active) || !samples || frames == 0) goto done;
+
+    double tempo = effective_speed(frames, source_rate, speed);
+    int ff = -1;
+    if (tempo > 1.0) {
+        ff = atomic_load_explicit(&g_ff_mode, memory_order_relaxed);
+        if (ff != YAGE_AUDIO_FF_STRETCH && ff != YAGE_AUDIO_FF_DECIMATE)
+            ff = tempo <= AUDIO_STRETCH_MAX_SPEED ? YAGE_AUDIO_FF_STRETCH : YAGE_AUDIO_FF_DECIMATE;
+    }
+
+    /* Decimating plays the input back `tempo` times faster */
+    double in_rate = ff == YAGE_AUDIO_FF_DECIMATE ? source_rate * tempo : source_rate;
+    if (!g_rs || fabs(in_rate - g_rs_rate) > g_rs_rate * AUDIO_RATE_TOLERANCE) {
+        if (!g_rs) g_rs = yage_resampler_create(in_rate, g_device_rate);
+        else if (yage_resampler_set_rates(g_rs, in_rate, g_device_rate) != 0) goto done;
+        if (!g_rs) goto done;
+        g_rs_rate = in_rate;
+    }
+
+    size_t available = yage_ring_available(g_ring);
+    size_t target = (size_t)g_target_frames;
+
+    /* Dynamic rate control: steer the fill toward the target */
+    yage_resampler_set_adjust(g_rs, yage_resampler_drc(available, target,
+                                                       YAGE_RESAMPLER_MAX_ADJUST));
+
+    if (reserve_frames(&g_rs_out, &g_rs_out_frames, yage_resampler_max_output(g_rs, frames)) != 0)
+        goto done;
+    size_t out_frames = yage_resampler_process(g_rs, samples, frames, g_rs_out, g_rs_out_frames);
+    const int16_t* out = g_rs_out;
+
+    if (ff == YAGE_AUDIO_FF_STRETCH) {
+        if (!g_st) g_st = yage_stretch_create(g_device_rate);
+        if (g_st && reserve_frames(&g_st_out, &g_st_out_frames,
+                                   yage_stretch_max_output(g_st, out_frames)) == 0) {
+            out_frames = yage_stretch_process(g_st, g_rs_out, out_frames, tempo,
+                                              g_st_out, g_st_out_frames);
+            out = g_st_out;
+            g_stretching = 1;
+        }
+    } else if (g_stretching) {
+        /* Back from stretching: fade its last overlap into the new stream */
+        yage_stretch_finish(g_st, g_rs_out, out_frames);
+        g_stretching = 0;
+    }
+
+    double ratio = yage_resampler_ratio(g_rs);
+    double delay = yage_resampler_delay(g_rs) * ratio;
+    if (ff == YAGE_AUDIO_FF_STRETCH)
+        delay += g_device_rate * (YAGE_STRETCH_SEQUENCE_MS + YAGE_STRETCH_SEEK_MS) / 1000.0;
+    atomic_store_explicit(&g_ratio_ppm, (unsigned)(ratio * 1e6 + 0.5), memory_order_relaxed);
+    atomic_store_explicit(&g_speed_ppm, (unsigned)(tempo * 1e6 + 0.5), memory_order_relaxed);
+    atomic_store_explicit(&g_pipe_frames, (unsigned)delay, memory_order_relaxed);
+
+    /* Far ahead of the device anyway (e.g. after a stall): have the
+     * consumer skip back to the target fill.  Counted once per episode. */
+    if (available > target * 2) {
+        if (atomic_exchange(&g_skip, (int)(available - target)) == 0)
+            atomic_fetch_add_explicit(&g_overflows, 1, memory_order_relaxed);
+    }
+
+    /* The ring only fills up when the consumer has stalled: drop the new
+     * frames rather than touch the read index */
+    if (yage_ring_write(g_ring, out, out_frames) < out_frames)
+        atomic_fetch_add_explicit(&g_overflows, 1, memory_order_relaxed);
+
+done:
+    atomic_fetch_sub(&g_pushing, 1);
+}
+
+void yage_audio_render(int16_t* out, size_t frames) {
+    int skip = atomic_exchange(&g_skip, 0);
+    if (skip > 0) yage_ring_skip(g_ring, (size_t)skip);
+
+    /* (Re)start at the target fill: the core delivers a whole video
+     * frame's worth at a time, far more than one period */
+    if (!g_started) {
+        size_t available = yage_ring_available(g_ring);
+        if (available < (size_t)g_target_frames) {
+            memset(out, 0, frames * 2 * sizeof(int16_t));
+            record_fill((uint32_t)available);
+            return;
+        }
+        g_started = 1;
+    }
+
+    size_t got = yage_ring_read(g_ring, out, frames);
+    record_fill((uint32_t)yage_ring_available(g_ring));
+    if (got > 0) {
+        g_last_l = out[got * 2 - 2];
+        g_last_r = out[got * 2 - 1];
+        g_starved = 0;
+        g_fade = 0;
+    }
+    if (got == frames) return;
+
+    /* Underrun - fade to silence, then pre-buffer again rather than play
+     * scraps */
+    if (!g_starved) {
+        g_starved = 1;
+        atomic_fetch_add_explicit(&g_underruns, 1, memory_order_relaxed);
+    }
+    for (size_t i = got; i < frames; i++) {
+        if (++g_fade < 64) {
+            g_last_l = (int16_t)((g_last_l * 15) >> 4);
+            g_last_r = (int16_t)((g_last_r * 15) >> 4);
+        } else {
+            g_last_l = 0;
+            g_last_r = 0;
+        }
+        out[i * 2] = g_last_l;
+        out[i * 2 + 1] = g_last_r;
+    }
+    g_started = 0;
+}
+
+void yage_audio_stats(uint32_t* underruns, uint32_t* overflows, int32_t* buffered_frames) {
+    if (underruns) *underruns = atomic_load_explicit(&g_underruns, memory_order_relaxed);
+    if (overflows) *overflows = atomic_load_explicit(&g_overflows, memory_order_relaxed);
+    if (buffered_frames) {
+        *buffered_frames = atomic_load(&g_backend) >= 0 ? (int32_t)yage_ring_available(g_ring) : 0;
+    }
+}
+
+void yage_audio_set_device_frames(int frames) {
+    atomic_store(&g_device_frames, frames > 0 ? frames : 0);
+}
+
+void yage_audio_telemetry(YageAudioStats* out) {
+    if (!out) return;
+    int backend = atomic_load(&g_backend);
+    out->backend = backend;
+    out->underruns = atomic_load_explicit(&g_underruns, memory_order_relaxed);
+    out->overflows = atomic_load_explicit(&g_overflows, memory_order_relaxed);
+    if (backend < 0) {
+        out->device_rate = 0;
+        out->resample_ratio = 0;
+        out->speed = 1.0;
+        out->fill_ms = out->fill_min_ms = out->fill_max_ms = 0;
+        out->target_ms = out->latency_ms = out->window_s = 0;
+        memset(out->fill_histogram, 0, sizeof(out->fill_histogram));
+        return;
+    }
+
+    /* Fixed while the output is open */
+    const double ms = 1000.0 / g_device_rate;
+    uint32_t fill = atomic_load_explicit(&g_fill_now, memory_order_relaxed);
+    out->device_rate = g_device_rate;
+    out->resample_ratio = atomic_load_explicit(&g_ratio_ppm, memory_order_relaxed) / 1e6;
+    out->speed = atomic_load_explicit(&g_speed_ppm, memory_order_relaxed) / 1e6;
+    out->fill_ms = (float)(fill * ms);
+    out->fill_min_ms = (float)(atomic_load_explicit(&g_fill_min, memory_order_relaxed) * ms);
+    out->fill_max_ms = (float)(atomic_load_explicit(&g_fill_max, memory_order_relaxed) * ms);
+    out->target_ms = (float)(g_target_frames * ms);
+    out->latency_ms = (float)((fill + (uint32_t)atomic_load(&g_device_frames) +
+                               atomic_load_explicit(&g_pipe_frames, memory_order_relaxed)) * ms);
+    out->window_s = (float)(atomic_load_explicit(&g_fill_periods, memory_order_relaxed) *
+                            (double)g_period_frames / g_device_rate);
+    for (int b = 0; b < YAGE_AUDIO_FILL_BUCKETS; b++)
+        out->fill_histogram[b] = atomic_load_explicit(&g_fill_hist[b], memory_order_relaxed);
+}
+
+int yage_audio_backend(void) {
+    return atomic_load(&g_backend);
+}
+
+void yage_audio_set_fast_forward(int mode) {
+    atomic_store(&g_ff_mode, mode);
+}
+
+/* ── Device backends (engine thread) ──────────────────────────────────── */
+
+#ifndef __ANDROID__
+#include <dlfcn.h>
+#include <pthread.h>
+
+typedef struct {
+    /* Open the device; returns an opaque handle or NULL */
+    void* (*open)(const char* target, unsigned rate, unsigned period_frames);
+    /* Play one period, blocking until the device has taken it (that is
+     * what paces the engine thread); returns 0 or -1 */
+    int   (*write)(void* handle, const int16_t* samples, unsigned frames);
+    void  (*close)(void* handle);
+    /* Periods the device buffers beyond the one being written */
+    int   periods;
+} audio_sink_ops;
+
+/* Sleep until the next period is due; shared by the clock-paced sinks */
+typedef struct {
+    struct timespec due;
+    long            period_ns;
+} sink_clock;
+
+static void clock_init(sink_clock* c, unsigned rate, unsigned period_frames) {
+    clock_gettime(CLOCK_MONOTONIC, &c->due);
+    c->period_ns = (long)((double)period_frames * 1e9 / rate);
+}
+
+static void clock_wait(sink_clock* c) {
+    c->due.tv_nsec += c->period_ns;
+    while (c->due.tv_nsec >= 1000000000L) {
+        c->due.tv_nsec -= 1000000000L;
+        c->due.tv_sec++;
+    }
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    long long ahead = (long long)(c->due.tv_sec - now.tv_sec) * 1000000000LL +
+                      (c->due.tv_nsec - now.tv_nsec);
+    if (ahead > 0) {
+        struct timespec ts = { (time_t)(ahead / 1000000000LL), (long)(ahead % 1000000000LL) };
+        nanosleep(&ts, NULL);
+    } else if (ahead < -4LL * c->period_ns) {
+        c->due = now;   /* fell far behind (suspended): don't burst to catch up */
+    }
+}
+
+/* NULL — a clock-paced device that plays into the void */
+
+static void* null_open(const char* target, unsigned rate, unsigned period_frames) {
+    (void)target;
+    sink_clock* c = (sink_clock*)malloc(sizeof(sink_clock));
+    if (c) clock_init(c, rate, period_frames);
+    return c;
+}
+
+static int null_write(void* handle, const int16_t* samples, unsigned frames) {
+    (void)samples; (void)frames;
+    clock_wait((sink_clock*)handle);
+    return 0;
+}
+
+static void null_close(void* handle) {
+    free(handle);
+}
+
+/* WAV — what a device would have played, paced by the clock */
+
+typedef struct {
+    sink_clock clock;
+    FILE*      file;
+    unsigned   rate;
+    uint32_t   data_bytes;
+} wav_sink;
+
+static void* wav_open(const char* target, unsigned rate, unsigned period_frames) {
+    if (!target || !target[0]) return NULL;
+    wav_sink* w = (wav_sink*)calloc(1, sizeof(wav_sink));
+    if (!w) return NULL;
+    w->file = fopen(target, "wb");
+    if (!w->file) {
+        free(w);
+        return NULL;
+    }
+    uint8_t header[YAGE_RECORD_WAV_HEADER];
+    yage_record_wav_header(header, rate, 0);
+    fwrite(header, 1, sizeof(header), w->file);
+    w->rate = rate;
+    clock_init(&w->clock, rate, period_frames);
+    return w;
+}
+
+static int wav_write(void* handle, const int16_t* samples, unsigned frames) {
+    wav_sink* w = (wav_sink*)handle;
+    size_t bytes = (size_t)frames * 4;
+    /* WAV sizes are 32-bit: stop growing the file near 4 GiB */
+    if (w->data_bytes <= 0xFFFFFFFFu - YAGE_RECORD_WAV_HEADER - bytes) {
+        if (fwrite(samples, 1, bytes, w->file) != bytes) return -1;
+        w->data_bytes += (uint32_t)bytes;
+    }
+    clock_wait(&w->clock);
+    return 0;
+}
+
+static void wav_close(void* handle) {
+    wav_sink* w = (wav_sink*)handle;
+    uint8_t header[YAGE_RECORD_WAV_HEADER];
+    yage_record_wav_header(header, w->rate, w->data_bytes);
+    fseek(w->file, 0, SEEK_SET);
+    fwrite(header, 1, sizeof(header), w->file);
+    fclose(w->file);
+    free(w);
+}
+
+/* ALSA — libasound resolved with dlopen, using its simple-setup API.
+ * Constants are from the stable ABI (pcm.h). */
+
+#define ALSA_PCM_STREAM_PLAYBACK      0
+#define ALSA_PCM_FORMAT_S16_LE        2
+#define ALSA_PCM_ACCESS_RW_INTERLEAVED 3
+
+typedef struct {
+    void* lib;
+    void* pcm;
+    int  (*pcm_open)(void** pcm, const char* name, int stream, int mode);
+    int  (*pcm_set_params)(void* pcm, int format, int access, unsigned channels,
+                           unsigned rate, int soft_resample, unsigned latency_us);
+    long (*pcm_writei)(void* pcm, const void* buffer, unsigned long frames);
+    int  (*pcm_recover)(void* pcm, int err, int silent);
+    int  (*pcm_drain)(void* pcm);
+    int  (*pcm_close)(void* pcm);
+} alsa_sink;
+
+static void* alsa_open(const char* target, unsigned rate, unsigned period_frames) {
+    alsa_sink* a = (alsa_sink*)calloc(1, sizeof(alsa_sink));
+    if (!a) return NULL;
+    a->lib = dlopen("libasound.so.2", RTLD_NOW | RTLD_LOCAL);
+    if (!a->lib) goto fail;
+    *(void**)&a->pcm_open = dlsym(a->lib, "snd_pcm_open");
+    *(void**)&a->pcm_set_params = dlsym(a->lib, "snd_pcm_set_params");
+    *(void**)&a->pcm_writei = dlsym(a->lib, "snd_pcm_writei");
+    *(void**)&a->pcm_recover = dlsym(a->lib, "snd_pcm_recover");
+    *(void**)&a->pcm_drain = dlsym(a->lib, "snd_pcm_drain");
+    *(void**)&a->pcm_close = dlsym(a->lib, "snd_pcm_close");
+    if (!a->pcm_open || !a->pcm_set_params || !a->pcm_writei || !a->pcm_recover ||
+        !a->pcm_drain || !a->pcm_close) goto fail;
+
+    if (a->pcm_open(&a->pcm, target && target[0] ? target : "default",
+                    ALSA_PCM_STREAM_PLAYBACK, 0) < 0) {
+        a->pcm = NULL;
+        goto fail;
+    }
+    /* Device buffer of about four periods on top of the engine's ring */
+    unsigned latency_us = (unsigned)((double)period_frames * 4 * 1e6 / rate);
+    if (a->pcm_set_params(a->pcm, ALSA_PCM_FORMAT_S16_LE, ALSA_PCM_ACCESS_RW_INTERLEAVED,
+                          2, rate, 1, latency_us) < 0) goto fail;
+    return a;
+
+fail:
+    if (a->pcm) a->pcm_close(a->pcm);
+    if (a->lib) dlclose(a->lib);
+    free(a);
+    return NULL;
+}
+
+static int alsa_write(void* handle, const int16_t* samples, unsigned frames) {
+    alsa_sink* a = (alsa_sink*)handle;
+    while (frames > 0) {
+        long n = a->pcm_writei(a->pcm, samples, frames);
+        if (n < 0) {
+            /* xrun or suspend: recover and retry, give up on anything else */
+            if (a->pcm_recover(a->pcm, (int)n, 1) < 0) return -1;
+            continue;
+        }
+        samples += (size_t)n * 2;
+        frames -= (unsigned)n;
+    }
+    return 0;
+}
+
+static void alsa_close(void* handle) {
+    alsa_sink* a = (alsa_sink*)handle;
+    a->pcm_drain(a->pcm);
+    a->pcm_close(a->pcm);
+    dlclose(a->lib);
+    free(a);
+}
+
+static const audio_sink_ops k_null_sink = { null_open, null_write, null_close, 0 };
+static const audio_sink_ops k_wav_sink  = { wav_open, wav_write, wav_close, 0 };
+static const audio_sink_ops k_alsa_sink = { alsa_open, alsa_write, alsa_close, 4 };
+
+static const audio_sink_ops* g_sink = NULL;
+static void*      g_sink_handle = NULL;
+static int16_t*   g_sink_buffer = NULL;
+static pthread_t  g_sink_thread;
+static atomic_int g_sink_running = 0;
+
+static void* sink_thread(void* arg) {
+    (void)arg;
+    while (atomic_load_explicit(&g_sink_running, memory_order_acquire)) {
+        yage_audio_render(g_sink_buffer, (size_t)g_period_frames);
+        if (g_sink->write(g_sink_handle, g_sink_buffer, (unsigned)g_period_frames) != 0) {
+            /* Device gone: keep the engine alive and paced, but silent */
+            struct timespec ts = { 0, (long)((double)g_period_frames * 1e9 / g_device_rate) };
+            nanosleep(&ts, NULL);
+        }
+    }
+    return NULL;
+}
+
+static int sink_open(int backend, const char* target) {
+    const audio_sink_ops* ops = backend == YAGE_AUDIO_BACKEND_ALSA ? &k_alsa_sink :
+                                backend == YAGE_AUDIO_BACKEND_NULL ? &k_null_sink :
+                                backend == YAGE_AUDIO_BACKEND_WAV  ? &k_wav_sink  : NULL;
+    if (!ops) return -1;
+    g_sink_buffer = (int16_t*)calloc((size_t)g_period_frames * 2, sizeof(int16_t));
+    if (!g_sink_buffer) return -1;
+    g_sink_handle = ops->open(target, (unsigned)g_device_rate, (unsigned)g_period_frames);
+    if (!g_sink_handle) {
+        free(g_sink_buffer);
+        g_sink_buffer = NULL;
+        return -1;
+    }
+    g_sink = ops;
+    atomic_store(&g_device_frames, (ops->periods + 1) * g_period_frames);
+    atomic_store(&g_sink_running, 1);
+    if (pthread_create(&g_sink_thread, NULL, sink_thread, NULL) != 0) {
+        atomic_store(&g_sink_running, 0);
+        ops->close(g_sink_handle);
+        g_sink_handle = NULL;
+        free(g_sink_buffer);
+        g_sink_buffer = NULL;
+        return -1;
+    }
+    return 0;
+}
+
+static void sink_close(void) {
+    if (!g_sink_handle) return;
+    atomic_store(&g_sink_running, 0);
+    pthread_join(g_sink_thread, NULL);
+    g_sink->close(g_sink_handle);
+    g_sink_handle = NULL;
+    g_sink = NULL;
+    free(g_sink_buffer);
+    g_sink_buffer = NULL;
+}
+
+#else /* __ANDROID__ — the device is always driven from outside */
+
+static int sink_open(int backend, const char* target) {
+    (void)backend; (void)target;
+    return -1;
+}
+static void sink_close(void) {}
+
+#endif
+
+/* ── Lifecycle ────────────────────────────────────────────────────────── */
+
+int yage_audio_open(int backend, const char* target, double device_rate, int period_frames) {
+    if (atomic_load(&g_backend) >= 0) return -1;
+    if (device_rate < 8000.0 || device_rate > 192000.0) return -1;
+    if (period_frames < 32 || period_frames * AUDIO_TARGET_PERIODS * 2 >= AUDIO_RING_FRAMES)
+        return -1;
+    if (!g_ring) g_ring = yage_ring_create(AUDIO_RING_FRAMES);
+    if (!g_ring) return -1;
+
+    g_device_rate = device_rate;
+    g_period_frames = period_frames;
+    g_target_frames = period_frames * AUDIO_TARGET_PERIODS;
+    g_bucket_frames = (uint32_t)(device_rate * YAGE_AUDIO_FILL_BUCKET_MS / 1000.0);
+    g_window_periods = (uint32_t)(device_rate * AUDIO_TELEMETRY_WINDOW / period_frames);
+    atomic_store(&g_device_frames, period_frames);
+    g_rs_rate = 0;   /* next push rebuilds the resampler for this device rate */
+    g_stretching = 0;
+    g_speed_requested = g_speed = 1.0;
+    ring_reset();
+    atomic_store(&g_underruns, 0);
+    atomic_store(&g_overflows, 0);
+
+    if (backend != YAGE_AUDIO_BACKEND_EXTERNAL) {
+        if (backend == YAGE_AUDIO_BACKEND_AUTO) {
+            backend = YAGE_AUDIO_BACKEND_ALSA;
+            if (sink_open(backend, target) != 0) {
+                backend = YAGE_AUDIO_BACKEND_NULL;
+                if (sink_open(backend, NULL) != 0) return -1;
+            }
+        } else if (sink_open(backend, target) != 0) {
+            return -1;
+        }
+    }
+
+    atomic_store(&g_backend, backend);
+    atomic_store(&g_active, 1);
+    return 0;
+}
+
+void yage_audio_close(void) {
+    if (atomic_load(&g_backend) < 0) return;
+
+    /* No new pushes; wait out one in flight before the resampler goes */
+    atomic_store(&g_active, 0);
+    while (atomic_load(&g_pushing) > 0) {
+        struct timespec ts = { 0, 100000 };
+        nanosleep(&ts, NULL);
+    }
+    sink_close();
+
+    yage_resampler_destroy(g_rs);
+    g_rs = NULL;
+    g_rs_rate = 0;
+    free(g_rs_out);
+    g_rs_out = NULL;
+    g_rs_out_frames = 0;
+    yage_stretch_destroy(g_st);
+    g_st = NULL;
+    free(g_st_out);
+    g_st_out = NULL;
+    g_st_out_frames = 0;
+    ring_reset();
+    atomic_store(&g_backend, -1);
+}
+
+#else /* _WIN32 — no audio output */
+
+int yage_audio_open(int backend, const char* target, double device_rate, int period_frames) {
+    (void)backend; (void)target; (void)device_rate; (void)period_frames;
+    return -1;
+}
+void yage_audio_close(void) {}
+int  yage_audio_backend(void) { return -1; }
+void yage_audio_push(const int16_t* samples, size_t frames, double source_rate, double speed) {
+    (void)samples; (void)frames; (void)source_rate; (void)speed;
+}
+void yage_audio_set_fast_forward(int mode) {
+    (void)mode;
+}
+void yage_audio_render(int16_t* out, size_t frames) {
+    (void)out; (void)frames;
+}
+void yage_audio_stats(uint32_t* underruns, uint32_t* overflows, int32_t* buffered_frames) {
+    if (underruns) *underruns = 0;
+    if (overflows) *overflows = 0;
+    if (buffered_frames) *buffered_frames = 0;
+}
+void yage_audio_set_device_frames(int frames) {
+    (void)frames;
+}
+void yage_audio_telemetry(YageAudioStats* out) {
+    if (!out) return;
+    out->backend = -1;
+    out->underruns = out->overflows = 0;
+    out->device_rate = out->resample_ratio = 0;
+    out->speed = 1.0;
+    out->fill_ms = out->fill_min_ms = out->fill_max_ms = 0;
+    out->target_ms = out->latency_ms = out->window_s = 0;
+    memset(out->fill_histogram, 0, sizeof(out->fill_histogram));
+}
+
+#endif
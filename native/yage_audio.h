@@ -0,0 +1,100 @@
+/*
+ * YAGE Audio Engine
+ *
+ * Backend-neutral audio output: everything between the core's sample
+ * batches and a device that wants fixed-size periods at a fixed rate.
+ *
+ *   producer (thread running retro_run)    yage_audio_push
+ *       resample to the device rate (yage_resampler), dynamic rate
+ *       control toward the target fill, squeeze fast-forward back to
+ *       real time, write into the ring
+ *   consumer (device callback / engine thread)    yage_audio_render
+ *       wait until the target fill is buffered, copy out one period,
+ *       fade to silence on underrun and pre-buffer again afterwards
+ *
+ * The ring is single-producer / single-consumer and each side only moves
+ * its own index.  Should the producer still run far ahead it asks the
+ * consumer to skip back to the target fill instead of moving the read
+ * index itself.
+ *
+ * Fast-forward: the producer is told the emulation speed with every push.
+ * Above 1× the audio is either time-stretched after resampling
+ * (yage_stretch, pitch preserved) or decimated by resampling from speed ×
+ * the source rate (pitch rises), so the device keeps receiving one second
+ * of audio per second.  When the host cannot keep up with the requested
+ * speed, the speed actually achieved is used instead.
+ *
+ * Backends (YAGE_AUDIO_BACKEND_* in yage_libretro.h):
+ *   EXTERNAL  the caller owns the device and pulls with yage_audio_render
+ *             from its own callback (OpenSL ES on Android)
+ *   ALSA      libasound, loaded at run time — no build dependency
+ *   NULL      discards samples, paced by the clock like a real device
+ *   WAV       writes what a device would have played to a 16-bit stereo
+ *             WAV file, paced by the clock
+ * ALSA, NULL and WAV are fed by an engine thread, one period at a time.
+ * NULL and WAV make latency and underrun behaviour observable without a
+ * sound card.
+ *
+ * Internal to yage_core — the FFI surface is yage_audio_output_* in
+ * yage_libretro.h.  Device backends are Linux / macOS only (ALSA: Linux);
+ * on Windows opening always fails.
+ */
+
+#ifndef YAGE_AUDIO_H
+#define YAGE_AUDIO_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Open the engine at `device_rate` Hz with `period_frames` stereo frames
+ * per device period; the ring fill is steered toward six periods.
+ * `target` is the ALSA device name (NULL = "default") or the WAV path.
+ * Returns 0 on success, -1 if already open, the backend is unavailable or
+ * on failure. */
+int yage_audio_open(int backend, const char* target, double device_rate, int period_frames);
+
+/* Stop the engine thread (if any), close the device and drop buffered
+ * audio.  With YAGE_AUDIO_BACKEND_EXTERNAL the caller must have stopped
+ * its callbacks first. */
+void yage_audio_close(void);
+
+/* Backend in use, or -1 when closed. */
+int yage_audio_backend(void);
+
+/* Queue `frames` interleaved stereo frames produced at `source_rate` Hz
+ * while emulating at `speed` (1.0 = real time).  Producer thread only;
+ * never blocks. */
+void yage_audio_push(const int16_t* samples, size_t frames, double source_rate, double speed);
+
+/* Fast-forward handling, YAGE_AUDIO_FF_* (yage_libretro.h).  Any thread;
+ * kept across open / close. */
+void yage_audio_set_fast_forward(int mode);
+
+/* Fill `out` with `frames` stereo frames for the device.  Consumer
+ * thread only; never blocks. */
+void yage_audio_render(int16_t* out, size_t frames);
+
+/* Underrun episodes, overflow episodes (producer too far ahead, or the
+ * ring full) and the frames currently buffered.  Underruns and overflows
+ * count since the engine was opened. */
+void yage_audio_stats(uint32_t* underruns, uint32_t* overflows, int32_t* buffered_frames);
+
+/* Frames the device holds beyond the ring, for the latency estimate.
+ * The engine knows its own sinks; YAGE_AUDIO_BACKEND_EXTERNAL callers
+ * report theirs after opening (default: one period). */
+void yage_audio_set_device_frames(int frames);
+
+/* Fill the engine's part of `out` (everything but core_rate and
+ * pull_dropped, which it leaves alone).  Any thread. */
+struct YageAudioStats;
+void yage_audio_telemetry(struct YageAudioStats* out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* YAGE_AUDIO_H */
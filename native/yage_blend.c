@@ -0,0 +1,104 @@
+/*
+ * YAGE LCD Ghosting / Frame Blending — Implementation
+ *
+ * Channels are widened to 16 bits, so (hist - cur) × weight stays within
+ * ±255 × 120.  Rounding toward zero is a signed shift with a +127 bias on
+ * negative products, which is what C's `/ 128` does in the scalar path.
+ */
+
+#include "yage_blend.h"
+
+#include <stddef.h>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define YAGE_BLEND_SSE2 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define YAGE_BLEND_NEON 1
+#endif
+
+static inline uint32_t blend_px(uint32_t c, uint32_t h, int weight) {
+    uint32_t o = 0;
+    for (int s = 0; s < 32; s += 8) {
+        int cc = (int)((c >> s) & 0xFF), hh = (int)((h >> s) & 0xFF);
+        o |= (uint32_t)(cc + (hh - cc) * weight / 128) << s;
+    }
+    return o;
+}
+
+#if defined(YAGE_BLEND_SSE2)
+
+static inline __m128i blend_half(__m128i c16, __m128i h16, __m128i w) {
+    __m128i p = _mm_mullo_epi16(_mm_sub_epi16(h16, c16), w);
+    p = _mm_add_epi16(p, _mm_and_si128(_mm_srai_epi16(p, 15), _mm_set1_epi16(127)));
+    return _mm_add_epi16(c16, _mm_srai_epi16(p, 7));
+}
+
+#elif defined(YAGE_BLEND_NEON)
+
+static inline int16x8_t blend_half(uint8x8_t c8, uint8x8_t h8, int weight) {
+    int16x8_t c16 = vreinterpretq_s16_u16(vmovl_u8(c8));
+    int16x8_t h16 = vreinterpretq_s16_u16(vmovl_u8(h8));
+    int16x8_t p = vmulq_n_s16(vsubq_s16(h16, c16), (int16_t)weight);
+    p = vaddq_s16(p, vandq_s16(vshrq_n_s16(p, 15), vdupq_n_s16(127)));
+    return vaddq_s16(c16, vshrq_n_s16(p, 7));
+}
+
+#endif
+
+int yage_blend_row(uint32_t* out, uint32_t* hist, const uint32_t* cur, int width,
+                   int weight, int decay) {
+    uint32_t changed = 0, unsettled = 0;
+    int x = 0;
+    if (weight < 0) weight = 0;
+    if (weight > YAGE_BLEND_MAX_WEIGHT) weight = YAGE_BLEND_MAX_WEIGHT;
+
+#if defined(YAGE_BLEND_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i w = _mm_set1_epi16((short)weight);
+    __m128i acc_changed = zero, acc_unsettled = zero;
+    for (; x + 4 <= width; x += 4) {
+        __m128i c = _mm_loadu_si128((const __m128i*)(cur + x));
+        __m128i h = _mm_loadu_si128((const __m128i*)(hist + x));
+        __m128i prev = _mm_loadu_si128((const __m128i*)(out + x));
+        __m128i lo = blend_half(_mm_unpacklo_epi8(c, zero), _mm_unpacklo_epi8(h, zero), w);
+        __m128i hi = blend_half(_mm_unpackhi_epi8(c, zero), _mm_unpackhi_epi8(h, zero), w);
+        __m128i o = _mm_packus_epi16(lo, hi);
+        acc_changed = _mm_or_si128(acc_changed, _mm_xor_si128(o, prev));
+        acc_unsettled = _mm_or_si128(acc_unsettled, _mm_xor_si128(o, c));
+        _mm_storeu_si128((__m128i*)(out + x), o);
+        _mm_storeu_si128((__m128i*)(hist + x), decay ? o : c);
+    }
+    changed = _mm_movemask_epi8(_mm_cmpeq_epi8(acc_changed, zero)) != 0xFFFF;
+    unsettled = _mm_movemask_epi8(_mm_cmpeq_epi8(acc_unsettled, zero)) != 0xFFFF;
+#elif defined(YAGE_BLEND_NEON)
+    uint8x16_t acc_changed = vdupq_n_u8(0), acc_unsettled = vdupq_n_u8(0);
+    for (; x + 4 <= width; x += 4) {
+        uint8x16_t c = vld1q_u8((const uint8_t*)(cur + x));
+        uint8x16_t h = vld1q_u8((const uint8_t*)(hist + x));
+        uint8x16_t prev = vld1q_u8((const uint8_t*)(out + x));
+        int16x8_t lo = blend_half(vget_low_u8(c), vget_low_u8(h), weight);
+        int16x8_t hi = blend_half(vget_high_u8(c), vget_high_u8(h), weight);
+        uint8x16_t o = vcombine_u8(vqmovun_s16(lo), vqmovun_s16(hi));
+        acc_changed = vorrq_u8(acc_changed, veorq_u8(o, prev));
+        acc_unsettled = vorrq_u8(acc_unsettled, veorq_u8(o, c));
+        vst1q_u8((uint8_t*)(out + x), o);
+        vst1q_u8((uint8_t*)(hist + x), decay ? o : c);
+    }
+    uint64x2_t ac = vreinterpretq_u64_u8(acc_changed);
+    uint64x2_t au = vreinterpretq_u64_u8(acc_unsettled);
+    changed = (vgetq_lane_u64(ac, 0) | vgetq_lane_u64(ac, 1)) != 0;
+    unsettled = (vgetq_lane_u64(au, 0) | vgetq_lane_u64(au, 1)) != 0;
+#endif
+
+    for (; x < width; x++) {
+        uint32_t c = cur[x];
+        uint32_t o = blend_px(c, hist[x], weight);
+        changed |= o ^ out[x];
+        unsettled |= o ^ c;
+        out[x] = o;
+        hist[x] = decay ? o : c;
+    }
+    return (changed ? YAGE_BLEND_CHANGED : 0) | (unsettled ? YAGE_BLEND_UNSETTLED : 0);
+}
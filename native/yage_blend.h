@@ -0,0 +1,47 @@
+/*
+ * YAGE LCD Ghosting / Frame Blending
+ *
+ * Mixes each presented 32-bit frame with a history frame to imitate the
+ * slow pixel response of the GB / GBA LCDs (games rely on it for 30 Hz
+ * flicker transparency):
+ *
+ *   MIX    history = the previous presented frame — classic 2-frame blend
+ *   DECAY  history = the previous *output* — exponential persistence, a
+ *          changed pixel fades toward its new value over several frames
+ *
+ * Per channel: out = cur + (hist - cur) × weight / 128, rounded toward
+ * `cur` so a decaying pixel always settles exactly.  Channel order does
+ * not matter (RGBA8888 or BGRA8888).  Rows are processed 4 pixels at a
+ * time with SSE2 or NEON; all variants are bit-exact with the scalar one.
+ *
+ * Internal to yage_core — not part of the FFI surface.
+ */
+
+#ifndef YAGE_BLEND_H
+#define YAGE_BLEND_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Largest history weight (in 1/128ths) — keeps DECAY converging quickly */
+#define YAGE_BLEND_MAX_WEIGHT 120
+
+/* yage_blend_row result flags */
+#define YAGE_BLEND_CHANGED   0x1   /* `out` differs from what it held before */
+#define YAGE_BLEND_UNSETTLED 0x2   /* `out` differs from `cur` — blend again next frame */
+
+/* Blend `width` pixels of `cur` with `hist` into `out`, then advance the
+ * history (hist = cur for MIX, hist = out for DECAY).  `weight` is the
+ * history share in 1/128ths, 0..YAGE_BLEND_MAX_WEIGHT.  Returns
+ * YAGE_BLEND_* flags for the row. */
+int yage_blend_row(uint32_t* out, uint32_t* hist, const uint32_t* cur, int width,
+                   int weight, int decay);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* YAGE_BLEND_H */
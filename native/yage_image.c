@@ -0,0 +1,417 @@
+/*
+ * YAGE Image Encoding — Implementation
+ *
+ * PNG: 8-bit RGB (frames are opaque), per-row filter picked by the usual
+ * minimum-sum-of-absolute-differences heuristic, one fixed-Huffman
+ * deflate block with a hash-chain LZ77 matcher.  QOI follows the
+ * reference specification (qoiformat.org) exactly.
+ */
+
+#include "yage_image.h"
+#include "yage_libretro.h"  /* YAGE_OUTPUT_* */
+
+#include <stdlib.h>
+#include <string.h>
+
+/* ── Pixel preparation ────────────────────────────────────────────────── */
+
+void yage_image_to_rgba(const void* src, int width, int height, int format, uint8_t* dst) {
+    size_t count = (size_t)width * height;
+    if (format == YAGE_OUTPUT_RGB565) {
+        const uint16_t* s = (const uint16_t*)src;
+        for (size_t i = 0; i < count; i++) {
+            uint32_t r = (s[i] >> 11) & 0x1F, g = (s[i] >> 5) & 0x3F, b = s[i] & 0x1F;
+            dst[i * 4 + 0] = (uint8_t)((r << 3) | (r >> 2));
+            dst[i * 4 + 1] = (uint8_t)((g << 2) | (g >> 4));
+            dst[i * 4 + 2] = (uint8_t)((b << 3) | (b >> 2));
+            dst[i * 4 + 3] = 0xFF;
+        }
+        return;
+    }
+    const uint8_t* s = (const uint8_t*)src;
+    int swap = format == YAGE_OUTPUT_BGRA8888;
+    for (size_t i = 0; i < count; i++) {
+        dst[i * 4 + 0] = s[i * 4 + (swap ? 2 : 0)];
+        dst[i * 4 + 1] = s[i * 4 + 1];
+        dst[i * 4 + 2] = s[i * 4 + (swap ? 0 : 2)];
+        dst[i * 4 + 3] = 0xFF;
+    }
+}
+
+void yage_image_downscale(uint8_t* rgba, int width, int height, int max_width, int max_height,
+                          int* out_width, int* out_height) {
+    int f = 1;
+    if (max_width > 0 && width > max_width) f = (width + max_width - 1) / max_width;
+    if (max_height > 0 && height > max_height) {
+        int fh = (height + max_height - 1) / max_height;
+        if (fh > f) f = fh;
+    }
+    int ow = width / f, oh = height / f;
+    if (ow < 1) ow = 1;
+    if (oh < 1) oh = 1;
+
+    /* Output pixel i is written only after every input pixel before its
+     * block has been read, so shrinking in place is safe */
+    if (f > 1) {
+        uint32_t area = (uint32_t)(f * f);
+        for (int oy = 0; oy < oh; oy++) {
+            for (int ox = 0; ox < ow; ox++) {
+                uint32_t sum[4] = { 0, 0, 0, 0 };
+                for (int y = oy * f; y < oy * f + f; y++) {
+                    const uint8_t* p = rgba + ((size_t)y * width + (size_t)ox * f) * 4;
+                    for (int x = 0; x < f; x++, p += 4) {
+                        sum[0] += p[0]; sum[1] += p[1]; sum[2] += p[2]; sum[3] += p[3];
+                    }
+                }
+                uint8_t* d = rgba + ((size_t)oy * ow + ox) * 4;
+                for (int c = 0; c < 4; c++) d[c] = (uint8_t)((sum[c] + area / 2) / area);
+            }
+        }
+    }
+    if (out_width) *out_width = ow;
+    if (out_height) *out_height = oh;
+}
+
+/* ── Deflate (single fixed-Huffman block) ─────────────────────────────── */
+
+#define DEFL_WINDOW     32768
+#define DEFL_HASH_BITS  15
+#define DEFL_MAX_CHAIN  32
+#define DEFL_MIN_MATCH  3
+#define DEFL_MAX_MATCH  258
+
+static const uint16_t k_len_base[29] = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+    35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+};
+static const uint8_t k_len_extra[29] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+    3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+};
+static const uint16_t k_dist_base[30] = {
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+    257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577
+};
+static const uint8_t k_dist_extra[30] = {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+    7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+};
+
+typedef struct {
+    uint8_t* buf;
+    size_t   len;
+    uint64_t bits;
+    int      nbits;
+} BitWriter;
+
+/* Deflate packs values LSB first */
+static void bw_put(BitWriter* w, uint32_t value, int n) {
+    w->bits |= (uint64_t)value << w->nbits;
+    w->nbits += n;
+    while (w->nbits >= 8) {
+        w->buf[w->len++] = (uint8_t)w->bits;
+        w->bits >>= 8;
+        w->nbits -= 8;
+    }
+}
+
+/* …but Huffman codes MSB first */
+static void bw_put_code(BitWriter* w, uint32_t code, int n) {
+    uint32_t r = 0;
+    for (int i = 0; i < n; i++) r |= ((code >> i) & 1u) << (n - 1 - i);
+    bw_put(w, r, n);
+}
+
+static void put_litlen(BitWriter* w, int sym) {
+    if (sym < 144)      bw_put_code(w, 0x30 + sym, 8);
+    else if (sym < 256) bw_put_code(w, 0x190 + sym - 144, 9);
+    else if (sym < 280) bw_put_code(w, sym - 256, 7);
+    else                bw_put_code(w, 0xC0 + sym - 280, 8);
+}
+
+static void put_match(BitWriter* w, int len, int dist) {
+    int i = 28;
+    while (k_len_base[i] > len) i--;
+    put_litlen(w, 257 + i);
+    if (k_len_extra[i]) bw_put(w, (uint32_t)(len - k_len_base[i]), k_len_extra[i]);
+    int d = 29;
+    while (k_dist_base[d] > dist) d--;
+    bw_put_code(w, (uint32_t)d, 5);
+    if (k_dist_extra[d]) bw_put(w, (uint32_t)(dist - k_dist_base[d]), k_dist_extra[d]);
+}
+
+static uint32_t hash3(const uint8_t* p) {
+    uint32_t v = (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16);
+    return (v * 2654435761u) >> (32 - DEFL_HASH_BITS);
+}
+
+/* Compress `src` as one final fixed-Huffman block into `out` (which must
+ * hold n * 3 / 2 + 64 bytes — a 3-byte match costs at most 31 bits).
+ * Returns the size, or 0 on allocation failure. */
+static size_t deflate_fixed(const uint8_t* src, size_t n, uint8_t* out) {
+    int32_t* head = (int32_t*)malloc(sizeof(int32_t) << DEFL_HASH_BITS);
+    int32_t* prev = (int32_t*)malloc(sizeof(int32_t) * DEFL_WINDOW);
+    if (!head || !prev) {
+        free(head);
+        free(prev);
+        return 0;
+    }
+    memset(head, 0xFF, sizeof(int32_t) << DEFL_HASH_BITS);   /* -1 = empty */
+
+    BitWriter w = { out, 0, 0, 0 };
+    bw_put(&w, 1, 1);   /* BFINAL */
+    bw_put(&w, 1, 2);   /* BTYPE = fixed Huffman */
+
+    size_t i = 0;
+    while (i < n) {
+        int best_len = 0, best_dist = 0;
+        if (i + DEFL_MIN_MATCH <= n) {
+            int max_len = n - i < DEFL_MAX_MATCH ? (int)(n - i) : DEFL_MAX_MATCH;
+            uint32_t h = hash3(src + i);
+            int32_t j = head[h];
+            for (int chain = DEFL_MAX_CHAIN; j >= 0 && i - (size_t)j <= DEFL_WINDOW && chain > 0; chain--) {
+                if (src[j + best_len] == src[i + best_len]) {
+                    int len = 0;
+                    while (len < max_len && src[j + len] == src[i + len]) len++;
+                    if (len > best_len) {
+                        best_len = len;
+                        best_dist = (int)(i - (size_t)j);
+                        if (len == max_len) break;
+                    }
+                }
+                int32_t next = prev[j & (DEFL_WINDOW - 1)];
+                if (next >= j) break;   /* slot reused by a newer position */
+                j = next;
+            }
+            prev[i & (DEFL_WINDOW - 1)] = head[h];
+            head[h] = (int32_t)i;
+        }
+
+        if (best_len >= DEFL_MIN_MATCH) {
+            put_match(&w, best_len, best_dist);
+            for (size_t k = i + 1; k < i + (size_t)best_len && k + DEFL_MIN_MATCH <= n; k++) {
+                uint32_t h = hash3(src + k);
+                prev[k & (DEFL_WINDOW - 1)] = head[h];
+                head[h] = (int32_t)k;
+            }
+            i += (size_t)best_len;
+        } else {
+            put_litlen(&w, src[i]);
+            i++;
+        }
+    }
+    put_litlen(&w, 256);   /* end of block */
+    if (w.nbits > 0) bw_put(&w, 0, 8 - w.nbits);
+
+    free(head);
+    free(prev);
+    return w.len;
+}
+
+/* ── PNG ──────────────────────────────────────────────────────────────── */
+
+static void put_be32(uint8_t* p, uint32_t v) {
+    p[0] = (uint8_t)(v >> 24);
+    p[1] = (uint8_t)(v >> 16);
+    p[2] = (uint8_t)(v >> 8);
+    p[3] = (uint8_t)v;
+}
+
+static uint32_t crc32_update(const uint32_t* table, uint32_t crc, const uint8_t* p, size_t n) {
+    for (size_t i = 0; i < n; i++) crc = table[(crc ^ p[i]) & 0xFF] ^ (crc >> 8);
+    return crc;
+}
+
+/* Fill in length and CRC of the chunk whose type starts at chunk + 4 */
+static size_t finish_chunk(const uint32_t* crc_table, uint8_t* chunk, size_t data_len) {
+    put_be32(chunk, (uint32_t)data_len);
+    uint32_t crc = crc32_update(crc_table, 0xFFFFFFFFu, chunk + 4, data_len + 4) ^ 0xFFFFFFFFu;
+    put_be32(chunk + 8 + data_len, crc);
+    return data_len + 12;
+}
+
+static uint8_t paeth(uint8_t a, uint8_t b, uint8_t c) {
+    int p = a + b - c;
+    int pa = abs(p - a), pb = abs(p - b), pc = abs(p - c);
+    if (pa <= pb && pa <= pc) return a;
+    return pb <= pc ? b : c;
+}
+
+/* Filter one RGB row with `type` into out (stride bytes) */
+static void filter_row(int type, const uint8_t* row, const uint8_t* up, size_t stride, uint8_t* out) {
+    for (size_t x = 0; x < stride; x++) {
+        uint8_t a = x >= 3 ? row[x - 3] : 0;
+        uint8_t b = up ? up[x] : 0;
+        uint8_t c = (up && x >= 3) ? up[x - 3] : 0;
+        switch (type) {
+        case 0:  out[x] = row[x]; break;
+        case 1:  out[x] = (uint8_t)(row[x] - a); break;
+        case 2:  out[x] = (uint8_t)(row[x] - b); break;
+        case 3:  out[x] = (uint8_t)(row[x] - ((a + b) >> 1)); break;
+        default: out[x] = (uint8_t)(row[x] - paeth(a, b, c)); break;
+        }
+    }
+}
+
+size_t yage_image_encode_png(const uint8_t* rgba, int width, int height, uint8_t** out) {
+    if (!rgba || width <= 0 || height <= 0 || !out) return 0;
+    size_t stride = (size_t)width * 3;
+    size_t raw_len = (stride + 1) * (size_t)height;
+    size_t defl_cap = raw_len * 3 / 2 + 64;
+
+    uint8_t* rgb = (uint8_t*)malloc(stride * 2);            /* current + previous row */
+    uint8_t* trial = (uint8_t*)malloc(stride);
+    uint8_t* raw = (uint8_t*)malloc(raw_len);
+    uint8_t* png = (uint8_t*)malloc(8 + 25 + 12 + 6 + defl_cap + 12);
+    if (!rgb || !trial || !raw || !png) {
+        free(rgb); free(trial); free(raw); free(png);
+        return 0;
+    }
+
+    for (int y = 0; y < height; y++) {
+        uint8_t* cur = rgb + (size_t)(y & 1) * stride;
+        const uint8_t* up = y > 0 ? rgb + (size_t)((y - 1) & 1) * stride : NULL;
+        const uint8_t* src = rgba + (size_t)y * width * 4;
+        for (int x = 0; x < width; x++) memcpy(cur + (size_t)x * 3, src + (size_t)x * 4, 3);
+
+        uint8_t* dst = raw + (size_t)y * (stride + 1);
+        uint32_t best_cost = UINT32_MAX;
+        for (int type = 0; type < 5; type++) {
+            filter_row(type, cur, up, stride, trial);
+            uint32_t cost = 0;
+            for (size_t x = 0; x < stride; x++) cost += (uint32_t)abs((int8_t)trial[x]);
+            if (cost < best_cost) {
+                best_cost = cost;
+                dst[0] = (uint8_t)type;
+                memcpy(dst + 1, trial, stride);
+            }
+        }
+    }
+
+    uint32_t crc_table[256];
+    for (uint32_t n = 0; n < 256; n++) {
+        uint32_t c = n;
+        for (int k = 0; k < 8; k++) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+        crc_table[n] = c;
+    }
+
+    static const uint8_t signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    size_t pos = 0;
+    memcpy(png, signature, 8);
+    pos += 8;
+
+    uint8_t* ihdr = png + pos;
+    memcpy(ihdr + 4, "IHDR", 4);
+    put_be32(ihdr + 8, (uint32_t)width);
+    put_be32(ihdr + 12, (uint32_t)height);
+    ihdr[16] = 8;   /* bit depth */
+    ihdr[17] = 2;   /* colour type: RGB */
+    ihdr[18] = 0;   /* deflate */
+    ihdr[19] = 0;   /* adaptive filtering */
+    ihdr[20] = 0;   /* no interlace */
+    pos += finish_chunk(crc_table, ihdr, 13);
+
+    uint8_t* idat = png + pos;
+    memcpy(idat + 4, "IDAT", 4);
+    uint8_t* z = idat + 8;
+    z[0] = 0x78;   /* zlib: deflate, 32 KiB window */
+    z[1] = 0x01;
+    size_t defl = deflate_fixed(raw, raw_len, z + 2);
+    if (defl == 0) {
+        free(rgb); free(trial); free(raw); free(png);
+        return 0;
+    }
+    uint32_t s1 = 1, s2 = 0;
+    for (size_t i = 0; i < raw_len; i++) {
+        s1 = (s1 + raw[i]) % 65521;
+        s2 = (s2 + s1) % 65521;
+    }
+    put_be32(z + 2 + defl, (s2 << 16) | s1);
+    pos += finish_chunk(crc_table, idat, 2 + defl + 4);
+
+    uint8_t* iend = png + pos;
+    memcpy(iend + 4, "IEND", 4);
+    pos += finish_chunk(crc_table, iend, 0);
+
+    free(rgb);
+    free(trial);
+    free(raw);
+    *out = png;
+    return pos;
+}
+
+/* ── QOI ──────────────────────────────────────────────────────────────── */
+
+#define QOI_OP_INDEX 0x00
+#define QOI_OP_DIFF  0x40
+#define QOI_OP_LUMA  0x80
+#define QOI_OP_RUN   0xC0
+#define QOI_OP_RGB   0xFE
+#define QOI_OP_RGBA  0xFF
+
+size_t yage_image_encode_qoi(const uint8_t* rgba, int width, int height, uint8_t** out) {
+    if (!rgba || width <= 0 || height <= 0 || !out) return 0;
+    size_t count = (size_t)width * height;
+    uint8_t* q = (uint8_t*)malloc(14 + count * 5 + 8);
+    if (!q) return 0;
+
+    memcpy(q, "qoif", 4);
+    put_be32(q + 4, (uint32_t)width);
+    put_be32(q + 8, (uint32_t)height);
+    q[12] = 3;   /* RGB — frames are opaque */
+    q[13] = 0;   /* sRGB with linear alpha */
+    size_t pos = 14;
+
+    uint8_t index[64][4];
+    memset(index, 0, sizeof(index));
+    uint8_t prev[4] = { 0, 0, 0, 255 };
+    int run = 0;
+    for (size_t i = 0; i < count; i++) {
+        const uint8_t* px = rgba + i * 4;
+        if (memcmp(px, prev, 4) == 0) {
+            run++;
+            if (run == 62 || i == count - 1) {
+                q[pos++] = (uint8_t)(QOI_OP_RUN | (run - 1));
+                run = 0;
+            }
+            continue;
+        }
+        if (run > 0) {
+            q[pos++] = (uint8_t)(QOI_OP_RUN | (run - 1));
+            run = 0;
+        }
+        int h = (px[0] * 3 + px[1] * 5 + px[2] * 7 + px[3] * 11) % 64;
+        if (memcmp(index[h], px, 4) == 0) {
+            q[pos++] = (uint8_t)(QOI_OP_INDEX | h);
+        } else {
+            memcpy(index[h], px, 4);
+            if (px[3] == prev[3]) {
+                int vr = (int8_t)(px[0] - prev[0]);
+                int vg = (int8_t)(px[1] - prev[1]);
+                int vb = (int8_t)(px[2] - prev[2]);
+                int vg_r = vr - vg, vg_b = vb - vg;
+                if (vr > -3 && vr < 2 && vg > -3 && vg < 2 && vb > -3 && vb < 2) {
+                    q[pos++] = (uint8_t)(QOI_OP_DIFF | (vr + 2) << 4 | (vg + 2) << 2 | (vb + 2));
+                } else if (vg_r > -9 && vg_r < 8 && vg > -33 && vg < 32 && vg_b > -9 && vg_b < 8) {
+                    q[pos++] = (uint8_t)(QOI_OP_LUMA | (vg + 32));
+                    q[pos++] = (uint8_t)((vg_r + 8) << 4 | (vg_b + 8));
+                } else {
+                    q[pos++] = QOI_OP_RGB;
+                    memcpy(q + pos, px, 3);
+                    pos += 3;
+                }
+            } else {
+                q[pos++] = QOI_OP_RGBA;
+                memcpy(q + pos, px, 4);
+                pos += 4;
+            }
+        }
+        memcpy(prev, px, 4);
+    }
+
+    static const uint8_t padding[8] = { 0, 0, 0, 0, 0, 0, 0, 1 };
+    memcpy(q + pos, padding, 8);
+    pos += 8;
+    *out = q;
+    return pos;
+}
@@ -0,0 +1,42 @@
+/*
+ * YAGE Image Encoding — screenshots and save-state thumbnails
+ *
+ * Self-contained PNG and QOI encoders for 8-bit RGBA images, plus the
+ * pixel-format normalisation and box-filter downscale in front of them.
+ * No zlib: PNG data is compressed with a single fixed-Huffman deflate
+ * block (LZ77, 32 KiB window), which suits emulator frames well.
+ *
+ * Internal to yage_core — the FFI surface is yage_screenshot_* in
+ * yage_libretro.h.
+ */
+
+#ifndef YAGE_IMAGE_H
+#define YAGE_IMAGE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Convert packed YAGE_OUTPUT_* pixels to opaque RGBA8888 (`dst` holds
+ * width × height × 4 bytes). */
+void yage_image_to_rgba(const void* src, int width, int height, int format, uint8_t* dst);
+
+/* Shrink an RGBA image by the smallest integer factor that fits it within
+ * max_width × max_height (0 = unbounded), averaging each block.  Works in
+ * place; returns the new size through `out_width` / `out_height`. */
+void yage_image_downscale(uint8_t* rgba, int width, int height, int max_width, int max_height,
+                          int* out_width, int* out_height);
+
+/* Encode an RGBA image.  On success returns the encoded size and a
+ * malloc'd buffer in `*out` (caller frees); returns 0 on failure. */
+size_t yage_image_encode_png(const uint8_t* rgba, int width, int height, uint8_t** out);
+size_t yage_image_encode_qoi(const uint8_t* rgba, int width, int height, uint8_t** out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* YAGE_IMAGE_H */
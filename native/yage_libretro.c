@@ -5,6 +5,15 @@
  */
 
 #include "yage_libretro.h"
+#include "yage_pixconv.h"
+#include "yage_scaler.h"
+#include "yage_blend.h"
+#include "yage_record.h"
+#include "yage_replay.h"
+#include "yage_image.h"
+#include "yage_shm.h"
+#include "yage_audio.h"
+#include "yage_ring.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
@@ -50,13 +59,49 @@ typedef void* LibHandle;
 /* Forward declaration — implemented in yage_rcheevos.c */
 extern void yage_rc_do_frame(void);
 
-/* Display buffer — snapshot of the last completed video frame.
- * Updated at ~60 Hz by the native frame loop thread. */
-static uint32_t* g_display_buf          = NULL;
-static size_t    g_display_buf_capacity = 0;
-static int       g_display_width        = 0;
-static int       g_display_height       = 0;
-static pthread_mutex_t     g_display_mutex        = PTHREAD_MUTEX_INITIALIZER;
+/* Display slots — triple buffer between the frame loop (writer) and Dart
+ * (reader).  The writer converts straight into its back slot and publishes
+ * it by swapping it into g_display_middle; the reader takes the newest
+ * frame by swapping its front slot with the middle one.  Neither side ever
+ * waits for the other, so a slow UI read cannot stall emulation. */
+#define DISPLAY_SLOT_COUNT  3
+#define DISPLAY_SLOT_FRESH  0x4   /* set in g_display_middle until the reader takes it */
+
+typedef struct {
+    uint32_t* pixels;
+    size_t    capacity;      /* pixels */
+    int       width;         /* 0 → contents invalid */
+    int       height;
+    uint32_t  serial;        /* g_video_serial the pixels were synced to */
+    uint32_t  generation;    /* publish count when this frame was published */
+    int       format;        /* YAGE_OUTPUT_* of the pixels */
+    int       post;          /* DisplayPost key the pixels were produced with */
+    int       dirty_y;       /* rows changed vs. the previous generation */
+    int       dirty_h;
+} YageDisplaySlot;
+
+static YageDisplaySlot g_display_slots[DISPLAY_SLOT_COUNT];
+static int             g_display_back       = 0;   /* frame loop thread only */
+static int             g_display_back_core  = 0;   /* core rendered its last frame into the back slot */
+static int             g_display_unfolded   = -1;  /* published slot holding the pending frame, not yet folded */
+static atomic_int      g_display_middle     = 1;   /* slot index | DISPLAY_SLOT_FRESH */
+static int             g_display_front      = 2;   /* reader (Dart) thread only */
+static atomic_uint     g_display_generation = 0;   /* frames published so far */
+static atomic_int      g_display_via_slots  = 0;   /* last present went to the slots */
+
+/* Publisher bookkeeping for per-generation dirty rows */
+static uint32_t  g_display_pub_serial   = 0;
+static int       g_display_pub_width    = 0;
+static int       g_display_pub_height   = 0;
+static int       g_display_pub_post     = 0;
+static int       g_display_pub_format   = 0;
+
+/* Dirty rows of the front slot relative to the previously acquired one */
+static int       g_display_read_dirty_y = 0;
+static int       g_display_read_dirty_h = 0;
+
+static YageDisplaySlot* acquire_display_slot(void);
+static int publish_display_slot(int w, int h);
 
 /* Thread control (all atomic for cross-thread safety) */
 static pthread_t           g_frame_thread;
@@ -66,14 +111,79 @@ static atomic_int          g_floop_rewind_on     = 0;
 static atomic_int          g_floop_rewind_interval = 5;
 static atomic_int          g_floop_rcheevos_on   = 0;
 static atomic_int          g_floop_fps_x100      = 0;     /* fps × 100 */
+static atomic_int          g_floop_frame_ns      = 16742706;   /* BASE_FRAME_NS until AV info */
+static atomic_int          g_scaler_mode         = YAGE_SCALER_NONE;
+static atomic_int          g_scaler_factor       = 2;     /* YAGE_SCALER_NEAREST only */
+static atomic_int          g_blend_mode          = YAGE_FRAME_BLEND_OFF;
+static atomic_int          g_blend_weight        = 64;    /* history share, 1/128ths */
+static atomic_int          g_floop_skip_dupes    = 0;     /* no callback for duplicate frames */
+static atomic_uint         g_present_count       = 0;     /* new frames shown */
+static atomic_uint         g_present_skipped     = 0;     /* duplicate frames skipped */
 static yage_frame_callback_t g_frame_callback    = NULL;
 
+/* Conversion pipeline — optional second stage of the frame loop.  The
+ * loop thread folds the frame to be shown into g_src_shadow, then a worker
+ * converts, post-processes, presents and exports it while the loop already
+ * runs the next retro_run().  g_video_mutex guards the video state both
+ * touch (shadow, g_video_buffer, display slots, native window); the
+ * hand-off is a single job, so at most one frame waits and a newer one
+ * replaces it. */
+static atomic_int          g_floop_pipelined     = 0;     /* requested via the API */
+static int                 g_pipe_on             = 0;     /* worker running; loop thread writes */
+static pthread_t           g_pipe_thread;
+static pthread_mutex_t     g_pipe_mutex          = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t      g_pipe_cond           = PTHREAD_COND_INITIALIZER;
+static int                 g_pipe_job            = 0;     /* under g_pipe_mutex */
+static int                 g_pipe_job_width      = 0;
+static int                 g_pipe_job_height     = 0;
+static int                 g_pipe_quit           = 0;
+static atomic_int          g_pipe_result         = 1;     /* last worker present result */
+static atomic_uint         g_pipe_handoffs       = 0;     /* frames handed to the worker */
+static atomic_uint         g_pipe_replaced       = 0;     /* replaced before the worker took them */
+static pthread_mutex_t     g_video_mutex         = PTHREAD_MUTEX_INITIALIZER;
+
 /* ~60 Hz display interval in nanoseconds */
 #define DISPLAY_INTERVAL_NS  16666667LL   /* 1e9 / 60 */
 
-/* Base frame time for GBA (~59.7275 fps) in nanoseconds */
+/* Longest gap between callbacks while duplicates are suppressed */
+#define DUPE_NOTIFY_INTERVAL_NS 500000000LL
+
+/* Base frame time for GBA (~59.7275 fps) in nanoseconds — the pacing
+ * default until the core reports its timing (g_floop_frame_ns) */
 #define BASE_FRAME_NS        16742706LL   /* 1e9 / 59.7275 */
 
+#ifndef __ANDROID__
+/* ── Desktop texture (Linux runner FlPixelBufferTexture) ───────────────
+ * The runner attaches a frame-available notifier; the raster thread then
+ * becomes the display slot reader and is handed the front slot's pixels
+ * in place.  Notifications are sent under g_tex_mutex so detaching
+ * (NULL notifier) guarantees no callback is still running afterwards.
+ * Every acquire - the raster thread's, and Dart's together with its
+ * attached check - runs under g_tex_slot_mutex, which
+ * yage_frame_loop_start takes to reset the slots while the reader is held
+ * off.  Lock order: g_tex_mutex, then g_tex_slot_mutex. */
+static pthread_mutex_t g_tex_mutex  = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t g_tex_slot_mutex = PTHREAD_MUTEX_INITIALIZER;
+static void (*g_tex_notify)(void*) = NULL;
+static void*           g_tex_user   = NULL;
+static atomic_int      g_tex_attached = 0;
+static uint8_t*        g_tex_rgba   = NULL;   /* conversion target for non-RGBA slots */
+static size_t          g_tex_rgba_capacity = 0;
+static atomic_int      g_tex_reserve = 0;      /* pixels to allocate for on first growth */
+
+static inline int desktop_texture_attached(void) {
+    return atomic_load_explicit(&g_tex_attached, memory_order_acquire);
+}
+
+/* Tell the runner a new slot was published */
+static void desktop_texture_notify(void) {
+    if (!desktop_texture_attached()) return;
+    pthread_mutex_lock(&g_tex_mutex);
+    if (g_tex_notify) g_tex_notify(g_tex_user);
+    pthread_mutex_unlock(&g_tex_mutex);
+}
+#endif /* !__ANDROID__ */
+
 #endif /* !_WIN32 */
 
 /* Suppress excessive logging after initial frames */
@@ -139,6 +249,18 @@ struct retro_system_av_info {
     struct retro_system_timing timing;
 };
 
+/* RETRO_ENVIRONMENT_GET_CURRENT_SOFTWARE_FRAMEBUFFER */
+struct retro_framebuffer {
+    void* data;
+    unsigned width;
+    unsigned height;
+    size_t pitch;
+    int format;              /* RETRO_PIXEL_FORMAT_* */
+    unsigned access_flags;
+    unsigned memory_flags;
+};
+#define RETRO_MEMORY_TYPE_CACHED (1 << 0)
+
 /* GBA screen dimensions */
 #define GBA_WIDTH 240
 #define GBA_HEIGHT 160
@@ -184,6 +306,76 @@ static volatile uint32_t g_keys = 0;
 static int g_pixel_format = RETRO_PIXEL_FORMAT_RGB565; /* Default format */
 static int g_color_correction_enabled = 1; /* GBA contrast boost — only for GB family */
 
+/* Active row converter and the lookup data it is handed (GB palette or the
+ * 16-bit LUT).  Owned by whichever thread runs the core: setters on other
+ * threads only raise g_video_conv_dirty, and the next video_refresh_callback
+ * rebuilds — so a LUT is never rewritten while a frame is being converted. */
+static yage_pixconv_row_fn g_convert_row = NULL;
+static const uint32_t* g_convert_table = NULL;
+static uint32_t* g_pixel_lut = NULL;       /* YAGE_PIXCONV_LUT_SIZE entries, lazily allocated */
+
+/* Output layout requested by the host (YAGE_OUTPUT_*), and the layout the
+ * active converter writes.  They differ until the next rebuild, and for
+ * INDEX8 while the GB palette is off (RGBA8888 is written instead).
+ * g_out_format_pub mirrors g_out_format for threads other than the one
+ * converting. */
+static int g_output_format = YAGE_OUTPUT_RGBA8888;
+static int g_out_format    = YAGE_OUTPUT_RGBA8888;
+static int g_out_bpp       = 4;
+#ifndef _WIN32
+static atomic_int g_out_format_pub = YAGE_OUTPUT_RGBA8888;
+#else
+static volatile int g_out_format_pub = YAGE_OUTPUT_RGBA8888;
+#endif
+
+/* Layout of the buffer yage_core_get_video_buffer returned last (caller's
+ * thread) */
+static int g_video_read_format = YAGE_OUTPUT_RGBA8888;
+#ifndef _WIN32
+static atomic_int g_video_conv_dirty = 1;
+#else
+static volatile int g_video_conv_dirty = 1;
+#endif
+
+/* Dirty-scanline tracking.  g_src_shadow keeps a copy of the core's last
+ * source frame; only rows whose bytes differ are taken.  Every changed row
+ * is stamped with the frame serial in g_row_serial, so each converted
+ * surface (g_video_buffer, display slots, ANativeWindow) reconverts or
+ * copies just the rows that changed since the serial it was last synced
+ * to. */
+static uint8_t*  g_src_shadow          = NULL;
+static size_t    g_src_shadow_capacity = 0;   /* bytes */
+static uint32_t* g_row_serial          = NULL;
+static int       g_row_serial_capacity = 0;   /* rows */
+static uint32_t  g_video_serial        = 0;   /* serial of the last converted frame */
+static int       g_shadow_width        = 0;
+static int       g_shadow_height       = 0;
+static int       g_shadow_row_bytes    = 0;
+static int       g_video_force_full    = 1;   /* next sync reconverts every row */
+
+/* Deferred conversion: the last frame the core delivered, not yet folded
+ * into g_src_shadow (see video_consume_pending). */
+static const void* g_video_pending_data  = NULL;
+static size_t      g_video_pending_pitch = 0;
+static int         g_video_pending       = 0;
+
+/* Converter matching the current g_src_shadow contents */
+static yage_pixconv_row_fn g_shadow_convert = NULL;
+static const uint32_t*     g_shadow_table   = NULL;
+
+/* A converted output surface and the frame serial it was last synced to */
+typedef struct {
+    uint32_t serial;
+    int      width;    /* 0 → contents invalid */
+    int      height;
+} VideoSyncState;
+
+static VideoSyncState g_video_buffer_sync = { 0, 0, 0 };
+
+/* Timing reported by the core's AV info (yage_core_load_rom) */
+static double g_av_fps         = 59.7275;
+static double g_av_sample_rate = 32768.0;
+
 /* Audio volume control (0.0 = mute, 1.0 = full volume) */
 static float g_volume = 1.0f;
 static int g_audio_enabled = 1;
@@ -195,8 +387,15 @@ static int g_sgb_borders_enabled = 1;  /* 1 = show SGB borders, 0 = GB only */
 static int g_variables_dirty = 1;      /* 1 = core should re-read variables */
 
 /* GB color palette remapping (only for original GB games) 
- * Colors stored in ABGR format (RGBA in little-endian memory for Flutter) */
-static int g_palette_enabled = 0;  /* 0 = use original colors, 1 = remap */
+ * Colors stored in ABGR format (RGBA in little-endian memory for Flutter).
+ * g_palette_colors belongs to the thread converting frames: a new palette
+ * is staged in g_index_palette and copied here by update_video_converter,
+ * so a conversion or LUT build never sees a half-written palette. */
+#ifndef _WIN32
+static atomic_int g_palette_enabled = 0;     /* 0 = use original colors, 1 = remap */
+#else
+static volatile int g_palette_enabled = 0;
+#endif
 static uint32_t g_palette_colors[4] = {
     0xFF0FBC9B, /* Lightest - ABGR of 0x9BBC0F */
     0xFF0FAC8B, /* Light    - ABGR of 0x8BAC0F */
@@ -204,6 +403,37 @@ static uint32_t g_palette_colors[4] = {
     0xFF0F380F  /* Darkest  - ABGR of 0x0F380F */
 };
 
+/* The latest shades, as set from Dart: the staging copy for
+ * g_palette_colors, and the colours YAGE_OUTPUT_INDEX8 frames are
+ * recoloured with when uploaded (window blit, desktop texture, captures,
+ * Dart).  Any thread may read them, so an INDEX8 palette change needs no
+ * converter rebuild; the generation tells uploaders holding an old frame
+ * to redraw it. */
+#ifndef _WIN32
+static atomic_uint g_index_palette[4] = { 0xFF0FBC9B, 0xFF0FAC8B, 0xFF306230, 0xFF0F380F };
+static atomic_uint g_index_palette_gen = 0;
+#else
+static volatile uint32_t g_index_palette[4] = { 0xFF0FBC9B, 0xFF0FAC8B, 0xFF306230, 0xFF0F380F };
+static volatile uint32_t g_index_palette_gen = 0;
+#endif
+
+/* Current INDEX8 shades [lightest .. darkest] as ABGR words */
+static void index_palette_load(uint32_t pal[4]) {
+    for (int i = 0; i < 4; i++) {
+#ifndef _WIN32
+        pal[i] = atomic_load_explicit(&g_index_palette[i], memory_order_relaxed);
+#else
+        pal[i] = g_index_palette[i];
+#endif
+    }
+}
+
+/* INDEX8 recolour scratch for capture consumers (screenshots, recording,
+ * replay, shared-memory export) — thread that drives retro_run(), or the
+ * pipeline worker under g_video_mutex */
+static uint32_t* g_capture_rgba          = NULL;
+static size_t    g_capture_rgba_capacity = 0;   /* pixels */
+
 /* Rewind ring buffer — stores serialized save states for instant rewind */
 static void** g_rewind_snapshots = NULL;  /* Array of serialized state buffers */
 static int g_rewind_head = 0;            /* Next write position */
@@ -211,13 +441,104 @@ static int g_rewind_count = 0;           /* Number of valid snapshots */
 static int g_rewind_capacity = 0;        /* Allocated capacity */
 static size_t g_rewind_state_size = 0;   /* Size of each serialized state */
 
+/* Audio output — the engine (yage_audio) resamples the core's audio to
+ * AUDIO_DEVICE_RATE and feeds the device in AUDIO_BUFFER_FRAMES periods:
+ * OpenSL ES on Android (opened automatically), an engine thread with an
+ * ALSA / null / WAV sink on desktop (yage_audio_output_start). */
+#define AUDIO_DEVICE_RATE 48000.0
+#define AUDIO_BUFFER_FRAMES 256
+
+/* Pull stream (yage_audio_read) — every frame's audio, volume-scaled, at
+ * the core's rate, for hosts that play it themselves.  A yage_ring with
+ * the thread driving retro_run as producer and the host as consumer,
+ * created with the first core and kept, so a read racing a teardown never
+ * sees it freed.  Fed from the host's first read on; when full, the newest
+ * audio is dropped rather than the reader's position moved.  A new game
+ * hands the reader the frames to skip (g_pull_flush) instead of touching
+ * its index.  Windows has no frame loop thread, so both sides run on
+ * Dart's thread there. */
+#define PULL_RING_FRAMES 65536                   /* 0.5 s at 131 kHz */
+static YageRing* g_pull = NULL;
+#ifndef _WIN32
+static atomic_int  g_pull_on      = 0;
+static atomic_uint g_pull_flush   = 0;
+static atomic_uint g_pull_dropped = 0;
+#else
+static volatile int      g_pull_on      = 0;
+static volatile uint32_t g_pull_flush   = 0;
+static volatile uint32_t g_pull_dropped = 0;
+#endif
+
+static void pull_stream_write(const int16_t* data, size_t frames) {
+#ifndef _WIN32
+    if (!atomic_load_explicit(&g_pull_on, memory_order_relaxed)) return;
+#else
+    if (!g_pull_on) return;
+#endif
+    size_t written = yage_ring_write(g_pull, data, frames);
+    if (written < frames) {
+#ifndef _WIN32
+        atomic_fetch_add_explicit(&g_pull_dropped, (unsigned)(frames - written), memory_order_relaxed);
+#else
+        g_pull_dropped += (uint32_t)(frames - written);
+#endif
+    }
+}
+
+/* Forget buffered audio (new game).  Only while no frame runs. */
+static void pull_stream_reset(void) {
+#ifndef _WIN32
+    atomic_store(&g_pull_flush, (unsigned)yage_ring_available(g_pull));
+#else
+    g_pull_flush = (uint32_t)yage_ring_available(g_pull);
+#endif
+}
+
+/* Rate detection — the core's rate, per game */
+static int g_rate_detection_samples = 0;  /* Total audio samples during detection */
+static int g_rate_detected = 0;
+static double g_detected_rate = 0;
+static double g_reported_rate = 32768.0;  /* Sample rate from AV info (set at ROM load) */
+
+/* Video frame counter — incremented per retro_run() that produced audio
+ * (run_core_frame), used for audio rate detection: samples per video
+ * frame at the core's frame rate give the sample rate. */
+static int g_video_frames_total = 0;
+
+/* Continuous rate monitoring — catches games whose real rate is far from
+ * the one in use (bogus AV info, mid-play switches); small drift is left
+ * to dynamic rate control */
+static int g_monitor_frames = 0;          /* VIDEO frames seen during monitoring window */
+static int g_monitor_samples = 0;         /* Audio samples during monitoring window */
+
+/* Sample rate implied by the average samples-per-video-frame at the
+ * core's frame rate, e.g. ~1097 samples/frame × 59.7275 fps ≈ 65536 Hz.
+ * Only a sanity check — the resampler does not need it to be exact. */
+static double measured_sample_rate(double samples_per_frame) {
+    return samples_per_frame * g_av_fps;
+}
+
+/* AV info rates outside this range are treated as bogus */
+static int plausible_sample_rate(double rate) {
+    return rate >= 8000.0 && rate <= 192000.0;
+}
+
+/* Forget the detected rate so the next batches establish it again */
+static void reset_rate_detection(void) {
+    g_rate_detection_samples = 0;
+    g_rate_detected = 0;
+    g_detected_rate = 0;
+    g_video_frames_total = 0;
+    g_monitor_frames = 0;
+    g_monitor_samples = 0;
+}
+
 #ifdef __ANDROID__
 #include <stdatomic.h>
 
-/* OpenSL ES audio state — low latency with adaptive rate
- * 2 buffers × 256 frames ≈ 15ms at 32kHz, 8ms at 65kHz */
+/* OpenSL ES audio state — a pull backend of the audio engine
+ * (yage_audio), 2 buffers × AUDIO_BUFFER_FRAMES ≈ 11ms at 48kHz */
 #define AUDIO_BUFFERS 2
-#define AUDIO_BUFFER_FRAMES 256
 
 static SLObjectItf g_sl_engine = NULL;
 static SLEngineItf g_sl_engine_itf = NULL;
@@ -230,36 +551,6 @@ static int16_t* g_sl_buffers[AUDIO_BUFFERS] = {NULL, NULL};
 static int g_sl_buffer_index = 0;
 static atomic_int g_sl_initialized = 0;
 
-/* Lock-free ring buffer for audio — sized to hold ~250ms at highest rate */
-#define RING_BUFFER_SIZE (32768)
-#define RING_BUFFER_MASK (RING_BUFFER_SIZE - 1)
-static int16_t g_ring_buffer[RING_BUFFER_SIZE];
-static atomic_int g_ring_read = 0;
-static atomic_int g_ring_write = 0;
-
-/* Audio smoothing state */
-static int16_t g_last_sample_l = 0;
-static int16_t g_last_sample_r = 0;
-static int g_underrun_count = 0;
-static int g_audio_started = 0;
-static double g_audio_sample_rate = 32768.0;
-
-/* Adaptive rate detection — detects and re-adapts per game */
-static int g_rate_detection_samples = 0;  /* Total audio samples during detection */
-static int g_rate_detected = 0;
-static double g_detected_rate = 0;
-static double g_reported_rate = 32768.0;  /* Sample rate from AV info (set at ROM load) */
-
-/* Video frame counter — incremented in video_refresh_callback, used for
- * audio rate detection.  The audio batch callback can be invoked multiple
- * times per video frame (especially for GB/GBC), so counting video frames
- * gives the correct samples-per-video-frame for rate classification. */
-static int g_video_frames_total = 0;
-
-/* Continuous rate monitoring — catches games that change rate mid-play */
-static int g_monitor_frames = 0;          /* VIDEO frames seen during monitoring window */
-static int g_monitor_samples = 0;         /* Audio samples during monitoring window */
-static int g_frames_since_reinit = 0;     /* VIDEO frames since last OpenSL reinit */
 
 /* ── Android Texture Rendering (ANativeWindow) ────────────────────────
  * Zero-copy frame delivery to Flutter's Texture widget.
@@ -272,45 +563,18 @@ static int g_frames_since_reinit = 0;     /* VIDEO frames since last OpenSL rein
 static ANativeWindow* g_native_window = NULL;
 static int g_nw_configured_w = 0;  /* last-configured buffer geometry width */
 static int g_nw_configured_h = 0;  /* last-configured buffer geometry height */
+static int g_nw_configured_fmt = 0; /* last-configured WINDOW_FORMAT_* */
+static uint32_t g_nw_serial = 0;   /* frame serial of the last posted buffer */
+static int g_nw_valid = 0;         /* 0 → next blit posts the whole frame */
+static int g_nw_post = 0;          /* DisplayPost key of the posted frame */
+static uint32_t g_nw_palette_gen = 0;  /* INDEX8 shades the posted frame was recoloured with */
 static pthread_mutex_t g_nw_mutex = PTHREAD_MUTEX_INITIALIZER;
 
-/* Pre-buffer threshold — just enough for one OpenSL callback to avoid initial underrun */
-#define PREBUFFER_SAMPLES (AUDIO_BUFFER_FRAMES)
 
 /* Forward declarations */
 static void shutdown_opensl_audio(void);
 static int init_opensl_audio(double sample_rate);
 
-/* Classify sample rate from average samples-per-frame.
- * mGBA runs at ~59.7275 fps, so expected samples/frame:
- *   131072 Hz → ~2194 samples/frame  (GB/GBC native: 4.194304 MHz ÷ 32)
- *    65536 Hz → ~1097 samples/frame  (Pokemon, most GBA)
- *    48000 Hz → ~804 samples/frame   (NES/SNES)
- *    44100 Hz → ~735 samples/frame   (Genesis Plus GX / Mega Drive)
- *    32768 Hz → ~549 samples/frame   (Dragon Ball, some GB/GBA)
- *
- * Thresholds use midpoints between expected values, lowered slightly
- * because startup frames often produce fewer samples.
- */
-static double classify_sample_rate(double samples_per_frame) {
-    if (samples_per_frame > 1600) return 131072.0;  /* GB/GBC native rate */
-    if (samples_per_frame > 850)  return 65536.0;
-    if (samples_per_frame > 770)  return 48000.0;   /* midpoint of 804 and 735 */
-    if (samples_per_frame > 640)  return 44100.0;   /* midpoint of 735 and 549 */
-    return 32768.0;
-}
-
-/* Get number of samples available in ring buffer */
-static inline int ring_buffer_available(void) {
-    int write_pos = atomic_load_explicit(&g_ring_write, memory_order_acquire);
-    int read_pos = atomic_load_explicit(&g_ring_read, memory_order_acquire);
-    return (write_pos - read_pos + RING_BUFFER_SIZE) & RING_BUFFER_MASK;
-}
-
-/* Get free space in ring buffer */
-static inline int ring_buffer_free(void) {
-    return RING_BUFFER_SIZE - 1 - ring_buffer_available();
-}
 
 static void sl_buffer_callback(SLAndroidSimpleBufferQueueItf bq, void* context) {
     (void)context;
@@ -322,55 +586,10 @@ static void sl_buffer_callback(SLAndroidSimpleBufferQueueItf bq, void* context)
     if (!buffer) return;
     g_sl_buffer_index = (g_sl_buffer_index + 1) % AUDIO_BUFFERS;
     
-    int samples_needed = AUDIO_BUFFER_FRAMES * 2; /* Stereo */
-    int read_pos = atomic_load_explicit(&g_ring_read, memory_order_acquire);
-    int write_pos = atomic_load_explicit(&g_ring_write, memory_order_acquire);
-    int available = (write_pos - read_pos + RING_BUFFER_SIZE) & RING_BUFFER_MASK;
-    
-    /* Wait for pre-buffer before starting actual playback */
-    if (!g_audio_started) {
-        if (available < PREBUFFER_SAMPLES * 2) {
-            /* Not enough data yet - output silence */
-            memset(buffer, 0, samples_needed * sizeof(int16_t));
-            (*bq)->Enqueue(bq, buffer, samples_needed * sizeof(int16_t));
-            return;
-        }
-        g_audio_started = 1;
-        LOGI("Audio pre-buffer filled (%d samples), starting playback", available);
-    }
-    
-    /* Fill buffer from ring buffer */
-    for (int i = 0; i < samples_needed; i += 2) {
-        if (available >= 2) {
-            /* Read stereo pair */
-            g_last_sample_l = g_ring_buffer[read_pos];
-            read_pos = (read_pos + 1) & RING_BUFFER_MASK;
-            g_last_sample_r = g_ring_buffer[read_pos];
-            read_pos = (read_pos + 1) & RING_BUFFER_MASK;
-            available -= 2;
-            
-            buffer[i] = g_last_sample_l;
-            buffer[i + 1] = g_last_sample_r;
-            g_underrun_count = 0;
-        } else {
-            /* Underrun - fade to silence */
-            g_underrun_count++;
-            if (g_underrun_count < 64) {
-                g_last_sample_l = (g_last_sample_l * 15) >> 4;
-                g_last_sample_r = (g_last_sample_r * 15) >> 4;
-            } else {
-                g_last_sample_l = 0;
-                g_last_sample_r = 0;
-            }
-            buffer[i] = g_last_sample_l;
-            buffer[i + 1] = g_last_sample_r;
-        }
-    }
-    
-    /* Update read position atomically */
-    atomic_store_explicit(&g_ring_read, read_pos, memory_order_release);
+    /* Pre-buffering, underrun fade and skipping are the engine's job */
+    yage_audio_render(buffer, AUDIO_BUFFER_FRAMES);
     
-    (*bq)->Enqueue(bq, buffer, samples_needed * sizeof(int16_t));
+    (*bq)->Enqueue(bq, buffer, AUDIO_BUFFER_FRAMES * 2 * sizeof(int16_t));
 }
 
 static int init_opensl_audio(double sample_rate) {
@@ -381,16 +600,15 @@ static int init_opensl_audio(double sample_rate) {
         shutdown_opensl_audio();
     }
     
-    /* Reset ring buffer state */
-    atomic_store(&g_ring_read, 0);
-    atomic_store(&g_ring_write, 0);
-    g_last_sample_l = 0;
-    g_last_sample_r = 0;
-    g_underrun_count = 0;
-    g_audio_started = 0;
-    memset(g_ring_buffer, 0, sizeof(g_ring_buffer));
-    
-    g_audio_sample_rate = sample_rate;
+    /* The engine's ring feeds this player from now on (a failed earlier
+     * attempt may have left it open) */
+    yage_audio_close();
+    if (yage_audio_open(YAGE_AUDIO_BACKEND_EXTERNAL, NULL, sample_rate,
+                        AUDIO_BUFFER_FRAMES) != 0) {
+        LOGE("Failed to open the audio engine");
+        return -1;
+    }
+    yage_audio_set_device_frames(AUDIO_BUFFERS * AUDIO_BUFFER_FRAMES);
     
     LOGI("Initializing OpenSL ES audio at %.0f Hz", sample_rate);
     
@@ -558,13 +776,8 @@ static void shutdown_opensl_audio(void) {
         }
     }
     
-    /* Reset ring buffer state */
-    atomic_store(&g_ring_read, 0);
-    atomic_store(&g_ring_write, 0);
-    g_last_sample_l = 0;
-    g_last_sample_r = 0;
-    g_underrun_count = 0;
-    g_audio_started = 0;
+    /* No more callbacks: drop what the engine still buffers */
+    yage_audio_close();
     
     g_sl_play_itf = NULL;
     g_sl_buffer_queue = NULL;
@@ -607,58 +820,665 @@ struct YageCore {
     size_t state_size;
 };
 
-/* Color correction for GBA - makes colors more vibrant on modern displays */
-static inline uint32_t apply_color_correction(uint8_t r, uint8_t g, uint8_t b) {
-    /* GBA color correction - slight boost to saturation and contrast */
-    /* This compensates for the original GBA's dark, non-backlit screen */
-    int ri = r, gi = g, bi = b;
-    
-    /* Boost contrast slightly */
-    ri = (ri - 128) * 110 / 100 + 128;
-    gi = (gi - 128) * 110 / 100 + 128;
-    bi = (bi - 128) * 110 / 100 + 128;
-    
-    /* Clamp values */
-    if (ri < 0) ri = 0; if (ri > 255) ri = 255;
-    if (gi < 0) gi = 0; if (gi > 255) gi = 255;
-    if (bi < 0) bi = 0; if (bi > 255) bi = 255;
-    
-    /* Return as ABGR (which is RGBA in little-endian memory order for Flutter) */
-    return 0xFF000000 | ((uint32_t)bi << 16) | ((uint32_t)gi << 8) | (uint32_t)ri;
+/* Per-pixel transform for the current platform / palette setting */
+static YageConvMode current_conv_mode(void) {
+#ifndef _WIN32
+    if (atomic_load_explicit(&g_palette_enabled, memory_order_relaxed)) return YAGE_CONV_PALETTE;
+#else
+    if (g_palette_enabled) return YAGE_CONV_PALETTE;
+#endif
+    if (g_color_correction_enabled) return YAGE_CONV_CONTRAST;
+    return YAGE_CONV_PLAIN;
 }
 
-/* Map an RGB pixel to one of 4 palette colors based on luminance.
- * GB games output 4 distinct shades - we classify by luminance thresholds. */
-static inline uint32_t apply_gb_palette(uint8_t r, uint8_t g, uint8_t b) {
-    /* Fast luminance approximation: (r*2 + g*5 + b) / 8 */
-    int lum = (r * 2 + g * 5 + b) >> 3;
-    
-    /* Map to 4 levels with thresholds tuned for mGBA's GB output */
-    if (lum >= 192) return g_palette_colors[0];      /* Lightest */
-    else if (lum >= 128) return g_palette_colors[1];  /* Light */
-    else if (lum >= 64) return g_palette_colors[2];   /* Dark */
-    else return g_palette_colors[3];                   /* Darkest */
+/* The core's frames are already in the active output layout (RGB565 in
+ * and out, no transform): converting is a row copy.  Set by
+ * update_video_converter, so it follows g_out_format rather than the
+ * format last requested. */
+static int g_video_passthrough = 0;
+
+/* Request a converter rebuild before the next frame is converted.
+ * Called when the core negotiates its pixel format, when a ROM is loaded
+ * (colour correction depends on the platform) and when the GB palette is
+ * switched. */
+static void invalidate_video_converter(void) {
+#ifndef _WIN32
+    atomic_store_explicit(&g_video_conv_dirty, 1, memory_order_release);
+#else
+    g_video_conv_dirty = 1;
+#endif
+}
+
+/* Pick the row converter once per (pixel format, transform, output format)
+ * change instead of re-checking them for every pixel.  RGB565 → RGB565 with
+ * no transform is a row copy.  Other 16-bit cases with a transform (or
+ * RGB565 output) get the whole pipeline — bit expansion, contrast boost or
+ * palette bucketing, output packing — baked into a 64K-entry table, so each
+ * pixel is one load.  Plain 16-bit expansion and XRGB8888 stay on the SIMD
+ * kernels, which beat a 256 KB table there (no SIMD on this CPU → the
+ * table wins everywhere). */
+static void update_video_converter(void) {
+    index_palette_load(g_palette_colors);   /* staged by yage_core_set_color_palette */
+    YageConvMode mode = current_conv_mode();
+    int out = g_output_format;
+    if (out == YAGE_OUTPUT_INDEX8 && mode != YAGE_CONV_PALETTE) {
+        out = YAGE_OUTPUT_RGBA8888;   /* shade indices need the GB palette remap */
+    }
+    g_video_force_full = 1;  /* same source bytes now convert differently */
+    g_out_format = out;
+    g_out_bpp = yage_pixconv_output_bpp(out);
+#ifndef _WIN32
+    atomic_store_explicit(&g_out_format_pub, out, memory_order_relaxed);
+#else
+    g_out_format_pub = out;
+#endif
+    int is_16bit = (g_pixel_format == RETRO_PIXEL_FORMAT_RGB565 ||
+                    g_pixel_format == RETRO_PIXEL_FORMAT_0RGB1555);
+
+    g_video_passthrough = out == YAGE_OUTPUT_RGB565 &&
+                          g_pixel_format == RETRO_PIXEL_FORMAT_RGB565 &&
+                          mode == YAGE_CONV_PLAIN;
+    if (g_video_passthrough) {
+        g_convert_row = yage_pixconv_row_copy16;
+        g_convert_table = NULL;
+        LOGI("Video converter: RGB565 passthrough");
+        return;
+    }
+
+    int use_lut = is_16bit && (mode != YAGE_CONV_PLAIN || out == YAGE_OUTPUT_RGB565 ||
+                               yage_pixconv_best_level() == YAGE_SIMD_SCALAR);
+
+    if (use_lut && !g_pixel_lut) {
+        g_pixel_lut = (uint32_t*)malloc(YAGE_PIXCONV_LUT_SIZE * sizeof(uint32_t));
+        if (!g_pixel_lut) LOGE("Failed to allocate pixel LUT, using direct converter");
+    }
+    if (use_lut && g_pixel_lut &&
+        yage_pixconv_build_lut(g_pixel_lut, g_pixel_format, mode, out,
+                               g_palette_colors) == 0) {
+        g_convert_row = out == YAGE_OUTPUT_RGB565 ? yage_pixconv_row_lut16_565
+                      : out == YAGE_OUTPUT_INDEX8 ? yage_pixconv_row_lut16_index8
+                                                  : yage_pixconv_row_lut16;
+        g_convert_table = g_pixel_lut;
+        LOGI("Video converter: 64K LUT (format=%d, mode=%d, out=%d)",
+             g_pixel_format, (int)mode, out);
+        return;
+    }
+
+    g_convert_row = yage_pixconv_select(g_pixel_format, mode, out);
+    g_convert_table = g_palette_colors;
+    if (g_convert_row) {
+        LOGI("Video converter: %s (format=%d, mode=%d, out=%d)",
+             yage_pixconv_level_name(yage_pixconv_output_bpp(out) < 4 ? YAGE_SIMD_SCALAR
+                                                                      : yage_pixconv_best_level()),
+             g_pixel_format, (int)mode, out);
+    }
+}
+
+/* Grow the source shadow / row-serial arrays to fit a frame.
+ * Returns 1 when dirty-row tracking is usable for this frame. */
+static int ensure_dirty_tracking(size_t shadow_bytes, int rows) {
+    if (shadow_bytes > g_src_shadow_capacity) {
+        uint8_t* buf = (uint8_t*)realloc(g_src_shadow, shadow_bytes);
+        if (!buf) return 0;
+        g_src_shadow = buf;
+        g_src_shadow_capacity = shadow_bytes;
+        g_video_force_full = 1;
+    }
+    if (rows > g_row_serial_capacity) {
+        uint32_t* serials = (uint32_t*)realloc(g_row_serial, (size_t)rows * sizeof(uint32_t));
+        if (!serials) return 0;
+        g_row_serial = serials;
+        g_row_serial_capacity = rows;
+        g_video_force_full = 1;
+    }
+    return 1;
+}
+
+/* Rows of the core's frame that changed after frame serial `since`.
+ * Without dirty tracking every row counts as changed.  Returns the number
+ * of dirty rows; *top / *bottom bound them (inclusive) when non-zero. */
+static int video_dirty_rows(uint32_t since, int height, int* top, int* bottom) {
+    if (!g_row_serial || height > g_row_serial_capacity || height != g_shadow_height) {
+        *top = 0;
+        *bottom = height - 1;
+        return height;
+    }
+    int count = 0;
+    *top = height;
+    *bottom = -1;
+    for (int y = 0; y < height; y++) {
+        /* Wrap-safe "row_serial > since" */
+        if ((int32_t)(g_row_serial[y] - since) > 0) {
+            if (y < *top) *top = y;
+            *bottom = y;
+            count++;
+        }
+    }
+    return count;
+}
+
+/* Row converter for a source with `src_bpp` bytes per pixel.  Known formats
+ * use the converter picked by update_video_converter(); unknown ones are
+ * guessed from the pixel size. */
+static void select_row_converter(int src_bpp, yage_pixconv_row_fn* fn,
+                                 const uint32_t** table) {
+    *fn = g_convert_row;
+    *table = g_convert_table;
+    if (!*fn) {
+        *fn = yage_pixconv_select(src_bpp == 4 ? RETRO_PIXEL_FORMAT_XRGB8888
+                                               : RETRO_PIXEL_FORMAT_RGB565,
+                                  current_conv_mode(), g_out_format);
+        *table = g_palette_colors;
+    }
+}
+
+/* Shared video state lock — only contended while the conversion pipeline
+ * runs, when the loop thread and the worker both touch it */
+static void video_lock(void) {
+#ifndef _WIN32
+    pthread_mutex_lock(&g_video_mutex);
+#endif
+}
+
+static void video_unlock(void) {
+#ifndef _WIN32
+    pthread_mutex_unlock(&g_video_mutex);
+#endif
+}
+
+/* Fold the frame recorded by video_refresh_callback into g_src_shadow and
+ * stamp the rows that changed.  A converter change restamps every row so
+ * all surfaces reconvert.  Must run on the thread that drives retro_run():
+ * the core's framebuffer is only stable between retro_run() calls. */
+static void video_consume_pending(void) {
+#ifndef _WIN32
+    /* With the pipeline on, the worker only converts what the loop thread
+     * consumed; the core's buffer may be mid-retro_run() meanwhile */
+    if (g_pipe_on && !pthread_equal(pthread_self(), g_frame_thread)) return;
+    if (atomic_exchange_explicit(&g_video_conv_dirty, 0, memory_order_acq_rel)) {
+#else
+    if (g_video_conv_dirty) {
+        g_video_conv_dirty = 0;
+#endif
+        update_video_converter();
+    }
+
+    if (!g_video_pending) {
+        /* Same source, new converter: every row is stale */
+        if (g_video_force_full && g_shadow_height > 0 && g_row_serial) {
+            select_row_converter(g_shadow_row_bytes / g_shadow_width,
+                                 &g_shadow_convert, &g_shadow_table);
+            g_video_serial++;
+            for (int y = 0; y < g_shadow_height; y++) g_row_serial[y] = g_video_serial;
+            g_video_force_full = 0;
+        }
+        return;
+    }
+    g_video_pending = 0;
+    if (!g_video_pending_data) return;
+
+    unsigned width = (unsigned)g_width;
+    unsigned height = (unsigned)g_height;
+    size_t pitch = g_video_pending_pitch;
+    int src_bpp = (g_pixel_format == RETRO_PIXEL_FORMAT_XRGB8888) ? 4 : 2;
+    if (!g_convert_row) {
+        /* Unknown format - try to detect based on pitch:
+         * 32-bit pixels if the pitch allows it, otherwise assume RGB565 */
+        LOGI("Unknown pixel format %d, trying auto-detect", g_pixel_format);
+        src_bpp = (pitch >= width * 4) ? 4 : 2;
+    }
+    select_row_converter(src_bpp, &g_shadow_convert, &g_shadow_table);
+
+    int row_bytes = (int)width * src_bpp;
+    if (!ensure_dirty_tracking((size_t)row_bytes * height, (int)height)) {
+        LOGE("Failed to allocate frame shadow for %ux%u", width, height);
+        g_shadow_height = 0;
+        g_video_force_full = 1;
+        return;
+    }
+
+    int full = g_video_force_full || (int)width != g_shadow_width ||
+               (int)height != g_shadow_height || row_bytes != g_shadow_row_bytes;
+    if (full) {
+        g_shadow_width     = (int)width;
+        g_shadow_height    = (int)height;
+        g_shadow_row_bytes = row_bytes;
+        g_video_force_full = 0;
+    }
+
+    /* Pitch is in bytes for every format */
+    const uint8_t* src = (const uint8_t*)g_video_pending_data;
+    g_video_serial++;
+    for (unsigned y = 0; y < height; y++) {
+        const uint8_t* row = src + y * pitch;
+        uint8_t* shadow = g_src_shadow + (size_t)y * row_bytes;
+        if (!full && memcmp(shadow, row, (size_t)row_bytes) == 0) continue;
+        memcpy(shadow, row, (size_t)row_bytes);
+        g_row_serial[y] = g_video_serial;
+    }
 }
 
-/* Process a pixel: apply palette remap for GB, color correction for GBC/GBA,
- * or straight ABGR conversion for NES/SNES/Genesis. */
-static inline uint32_t process_pixel(uint8_t r, uint8_t g, uint8_t b) {
-    if (g_palette_enabled) {
-        return apply_gb_palette(r, g, b);
+/* Bring the output surface `dst` up to date with the core's latest frame,
+ * converting only rows that changed since it was last synced.  `dst` must
+ * hold g_width × g_height pixels of g_out_bpp bytes, rows packed. */
+static void video_sync(void* dst, VideoSyncState* st) {
+    video_consume_pending();
+    if (!g_shadow_convert || g_shadow_height <= 0) return;
+
+    int w = g_shadow_width;
+    int h = g_shadow_height;
+    int full = st->width != w || st->height != h;
+    for (int y = 0; y < h; y++) {
+        /* Wrap-safe "row_serial > since" */
+        if (!full && (int32_t)(g_row_serial[y] - st->serial) <= 0) continue;
+        g_shadow_convert((uint8_t*)dst + (size_t)y * w * g_out_bpp,
+                         g_src_shadow + (size_t)y * g_shadow_row_bytes, w, g_shadow_table);
     }
-    if (g_color_correction_enabled) {
-        return apply_color_correction(r, g, b);
+    st->serial = g_video_serial;
+    st->width  = w;
+    st->height = h;
+}
+
+/* Convert the core's latest frame into g_video_buffer if it is stale */
+static void video_flush_pending(void) {
+    if (!g_video_buffer) return;
+    video_sync(g_video_buffer, &g_video_buffer_sync);
+}
+
+/* The synced w × h frame in g_video_buffer, in a layout every capture
+ * consumer understands: INDEX8 frames come back recoloured to RGBA8888.
+ * Returns NULL if the recolour buffer cannot grow. */
+static const void* capture_pixels(int w, int h, int* format) {
+    *format = g_out_format;
+    if (g_out_format != YAGE_OUTPUT_INDEX8) return g_video_buffer;
+    size_t needed = (size_t)w * h;
+    if (needed > g_capture_rgba_capacity) {
+        uint32_t* buf = (uint32_t*)realloc(g_capture_rgba, needed * sizeof(uint32_t));
+        if (!buf) return NULL;
+        g_capture_rgba = buf;
+        g_capture_rgba_capacity = needed;
+    }
+    uint32_t pal[4];
+    index_palette_load(pal);
+    const uint8_t* src = (const uint8_t*)g_video_buffer;
+    for (int y = 0; y < h; y++) {
+        yage_pixconv_row_index8_expand(g_capture_rgba + (size_t)y * w, src + (size_t)y * w, w, pal);
+    }
+    *format = YAGE_OUTPUT_RGBA8888;
+    return g_capture_rgba;
+}
+
+/* ── Screenshots ─────────────────────────────────────────────────────── */
+
+typedef struct ScreenshotJob {
+    struct ScreenshotJob* next;   /* parked for the frame loop */
+    int32_t   id;
+    int32_t   format;          /* YAGE_IMAGE_* */
+    int32_t   max_width;
+    int32_t   max_height;
+    yage_screenshot_callback_t callback;
+    uint8_t*  pixels;          /* snapshot in `pixel_format` */
+    int       width;
+    int       height;
+    int       pixel_format;    /* YAGE_OUTPUT_* */
+    char      path[];
+} ScreenshotJob;
+
+#ifndef _WIN32
+static atomic_int  g_shot_next_id  = 1;
+static atomic_int  g_shot_inflight = 0;     /* jobs not yet completed */
+/* Requests waiting for the frame loop, newest first.  Any number can be
+ * parked: yage_screenshot_save pushes with a CAS, screenshot_poll takes
+ * the whole list at once. */
+static ScreenshotJob* _Atomic g_shot_requests = NULL;
+#else
+static int         g_shot_next_id  = 1;
+#endif
+
+/* Copy the newest frame into the job.  Runs on the thread that drives
+ * retro_run(), so g_video_buffer is stable. */
+static int screenshot_snapshot(ScreenshotJob* job) {
+    int rc = -1;
+    video_lock();
+    video_flush_pending();
+    int w = g_video_buffer_sync.width, h = g_video_buffer_sync.height;
+    int format;
+    const void* pixels = g_video_buffer && w > 0 && h > 0 ? capture_pixels(w, h, &format) : NULL;
+    if (pixels) {
+        size_t bytes = (size_t)w * h * yage_pixconv_output_bpp(format);
+        job->pixels = (uint8_t*)malloc(bytes);
+        if (job->pixels) {
+            memcpy(job->pixels, pixels, bytes);
+            job->width = w;
+            job->height = h;
+            job->pixel_format = format;
+            rc = 0;
+        }
+    }
+    video_unlock();
+    return rc;
+}
+
+static int32_t screenshot_encode(const ScreenshotJob* job) {
+    uint8_t* rgba = (uint8_t*)malloc((size_t)job->width * job->height * 4);
+    if (!rgba) return -1;
+    yage_image_to_rgba(job->pixels, job->width, job->height, job->pixel_format, rgba);
+    int w, h;
+    yage_image_downscale(rgba, job->width, job->height, job->max_width, job->max_height, &w, &h);
+
+    uint8_t* data = NULL;
+    size_t size = job->format == YAGE_IMAGE_QOI ? yage_image_encode_qoi(rgba, w, h, &data)
+                                                : yage_image_encode_png(rgba, w, h, &data);
+    free(rgba);
+    if (size == 0) return -1;
+
+    int32_t rc = -1;
+    FILE* f = fopen(job->path, "wb");
+    if (f) {
+        if (fwrite(data, 1, size, f) == size) rc = 0;
+        if (fclose(f) != 0) rc = -1;
+    }
+    free(data);
+    return rc;
+}
+
+/* Encode (if the snapshot succeeded), report and free the job */
+static void screenshot_finish(ScreenshotJob* job) {
+    int32_t rc = job->pixels ? screenshot_encode(job) : -1;
+    if (rc != 0) LOGE("Screenshot %d to %s failed", job->id, job->path);
+    if (job->callback) job->callback(job->id, rc);
+    free(job->pixels);
+    free(job);
+}
+
+#ifndef _WIN32
+static void* screenshot_thread(void* arg) {
+    screenshot_finish((ScreenshotJob*)arg);
+    atomic_fetch_sub(&g_shot_inflight, 1);
+    return NULL;
+}
+
+/* Snapshot on this thread, encode on a detached one */
+static void screenshot_dispatch(ScreenshotJob* job) {
+    pthread_t thread;
+    pthread_attr_t attr;
+    if (screenshot_snapshot(job) == 0 && pthread_attr_init(&attr) == 0) {
+        pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+        int rc = pthread_create(&thread, &attr, screenshot_thread, job);
+        pthread_attr_destroy(&attr);
+        if (rc == 0) return;
+    }
+    screenshot_thread(job);   /* report the failure here */
+}
+
+/* Serve the requests parked for the thread that drives retro_run(), in
+ * the order they were made */
+static void screenshot_poll(void) {
+    if (!atomic_load_explicit(&g_shot_requests, memory_order_relaxed)) return;
+    ScreenshotJob* job = atomic_exchange_explicit(&g_shot_requests, NULL, memory_order_acquire);
+    ScreenshotJob* oldest = NULL;
+    while (job) {
+        ScreenshotJob* next = job->next;
+        job->next = oldest;
+        oldest = job;
+        job = next;
     }
-    return 0xFF000000 | ((uint32_t)b << 16) | ((uint32_t)g << 8) | (uint32_t)r;
+    while (oldest) {
+        ScreenshotJob* next = oldest->next;
+        screenshot_dispatch(oldest);
+        oldest = next;
+    }
+}
+#endif
+
+/* RETRO_ENVIRONMENT_GET_AUDIO_VIDEO_ENABLE bits */
+#define RETRO_AV_ENABLE_VIDEO (1 << 0)
+#define RETRO_AV_ENABLE_AUDIO (1 << 1)
+
+/* What the core has to produce during the current retro_run(), reported
+ * through GET_AUDIO_VIDEO_ENABLE.  Written by the thread that drives
+ * retro_run(); both outside a run. */
+static int g_av_enable = RETRO_AV_ENABLE_VIDEO | RETRO_AV_ENABLE_AUDIO;
+
+static void capture_video_frame(void);
+static void flush_frame_audio(void);
+
+/* Run one emulated frame.  `shown` is 0 when the frame will never be
+ * presented (fast-forward batches, frames between display intervals): the
+ * core may then skip rendering, unless a recording, the replay buffer or
+ * a pending screenshot needs every frame.  Audio is skipped while muted
+ * unless it is being captured. */
+static void run_core_frame(YageCore* core, int shown) {
+    int capture = yage_recorder_active() || yage_replay_active();
+#ifndef _WIN32
+    int snapshot = atomic_load_explicit(&g_shot_requests, memory_order_relaxed) != NULL;
+#else
+    int snapshot = 0;
+#endif
+    int av = 0;
+    if (shown || capture || snapshot) av |= RETRO_AV_ENABLE_VIDEO;
+    if ((g_audio_enabled && g_volume > 0.0f) || capture) av |= RETRO_AV_ENABLE_AUDIO;
+
+    g_av_enable = av;
+    g_audio_samples = 0;
+    core->retro_run();
+    g_av_enable = RETRO_AV_ENABLE_VIDEO | RETRO_AV_ENABLE_AUDIO;
+    flush_frame_audio();
+
+    /* Rate detection divides samples by frames: leave out frames run
+     * without audio (the core may ignore the bit, hence the sample check) */
+    if ((av & RETRO_AV_ENABLE_AUDIO) || g_audio_samples > 0) g_video_frames_total++;
+    capture_video_frame();
 }
 
+/* Hand the frame retro_run() just produced to an active recording and
+ * the replay buffer.  Both need every frame, so this converts even frames
+ * that are never displayed.  Must run on the thread that drives
+ * retro_run(). */
+static void capture_video_frame(void) {
+#ifndef _WIN32
+    screenshot_poll();
+#endif
+    int record = yage_recorder_active(), replay = yage_replay_active();
+    if (!record && !replay) return;
+    video_lock();
+    video_flush_pending();
+    int w = g_video_buffer_sync.width, h = g_video_buffer_sync.height;
+    int format = g_out_format;
+    const void* pixels = w > 0 ? capture_pixels(w, h, &format) : NULL;
+    if (record) yage_recorder_push_video(pixels, w, h, format);
+    if (replay) yage_replay_push_video(pixels, w, h, format);
+    video_unlock();
+}
+
+/* Publish the frame just presented to the shared-memory export, as the
+ * core produced it (before display post-processing).  Runs on the thread
+ * that presents: the one driving retro_run(), or the pipeline worker with
+ * g_video_mutex held. */
+static void export_presented_frame(void) {
+    if (!yage_shm_active()) return;
+    video_flush_pending();
+    int w = g_video_buffer_sync.width, h = g_video_buffer_sync.height;
+    int format;
+    const void* pixels = w > 0 ? capture_pixels(w, h, &format) : NULL;
+    if (pixels) yage_shm_publish(pixels, w, h, format);
+}
+
+#ifndef _WIN32
+/* Post-processing applied to presented frames (frame loop / present
+ * thread).  Both stages work on 32-bit pixels, so RGB565 output bypasses
+ * them. */
+typedef struct {
+    int scaler;    /* YAGE_SCALER_*, NONE when factor == 1 */
+    int factor;
+    int blend;     /* YAGE_FRAME_BLEND_* */
+    int weight;    /* blend history share, 1/128ths */
+    int key;       /* identifies scaler + blend on/off; 0 → frame shown as is */
+} DisplayPost;
+
+static void display_post(DisplayPost* p) {
+    int m = atomic_load_explicit(&g_scaler_mode, memory_order_relaxed);
+    p->factor = yage_scaler_factor(m, atomic_load_explicit(&g_scaler_factor,
+                                                           memory_order_relaxed));
+    p->scaler = p->factor > 1 ? m : YAGE_SCALER_NONE;
+    p->blend  = atomic_load_explicit(&g_blend_mode, memory_order_relaxed);
+    p->weight = atomic_load_explicit(&g_blend_weight, memory_order_relaxed);
+    if (g_out_bpp != 4) {
+        p->scaler = YAGE_SCALER_NONE;
+        p->factor = 1;
+        p->blend  = YAGE_FRAME_BLEND_OFF;
+    }
+    p->key = (p->factor > 1 ? p->scaler * 8 + p->factor : 0) |
+             (p->blend != YAGE_FRAME_BLEND_OFF ? 0x40 : 0);
+}
+
+/* LCD blend state: g_blend_out holds the blended frame, g_blend_hist the
+ * history it is mixed with.  Output rows are stamped with the blend pass
+ * that last changed them (the blended counterpart of g_row_serial). */
+static uint32_t* g_blend_out        = NULL;
+static uint32_t* g_blend_hist       = NULL;
+static uint32_t* g_blend_row_serial = NULL;
+static uint8_t*  g_blend_unsettled  = NULL;   /* row still fading */
+static size_t    g_blend_capacity   = 0;      /* pixels */
+static int       g_blend_rows_cap   = 0;
+static int       g_blend_width      = 0;      /* 0 → history invalid */
+static int       g_blend_height     = 0;
+static int       g_blend_format     = 0;
+static uint32_t  g_blend_serial     = 0;      /* last blend pass */
+static uint32_t  g_blend_src_serial = 0;      /* g_video_buffer serial blended last */
+
+static void blend_free(void) {
+    free(g_blend_out);
+    free(g_blend_hist);
+    free(g_blend_row_serial);
+    free(g_blend_unsettled);
+    g_blend_out = g_blend_hist = g_blend_row_serial = NULL;
+    g_blend_unsettled = NULL;
+    g_blend_capacity = 0;
+    g_blend_rows_cap = 0;
+    g_blend_width = g_blend_height = 0;
+}
+
+/* Blend the frame in g_video_buffer (already flushed) into g_blend_out.
+ * Only rows whose source changed, or that are still fading, are touched.
+ * Returns 0 on success, -1 on allocation failure. */
+static int blend_update(const DisplayPost* p, int w, int h) {
+    size_t pixels = (size_t)w * h;
+    if (pixels > g_blend_capacity || h > g_blend_rows_cap) {
+        uint32_t* out  = (uint32_t*)realloc(g_blend_out, pixels * sizeof(uint32_t));
+        if (out) g_blend_out = out;
+        uint32_t* hist = (uint32_t*)realloc(g_blend_hist, pixels * sizeof(uint32_t));
+        if (hist) g_blend_hist = hist;
+        uint32_t* serials = (uint32_t*)realloc(g_blend_row_serial, (size_t)h * sizeof(uint32_t));
+        if (serials) g_blend_row_serial = serials;
+        uint8_t* unsettled = (uint8_t*)realloc(g_blend_unsettled, (size_t)h);
+        if (unsettled) g_blend_unsettled = unsettled;
+        if (!out || !hist || !serials || !unsettled) {
+            LOGE("Failed to allocate LCD blend buffers for %dx%d", w, h);
+            blend_free();
+            return -1;
+        }
+        g_blend_capacity = pixels;
+        g_blend_rows_cap = h;
+        g_blend_width = 0;
+    }
+
+    g_blend_serial++;
+    if (w != g_blend_width || h != g_blend_height || g_out_format != g_blend_format) {
+        /* Fresh history: the first blended frame is the frame itself */
+        memcpy(g_blend_out, g_video_buffer, pixels * sizeof(uint32_t));
+        memcpy(g_blend_hist, g_video_buffer, pixels * sizeof(uint32_t));
+        memset(g_blend_unsettled, 0, (size_t)h);
+        for (int y = 0; y < h; y++) g_blend_row_serial[y] = g_blend_serial;
+        g_blend_width  = w;
+        g_blend_height = h;
+        g_blend_format = g_out_format;
+    } else {
+        int tracked = g_row_serial && h <= g_row_serial_capacity && h == g_shadow_height;
+        for (int y = 0; y < h; y++) {
+            /* Wrap-safe "row_serial > since" */
+            if (!g_blend_unsettled[y] && tracked &&
+                (int32_t)(g_row_serial[y] - g_blend_src_serial) <= 0) continue;
+            size_t row = (size_t)y * w;
+            int flags = yage_blend_row(g_blend_out + row, g_blend_hist + row,
+                                       g_video_buffer + row, w, p->weight,
+                                       p->blend == YAGE_FRAME_BLEND_DECAY);
+            g_blend_unsettled[y] = (flags & YAGE_BLEND_UNSETTLED) != 0;
+            if (flags & YAGE_BLEND_CHANGED) g_blend_row_serial[y] = g_blend_serial;
+        }
+    }
+    g_blend_src_serial = g_video_buffer_sync.serial;
+    return 0;
+}
+
+/* Bring the frame to present up to date for post-processing: the core's
+ * frame in g_video_buffer, or its LCD-blended copy.  *serial receives the
+ * stamp to pass to present_dirty_rows later.  NULL if there is no frame. */
+static const uint32_t* display_source(const DisplayPost* p, int w, int h, uint32_t* serial) {
+    video_flush_pending();
+    if (g_video_buffer_sync.width != w || g_video_buffer_sync.height != h) return NULL;
+    if (p->blend == YAGE_FRAME_BLEND_OFF) {
+        g_blend_width = 0;   /* history restarts when blending is re-enabled */
+        *serial = g_video_buffer_sync.serial;
+        return g_video_buffer;
+    }
+    if (blend_update(p, w, h) != 0) return NULL;
+    *serial = g_blend_serial;
+    return g_blend_out;
+}
+
+/* Rows of the presented frame that changed after `since` — a frame serial,
+ * or a blend pass while LCD blending is on.  Same contract as
+ * video_dirty_rows. */
+static int present_dirty_rows(const DisplayPost* p, uint32_t since, int height,
+                              int* top, int* bottom) {
+    if (p->blend == YAGE_FRAME_BLEND_OFF || !g_blend_row_serial || height != g_blend_height) {
+        return video_dirty_rows(since, height, top, bottom);
+    }
+    int count = 0;
+    *top = height;
+    *bottom = -1;
+    for (int y = 0; y < height; y++) {
+        if ((int32_t)(g_blend_row_serial[y] - since) > 0) {
+            if (y < *top) *top = y;
+            *bottom = y;
+            count++;
+        }
+    }
+    return count;
+}
+
+/* Write source rows [top, bottom] of the `w` × `h` frame `src` to `dst`
+ * (rows `dst_stride` pixels apart), upscaled if a scaler is active.  The
+ * filters read a 3×3 neighbourhood, so a changed row also changes the
+ * output of the rows next to it. */
+static void display_emit_rows(const DisplayPost* p, const uint32_t* src, uint32_t* dst,
+                              int dst_stride, int w, int h, int top, int bottom) {
+    if (p->factor == 1) {
+        for (int y = top; y <= bottom; y++) {
+            memcpy(dst + (size_t)y * dst_stride, src + (size_t)y * w, (size_t)w * sizeof(uint32_t));
+        }
+        return;
+    }
+    if (top > 0) top--;
+    if (bottom < h - 1) bottom++;
+    yage_scaler_run(p->scaler, p->factor, src, w, h, dst, dst_stride, top, bottom + 1);
+}
+#endif
+
 /* Libretro callbacks */
+
+/* Conversion is deferred: the callback only records where the core's frame
+ * lives.  At fast-forward the frame loop runs several retro_run() calls per
+ * display interval and only the last frame is ever shown, so converting
+ * each one would be wasted work.  The recorded frame is converted by
+ * video_sync() when a consumer needs pixels — the display slot publish,
+ * the ANativeWindow blit, or yage_core_get_video_buffer(). */
 static void video_refresh_callback(const void* data, unsigned width, unsigned height, size_t pitch) {
     if (!data || !g_video_buffer) return;
     
     g_width = width;
     g_height = height;
-    g_video_frames_total++;
     
     /* Log only first few frames to avoid spam */
     if (g_log_frame_count < 5) {
@@ -671,200 +1491,146 @@ static void video_refresh_callback(const void* data, unsigned width, unsigned he
      * or any other dynamic resolution change by the libretro core. */
     size_t needed = (size_t)width * height;
     if (needed > g_video_buffer_capacity) {
+        video_lock();   /* the pipeline worker may be converting into it */
         uint32_t* new_buf = (uint32_t*)realloc(g_video_buffer, needed * sizeof(uint32_t));
         if (!new_buf) {
+            video_unlock();
             LOGE("Failed to reallocate video buffer for %ux%u", width, height);
+            g_video_pending = 0;
             return;
         }
         g_video_buffer = new_buf;
         g_video_buffer_capacity = needed;
+        g_video_buffer_sync.width = 0;
+        video_unlock();
         LOGI("Video buffer reallocated for %ux%u (%zu pixels)", width, height, needed);
     }
-    
-    if (g_pixel_format == RETRO_PIXEL_FORMAT_XRGB8888) {
-        /* XRGB8888: 32-bit per pixel, pitch is in bytes */
-        const uint8_t* src = (const uint8_t*)data;
-        
-        for (unsigned y = 0; y < height; y++) {
-            const uint32_t* row = (const uint32_t*)(src + y * pitch);
-            for (unsigned x = 0; x < width; x++) {
-                uint32_t pixel = row[x];
-                uint8_t r = (pixel >> 16) & 0xFF;
-                uint8_t g = (pixel >> 8) & 0xFF;
-                uint8_t b = pixel & 0xFF;
-                g_video_buffer[y * width + x] = process_pixel(r, g, b);
-            }
-        }
-    } else if (g_pixel_format == RETRO_PIXEL_FORMAT_RGB565) {
-        /* RGB565: 16-bit per pixel, pitch is in bytes */
-        const uint8_t* src = (const uint8_t*)data;
-        
-        for (unsigned y = 0; y < height; y++) {
-            const uint16_t* row = (const uint16_t*)(src + y * pitch);
-            for (unsigned x = 0; x < width; x++) {
-                uint16_t pixel = row[x];
-                /* RGB565: RRRRRGGGGGGBBBBB */
-                uint8_t r = (pixel >> 11) & 0x1F;
-                uint8_t g = (pixel >> 5) & 0x3F;
-                uint8_t b = pixel & 0x1F;
-                /* Expand to 8-bit with proper bit replication */
-                r = (r << 3) | (r >> 2);
-                g = (g << 2) | (g >> 4);
-                b = (b << 3) | (b >> 2);
-                g_video_buffer[y * width + x] = process_pixel(r, g, b);
-            }
-        }
-    } else if (g_pixel_format == RETRO_PIXEL_FORMAT_0RGB1555) {
-        /* 0RGB1555: 16-bit per pixel, pitch is in bytes */
-        const uint8_t* src = (const uint8_t*)data;
-        
-        for (unsigned y = 0; y < height; y++) {
-            const uint16_t* row = (const uint16_t*)(src + y * pitch);
-            for (unsigned x = 0; x < width; x++) {
-                uint16_t pixel = row[x];
-                uint8_t r = (pixel >> 10) & 0x1F;
-                uint8_t g = (pixel >> 5) & 0x1F;
-                uint8_t b = pixel & 0x1F;
-                r = (r << 3) | (r >> 2);
-                g = (g << 3) | (g >> 2);
-                b = (b << 3) | (b >> 2);
-                g_video_buffer[y * width + x] = process_pixel(r, g, b);
-            }
-        }
-    } else {
-        /* Unknown format - try to detect based on pitch */
-        LOGI("Unknown pixel format %d, trying auto-detect", g_pixel_format);
-        
-        /* If pitch suggests 32-bit pixels */
-        if (pitch >= width * 4) {
-            const uint8_t* src = (const uint8_t*)data;
-            for (unsigned y = 0; y < height; y++) {
-                const uint32_t* row = (const uint32_t*)(src + y * pitch);
-                for (unsigned x = 0; x < width; x++) {
-                    uint32_t pixel = row[x];
-                    uint8_t r = (pixel >> 16) & 0xFF;
-                    uint8_t g = (pixel >> 8) & 0xFF;
-                    uint8_t b = pixel & 0xFF;
-                    g_video_buffer[y * width + x] = process_pixel(r, g, b);
-                }
-            }
-        } else {
-            /* Assume 16-bit RGB565 */
-            const uint8_t* src = (const uint8_t*)data;
-            for (unsigned y = 0; y < height; y++) {
-                const uint16_t* row = (const uint16_t*)(src + y * pitch);
-                for (unsigned x = 0; x < width; x++) {
-                    uint16_t pixel = row[x];
-                    uint8_t r = (pixel >> 11) & 0x1F;
-                    uint8_t g = (pixel >> 5) & 0x3F;
-                    uint8_t b = pixel & 0x1F;
-                    r = (r << 3) | (r >> 2);
-                    g = (g << 2) | (g >> 4);
-                    b = (b << 3) | (b >> 2);
-                    g_video_buffer[y * width + x] = process_pixel(r, g, b);
-                }
-            }
-        }
+
+    g_video_pending_data  = data;
+    g_video_pending_pitch = pitch;
+    g_video_pending       = 1;
+#ifndef _WIN32
+    g_display_unfolded = -1;
+    /* Rendered into the back display slot (get_software_framebuffer)?
+     * Never with the pipeline on: the worker owns the slots then. */
+    if (!g_pipe_on) {
+        g_display_back_core = data == (const void*)g_display_slots[g_display_back].pixels &&
+                              pitch == (size_t)width * 2 &&
+                              needed <= g_display_slots[g_display_back].capacity;
     }
+#endif
 }
 
 static int g_audio_batch_count = 0;
-static int g_overflow_count = 0;
-
+static uint32_t g_logged_overflows = 0;  /* engine overflow count at the last log */
+static uint32_t g_logged_underruns = 0;  /* engine underrun count at the last log */
+
+/* The core may deliver a frame's audio in several batches (GB/GBC at
+ * 131 kHz does) or sample by sample.  Both only collect it in
+ * g_audio_buffer; run_core_frame() passes the whole frame on with
+ * flush_frame_audio().  Beyond AUDIO_BUFFER_SIZE frames per video frame
+ * the rest is dropped. */
 static size_t audio_sample_batch_callback(const int16_t* data, size_t frames) {
     if (!data || !g_audio_buffer) return frames;
-    
+    size_t room = (size_t)(AUDIO_BUFFER_SIZE - g_audio_samples);
+    size_t n = frames < room ? frames : room;
+    memcpy(g_audio_buffer + (size_t)g_audio_samples * 2, data, n * 2 * sizeof(int16_t));
+    g_audio_samples += (int)n;
+    return frames;
+}
+
+static void audio_sample_callback(int16_t left, int16_t right) {
+    if (!g_audio_buffer || g_audio_samples >= AUDIO_BUFFER_SIZE) return;
+    g_audio_buffer[g_audio_samples * 2] = left;
+    g_audio_buffer[g_audio_samples * 2 + 1] = right;
+    g_audio_samples++;
+}
+
+/* Pass the frame's audio on once retro_run() returns: raw to recording
+ * and replay, then volume-scaled in place — what
+ * yage_core_get_audio_buffer() returns — to the pull stream and the audio
+ * engine. */
+static void flush_frame_audio(void) {
+    size_t frames = (size_t)g_audio_samples;
+    if (frames == 0 || !g_audio_buffer) return;
+
+    /* Recording and replay take the core's samples before volume scaling */
+    yage_recorder_push_audio(g_audio_buffer, frames);
+    yage_replay_push_audio(g_audio_buffer, frames);
+
     size_t samples = frames * 2; /* Stereo */
-    if (samples > AUDIO_BUFFER_SIZE * 2) {
-        samples = AUDIO_BUFFER_SIZE * 2;
-    }
-    
+
     /* Apply volume scaling to the audio buffer */
     if (!g_audio_enabled || g_volume <= 0.0f) {
         /* Muted — fill with silence */
         memset(g_audio_buffer, 0, samples * sizeof(int16_t));
-    } else if (g_volume >= 1.0f) {
-        /* Full volume — straight copy */
-        memcpy(g_audio_buffer, data, samples * sizeof(int16_t));
-    } else {
-        /* Scale each sample by volume (fixed-point for speed) */
-        int vol_fp = (int)(g_volume * 256.0f); /* 8-bit fixed point */
-        for (size_t i = 0; i < samples; i++) {
-            g_audio_buffer[i] = (int16_t)((data[i] * vol_fp) >> 8);
-        }
+    } else if (g_volume < 1.0f) {
+        /* Scale by volume in 8-bit fixed point, SIMD where available */
+        int vol_fp = (int)(g_volume * 256.0f);
+        yage_ring_gain(g_audio_buffer, g_audio_buffer, samples, vol_fp);
     }
-    g_audio_samples = frames;
+    pull_stream_write(g_audio_buffer, frames);
 
 #ifdef __ANDROID__
+    /* OpenSL is opened with the first audio (see yage_core_load_rom) */
+    int output_ready = atomic_load_explicit(&g_sl_initialized, memory_order_acquire);
+#else
+    /* Desktop plays audio only once an output was started */
+    int output_ready = yage_audio_backend() >= 0;
+    if (!output_ready) return;
+#endif
+
     /* ================================================================
-     * PHASE 1: Initial rate detection (first 15 VIDEO frames)
-     * Use the reported sample rate from AV info as the primary source,
-     * validated against measured samples-per-video-frame.
-     *
-     * NOTE: The audio batch callback can fire multiple times per video
-     * frame (especially for GB/GBC at 131072 Hz).  We must count VIDEO
-     * frames (from video_refresh_callback) — not batch invocations —
-     * to get the correct samples-per-frame for classification.
+     * PHASE 1: Establish the core's sample rate
+     * The device always runs at AUDIO_DEVICE_RATE, so the rate only
+     * configures the engine's resampler.  A plausible reported rate from
+     * AV info is used straight away; a bogus one is replaced by the rate
+     * measured over the first 15 VIDEO frames.
      * ================================================================ */
     if (!g_rate_detected) {
-        g_rate_detection_samples += frames;
-        
-        /* Wait for at least 15 VIDEO frames (not batch callbacks) */
-        if (g_video_frames_total >= 15) {
-            double avg_spf = (g_video_frames_total > 0)
-                ? (double)g_rate_detection_samples / g_video_frames_total
-                : 0;
-            double measured_rate = classify_sample_rate(avg_spf);
-            
-            /* Use the reported rate from AV info if it's a known standard
-             * rate.  Fall back to measured rate only if reported looks bogus
-             * (e.g. 0 or extremely high/low). */
-            double use_rate;
-            if (g_reported_rate >= 8000.0 && g_reported_rate <= 192000.0) {
-                use_rate = g_reported_rate;
-                LOGI("Using reported sample rate: %.0f Hz (measured: %.1f samples/vframe → %.0f Hz)",
-                     use_rate, avg_spf, measured_rate);
-            } else {
-                use_rate = measured_rate;
-                LOGI("Reported rate %.0f Hz out of range, using measured: %.1f samples/vframe → %.0f Hz",
-                     g_reported_rate, avg_spf, use_rate);
-            }
+        if (plausible_sample_rate(g_reported_rate)) {
+            g_detected_rate = g_reported_rate;
+            LOGI("Using reported sample rate: %.0f Hz", g_detected_rate);
+        } else {
+            g_rate_detection_samples += frames;
             
-            g_detected_rate = use_rate;
-            init_opensl_audio(g_detected_rate);
-            g_rate_detected = 1;
-            g_frames_since_reinit = g_video_frames_total;
-            g_monitor_frames = g_video_frames_total;
-            g_monitor_samples = 0;
+            /* Wait for at least 15 VIDEO frames */
+            if (g_video_frames_total < 15) return;
+            double avg_spf = (double)g_rate_detection_samples / g_video_frames_total;
+            double measured = measured_sample_rate(avg_spf);
+            g_detected_rate = plausible_sample_rate(measured) ? measured : 32768.0;
+            LOGI("Reported rate %.0f Hz out of range, using measured: %.1f samples/vframe → %.0f Hz",
+                 g_reported_rate, avg_spf, g_detected_rate);
         }
-        return frames;
+        
+#ifdef __ANDROID__
+        /* Created once per game — rate changes only retune the resampler */
+        if (!output_ready) output_ready = init_opensl_audio(AUDIO_DEVICE_RATE) == 0;
+#endif
+        g_rate_detected = 1;
+        g_monitor_frames = g_video_frames_total;
+        g_monitor_samples = 0;
     }
     
     /* ================================================================
      * PHASE 2: Continuous rate monitoring (VIDEO-frame based)
-     * Every ~2 seconds (120 video frames), check if the game's audio
-     * rate has changed.  We count VIDEO frames — not batch callbacks —
-     * so GB/GBC games that fire multiple batches per frame are measured
-     * correctly.
+     * Every ~2 seconds (120 video frames), compare the measured rate with
+     * the one in use.  Only a gross mismatch (>5%) switches the
+     * resampler; ordinary clock drift is left to dynamic rate control.
      * ================================================================ */
     g_monitor_samples += frames;
     {
         int vframes_in_window = g_video_frames_total - g_monitor_frames;
-        int vframes_since_reinit = g_video_frames_total - g_frames_since_reinit;
         
         if (vframes_in_window >= 120) { /* Check every ~2 seconds */
-            double avg_spf = (vframes_in_window > 0)
-                ? (double)g_monitor_samples / vframes_in_window
-                : 0;
-            double new_rate = classify_sample_rate(avg_spf);
+            double avg_spf = (double)g_monitor_samples / vframes_in_window;
+            double measured = measured_sample_rate(avg_spf);
             
-            /* Only reinit if rate genuinely changed and we haven't just reinited */
-            if (new_rate != g_detected_rate && vframes_since_reinit > 180) {
+            if (plausible_sample_rate(measured) &&
+                (measured > g_detected_rate * 1.05 || measured < g_detected_rate * 0.95)) {
                 LOGI("Rate change detected: %.0f → %.0f Hz (%.1f samples/vframe)",
-                     g_detected_rate, new_rate, avg_spf);
-                g_detected_rate = new_rate;
-                init_opensl_audio(new_rate);
-                g_frames_since_reinit = g_video_frames_total;
+                     g_detected_rate, measured, avg_spf);
+                g_detected_rate = measured;
             }
             
             /* Reset window: snapshot current video frame count */
@@ -877,67 +1643,29 @@ static size_t audio_sample_batch_callback(const int16_t* data, size_t frames) {
     g_audio_batch_count++;
     if (g_audio_batch_count >= 60) {
         g_audio_batch_count = 0;
-        if (g_overflow_count > 0) {
-            LOGI("Audio: %zu frames/batch, overflows: %d, rate: %.0f",
-                 frames, g_overflow_count, g_detected_rate);
-            g_overflow_count = 0;
+        uint32_t underruns = 0, overflows = 0;
+        yage_audio_stats(&underruns, &overflows, NULL);
+        if (overflows != g_logged_overflows || underruns != g_logged_underruns) {
+            LOGI("Audio: %zu frames/frame, overflows: %u, underruns: %u, rate: %.0f",
+                 frames, overflows - g_logged_overflows, underruns - g_logged_underruns,
+                 g_detected_rate);
+            g_logged_overflows = overflows;
+            g_logged_underruns = underruns;
         }
     }
 
     /* ================================================================
-     * PHASE 3: Push audio to ring buffer with adaptive latency cap
-     * The max buffered amount is based on the DETECTED sample rate
-     * so high-rate games (65kHz) get more room than low-rate (32kHz).
-     * Target: ~50ms of buffered audio max.
+     * PHASE 3: Hand the frame to the audio engine, which resamples it to
+     * the device rate, steers the buffer fill with dynamic rate control
+     * and plays fast-forward back in real time (yage_audio.h).  Only the
+     * native frame loop runs faster than 1×.
      * ================================================================ */
-    if (atomic_load_explicit(&g_sl_initialized, memory_order_acquire)) {
-        int write_pos = atomic_load_explicit(&g_ring_write, memory_order_acquire);
-        int read_pos = atomic_load_explicit(&g_ring_read, memory_order_acquire);
-        int available = (write_pos - read_pos + RING_BUFFER_SIZE) & RING_BUFFER_MASK;
-        int free_space = RING_BUFFER_SIZE - 1 - available;
-        
-        /* Adaptive latency cap: ~50ms worth of stereo samples at current rate.
-         * 131072 Hz → 13107 samples max | 65536 Hz → 6554 | 32768 Hz → 3277 */
-        int max_buffered = (int)(g_detected_rate * 2.0 * 0.050); /* 50ms in stereo samples */
-        if (max_buffered < AUDIO_BUFFER_FRAMES * 2 * 4) {
-            max_buffered = AUDIO_BUFFER_FRAMES * 2 * 4; /* Floor: 4 callbacks */
-        }
-        
-        if (available > max_buffered) {
-            /* Too much buffered — skip ahead, keep ~25ms worth */
-            int keep = max_buffered / 2;
-            int excess = available - keep;
-            read_pos = (read_pos + excess) & RING_BUFFER_MASK;
-            atomic_store_explicit(&g_ring_read, read_pos, memory_order_release);
-            available = keep;
-            free_space = RING_BUFFER_SIZE - 1 - available;
-        }
-        
-        /* If buffer is full, advance read pointer to make room */
-        if ((int)samples > free_space) {
-            int need = samples - free_space + 128;
-            int new_read = (read_pos + need) & RING_BUFFER_MASK;
-            atomic_store_explicit(&g_ring_read, new_read, memory_order_release);
-            g_overflow_count++;
-        }
-        
-        /* Write volume-scaled samples to ring buffer */
-        for (size_t i = 0; i < samples; i++) {
-            g_ring_buffer[write_pos] = g_audio_buffer[i];
-            write_pos = (write_pos + 1) & RING_BUFFER_MASK;
-        }
-        
-        /* Update write position atomically */
-        atomic_store_explicit(&g_ring_write, write_pos, memory_order_release);
-    }
+    double speed = 1.0;
+#ifndef _WIN32
+    if (atomic_load_explicit(&g_floop_running, memory_order_relaxed))
+        speed = atomic_load_explicit(&g_floop_speed_pct, memory_order_relaxed) / 100.0;
 #endif
-    
-    return frames;
-}
-
-static void audio_sample_callback(int16_t left, int16_t right) {
-    (void)left;
-    (void)right;
+    if (output_ready) yage_audio_push(g_audio_buffer, frames, g_detected_rate, speed);
 }
 
 static void input_poll_callback(void) {
@@ -1081,13 +1809,171 @@ struct retro_variable {
     const char *value;
 };
 
+#ifndef _WIN32
+/* Grow a display slot the calling thread writes to hold `pixels` 32-bit
+ * pixels.  Growing drops its contents.  Returns 0 on success, -1 if out
+ * of memory. */
+static int display_slot_reserve(YageDisplaySlot* slot, size_t pixels) {
+    if (pixels <= slot->capacity) return 0;
+    uint32_t* buf = (uint32_t*)realloc(slot->pixels, pixels * sizeof(uint32_t));
+    if (!buf) return -1;
+    slot->pixels = buf;
+    slot->capacity = pixels;
+    slot->width = 0;
+    return 0;
+}
+#endif
+
+/* Make room for frames of up to width × height before the core delivers
+ * one, so a resolution change does not reallocate on the frame path:
+ * g_video_buffer, the dirty-tracking shadow, the back display slot (the
+ * others grow as they come back to the writer) and the desktop texture's
+ * conversion buffer.  ROM load, SET_GEOMETRY and SET_SYSTEM_AV_INFO;
+ * thread that drives retro_run() only. */
+static void presize_video_buffers(unsigned width, unsigned height) {
+    size_t needed = (size_t)width * height;
+    if (needed == 0) return;
+    if (needed > g_video_buffer_capacity && g_video_buffer) {
+        uint32_t* new_buf = (uint32_t*)realloc(g_video_buffer, needed * sizeof(uint32_t));
+        if (new_buf) {
+            g_video_buffer = new_buf;
+            g_video_buffer_capacity = needed;
+            LOGI("Video buffer pre-allocated for %ux%u (%zu pixels)", width, height, needed);
+        }
+    }
+    /* 4 bytes per source pixel covers every pixel format */
+    if (!ensure_dirty_tracking(needed * 4, (int)height)) {
+        LOGE("Failed to pre-allocate frame shadow for %ux%u", width, height);
+    }
+#ifndef _WIN32
+    display_slot_reserve(&g_display_slots[g_display_back], needed);
+#ifndef __ANDROID__
+    if ((int)needed > atomic_load_explicit(&g_tex_reserve, memory_order_relaxed)) {
+        atomic_store_explicit(&g_tex_reserve, (int)needed, memory_order_relaxed);
+    }
+#endif
+#endif
+}
+
+/* Adopt the core's timing: frame pacing of the native loop, the recorder
+ * and replay formats, and (Android) the OpenSL output rate, which is
+ * re-detected when the sample rate changes at runtime. */
+static void apply_av_timing(const struct retro_system_timing* timing) {
+    if (timing->fps >= 1.0 && timing->fps <= 1000.0) {
+        g_av_fps = timing->fps;
+#ifndef _WIN32
+        atomic_store_explicit(&g_floop_frame_ns, (int)(1e9 / timing->fps + 0.5),
+                              memory_order_relaxed);
+#endif
+    }
+    if (timing->sample_rate > 0.0) g_av_sample_rate = timing->sample_rate;
+    if (timing->sample_rate != g_reported_rate) {
+        g_reported_rate = timing->sample_rate;
+        reset_rate_detection();
+    }
+}
+
+#ifdef __ANDROID__
+static int native_window_format(void);
+
+/* Configure an attached ANativeWindow for the new base size ahead of the
+ * first frame at that size */
+static void presize_native_window(unsigned width, unsigned height) {
+    pthread_mutex_lock(&g_nw_mutex);
+    if (g_native_window && width > 0 && height > 0) {
+        DisplayPost post;
+        display_post(&post);
+        int ow = (int)width * post.factor, oh = (int)height * post.factor;
+        int fmt = native_window_format();
+        if (ow != g_nw_configured_w || oh != g_nw_configured_h || fmt != g_nw_configured_fmt) {
+            ANativeWindow_setBuffersGeometry(g_native_window, ow, oh, fmt);
+            g_nw_configured_w = ow;
+            g_nw_configured_h = oh;
+            g_nw_configured_fmt = fmt;
+            g_nw_valid = 0;
+        }
+    }
+    pthread_mutex_unlock(&g_nw_mutex);
+}
+#endif
+
+/* New geometry from the core (SET_GEOMETRY: base size only;
+ * SET_SYSTEM_AV_INFO: max size too).  g_width / g_height keep following
+ * the frames actually delivered. */
+static void apply_geometry(const struct retro_game_geometry* geom, int with_max) {
+    unsigned w = geom->base_width, h = geom->base_height;
+    if (with_max && geom->max_width > w)  w = geom->max_width;
+    if (with_max && geom->max_height > h) h = geom->max_height;
+    video_lock();
+    presize_video_buffers(w, h);
+#ifdef __ANDROID__
+    presize_native_window(geom->base_width, geom->base_height);
+#endif
+    video_unlock();
+}
+
+/* RETRO_ENVIRONMENT_GET_CURRENT_SOFTWARE_FRAMEBUFFER.  While the frame
+ * loop shows the core's frames as they are (g_video_passthrough, slots as
+ * the target), the core renders straight into the back display slot and
+ * publish_display_slot() hands that slot over without converting.  In
+ * every other case - including while a converter rebuild is pending, as
+ * the active format may be about to change - the core keeps rendering
+ * into its own buffer. */
+static bool get_software_framebuffer(struct retro_framebuffer* fb) {
+#ifndef _WIN32
+    if (!fb || fb->width == 0 || fb->height == 0) return false;
+    /* Only the frame loop thread owns the back slot (the pipeline worker
+     * does while it runs) */
+    if (!atomic_load_explicit(&g_floop_running, memory_order_relaxed) ||
+        !pthread_equal(pthread_self(), g_frame_thread) || g_pipe_on || !g_video_passthrough ||
+        atomic_load_explicit(&g_video_conv_dirty, memory_order_acquire)) {
+        return false;
+    }
+#ifdef __ANDROID__
+    if (g_native_window) return false;   /* frames go to the window, not the slots */
+#endif
+    YageDisplaySlot* slot = &g_display_slots[g_display_back];
+    if (display_slot_reserve(slot, (size_t)fb->width * fb->height) != 0) return false;
+    slot->width = 0;   /* the core owns the contents until they are published */
+    fb->data = slot->pixels;
+    fb->pitch = (size_t)fb->width * 2;
+    fb->format = RETRO_PIXEL_FORMAT_RGB565;
+    fb->memory_flags = RETRO_MEMORY_TYPE_CACHED;
+    return true;
+#else
+    (void)fb;
+    return false;
+#endif
+}
+
 static bool environment_callback(unsigned cmd, void* data) {
     switch (cmd) {
+        case 32: { /* RETRO_ENVIRONMENT_SET_SYSTEM_AV_INFO */
+            if (!data) return false;
+            const struct retro_system_av_info* info = (const struct retro_system_av_info*)data;
+            LOGI("AV info changed: %ux%u (max %ux%u), fps=%.4f, sample_rate=%.0f",
+                 info->geometry.base_width, info->geometry.base_height,
+                 info->geometry.max_width, info->geometry.max_height,
+                 info->timing.fps, info->timing.sample_rate);
+            apply_av_timing(&info->timing);
+            apply_geometry(&info->geometry, 1);
+            return true;
+        }
+        case 37: /* RETRO_ENVIRONMENT_SET_GEOMETRY */
+            if (!data) return false;
+            apply_geometry((const struct retro_game_geometry*)data, 0);
+            return true;
+        case 47:      /* RETRO_ENVIRONMENT_GET_AUDIO_VIDEO_ENABLE (no experimental flag) */
+        case 0x1002F: /* RETRO_ENVIRONMENT_GET_AUDIO_VIDEO_ENABLE (with experimental flag) */
+            if (!data) return false;
+            *(int*)data = g_av_enable;
+            return true;
         case 10: /* RETRO_ENVIRONMENT_SET_PIXEL_FORMAT */
             if (data) {
                 int requested = *(int*)data;
                 LOGI("Core requested pixel format: %d", requested);
                 g_pixel_format = requested;
+                invalidate_video_converter();
             }
             return true;
         case 3: /* RETRO_ENVIRONMENT_GET_CAN_DUPE */
@@ -1137,8 +2023,9 @@ static bool environment_callback(unsigned cmd, void* data) {
         case 0x10024: /* RETRO_ENVIRONMENT_SET_MEMORY_MAPS (with experimental flag) */
             handle_set_memory_maps(data);
             return true;
-        case 40: /* RETRO_ENVIRONMENT_GET_INPUT_BITMASKS */
-            return true;
+        case 40:      /* RETRO_ENVIRONMENT_GET_CURRENT_SOFTWARE_FRAMEBUFFER (no experimental flag) */
+        case 0x10028: /* RETRO_ENVIRONMENT_GET_CURRENT_SOFTWARE_FRAMEBUFFER (with experimental flag) */
+            return get_software_framebuffer((struct retro_framebuffer*)data);
         default: {
             /* ── Non-mGBA cores (NES/SNES/Genesis) ──
              * These cores use newer libretro API features. Commands are split
@@ -1217,7 +2104,11 @@ YageCore* yage_core_create(void) {
         free(core);
         return NULL;
     }
+
+    /* Pull stream ring — first core only, then kept (see g_pull) */
+    if (!g_pull) g_pull = yage_ring_create(PULL_RING_FRAMES);
     
+    invalidate_video_converter();
     return core;
 }
 
@@ -1323,6 +2214,8 @@ void yage_core_destroy(YageCore* core) {
      * pointer, rewind buffers, and rcheevos state. */
 #ifndef _WIN32
     yage_frame_loop_stop(core);
+    yage_scaler_shutdown();
+    blend_free();
 #endif
 
     /* Clear the global pointer so callbacks don't use a stale core */
@@ -1335,6 +2228,18 @@ void yage_core_destroy(YageCore* core) {
     g_keys = 0;
 #endif
     
+    /* Finish any recording while the core's buffers still exist */
+    yage_record_stop(core);
+    yage_replay_configure(0, 0, 0);
+    yage_frame_export_stop(core);
+#ifndef _WIN32
+    /* Screenshot threads call back into the host; let them finish */
+    while (atomic_load(&g_shot_inflight) > 0) {
+        struct timespec ts = { 0, 1000000 };
+        nanosleep(&ts, NULL);
+    }
+#endif
+
     /* Free rewind buffer */
     yage_core_rewind_deinit(core);
     
@@ -1342,6 +2247,10 @@ void yage_core_destroy(YageCore* core) {
     shutdown_opensl_audio();
 #endif
     
+    /* The core's framebuffer goes away with the game */
+    g_video_pending = 0;
+    g_video_pending_data = NULL;
+
     if (core->game_loaded && core->retro_unload_game) {
         core->retro_unload_game();
     }
@@ -1367,6 +2276,28 @@ void yage_core_destroy(YageCore* core) {
         free(g_audio_buffer);
         g_audio_buffer = NULL;
     }
+    if (g_pixel_lut) {
+        free(g_pixel_lut);
+        g_pixel_lut = NULL;
+    }
+    free(g_src_shadow);
+    g_src_shadow = NULL;
+    g_src_shadow_capacity = 0;
+    free(g_capture_rgba);
+    g_capture_rgba = NULL;
+    g_capture_rgba_capacity = 0;
+    free(g_row_serial);
+    g_row_serial = NULL;
+    g_row_serial_capacity = 0;
+    g_shadow_height = 0;
+    g_video_force_full = 1;
+    g_shadow_convert = NULL;
+    g_shadow_table = NULL;
+    g_video_buffer_sync.width = 0;
+    g_convert_row = NULL;
+    g_convert_table = NULL;
+    /* Desktop output thread (Android's went with OpenSL above) */
+    yage_audio_close();
     
     free(core);
 }
@@ -1429,6 +2360,7 @@ int yage_core_load_rom(YageCore* core, const char* path) {
     g_color_correction_enabled = (core->platform == YAGE_PLATFORM_GB ||
                                   core->platform == YAGE_PLATFORM_GBC ||
                                   core->platform == YAGE_PLATFORM_GBA) ? 1 : 0;
+    invalidate_video_converter();
 
     /* Mark variables dirty so the core re-reads SGB border setting */
     g_variables_dirty = 1;
@@ -1485,49 +2417,36 @@ int yage_core_load_rom(YageCore* core, const char* path) {
         g_width = av_info.geometry.base_width;
         g_height = av_info.geometry.base_height;
         reported_sample_rate = av_info.timing.sample_rate;
-        g_reported_rate = reported_sample_rate;  /* Store for audio init */
+        apply_av_timing(&av_info.timing);   /* also stores the rate for audio init */
         LOGI("AV Info: %ux%u, fps=%.2f, reported_sample_rate=%.0f", 
              g_width, g_height, av_info.timing.fps, reported_sample_rate);
 
-        /* Pre-allocate video buffer for the reported resolution.
+        /* Pre-allocate buffers for the reported resolution.
          * SGB-enhanced GB games report 256x224 which is larger than the
          * default GBA 240x160 allocation.  Using max_width/max_height
          * when available ensures we cover any resolution the core may use. */
-        unsigned max_w = av_info.geometry.max_width  ? av_info.geometry.max_width  : g_width;
-        unsigned max_h = av_info.geometry.max_height ? av_info.geometry.max_height : g_height;
-        size_t needed = (size_t)max_w * max_h;
-        if (needed > g_video_buffer_capacity && g_video_buffer) {
-            uint32_t* new_buf = (uint32_t*)realloc(g_video_buffer, needed * sizeof(uint32_t));
-            if (new_buf) {
-                g_video_buffer = new_buf;
-                g_video_buffer_capacity = needed;
-                LOGI("Video buffer pre-allocated for %ux%u (%zu pixels)", max_w, max_h, needed);
-            }
-        }
+        apply_geometry(&av_info.geometry, 1);
     }
     
 #ifdef __ANDROID__
     /* Shut down previous audio completely */
     shutdown_opensl_audio();
+    g_logged_overflows = 0;
+    g_logged_underruns = 0;
+    g_log_frame_count = 0;
+#endif
     
     /* Reset ALL rate detection & monitoring state for the new game */
-    g_rate_detection_samples = 0;
-    g_rate_detected = 0;
-    g_detected_rate = 0;
-    g_video_frames_total = 0;
-    g_monitor_frames = 0;
-    g_monitor_samples = 0;
-    g_frames_since_reinit = 0;
-    g_audio_started = 0;
+    reset_rate_detection();
     g_audio_batch_count = 0;
-    g_overflow_count = 0;
-    g_log_frame_count = 0;
+    pull_stream_reset();
     
+#ifdef __ANDROID__
     /* Always defer OpenSL init until audio is actively being produced
      * (during the frame loop).  Initializing eagerly here creates an
      * AudioTrack that sits idle — Android's audio policy kills idle
      * players before the frame loop has a chance to feed real samples. */
-    LOGI("Audio deferred: will init after 15 video frames (reported rate: %.0f Hz)",
+    LOGI("Audio deferred: will init on the first audio batch (reported rate: %.0f Hz)",
          reported_sample_rate);
 #endif
     
@@ -1563,8 +2482,8 @@ void yage_core_reset(YageCore* core) {
 
 void yage_core_run_frame(YageCore* core) {
     if (!core || !core->game_loaded || !core->retro_run) return;
-    g_audio_samples = 0;
-    core->retro_run();
+    run_core_frame(core, 1);   /* the caller presents every frame */
+    export_presented_frame();
 }
 
 void yage_core_set_keys(YageCore* core, uint32_t keys) {
@@ -1583,9 +2502,46 @@ void yage_core_set_keys(YageCore* core, uint32_t keys) {
 
 uint32_t* yage_core_get_video_buffer(YageCore* core) {
     (void)core;
+#ifndef _WIN32
+    /* While the native frame loop runs it owns retro_run() and converts at
+     * each display interval; only the retro_run() thread may flush.  Hand
+     * out whatever it presented last. */
+    if (atomic_load_explicit(&g_floop_running, memory_order_acquire)) {
+        if (atomic_load_explicit(&g_display_via_slots, memory_order_relaxed)) {
+            uint32_t* pixels = NULL;
+#ifndef __ANDROID__
+            /* The texture owns the slots while attached (see
+             * yage_frame_loop_acquire_display) */
+            pthread_mutex_lock(&g_tex_slot_mutex);
+            if (!desktop_texture_attached())
+#endif
+            {
+                /* Post-processed slots do not match the raw frame */
+                YageDisplaySlot* slot = acquire_display_slot();
+                if (slot->width > 0 && slot->post == 0) {
+                    g_video_read_format = slot->format;
+                    pixels = slot->pixels;
+                }
+            }
+#ifndef __ANDROID__
+            pthread_mutex_unlock(&g_tex_slot_mutex);
+#endif
+            if (pixels) return pixels;
+        }
+        g_video_read_format = atomic_load_explicit(&g_out_format_pub, memory_order_relaxed);
+        return g_video_buffer;
+    }
+#endif
+    video_flush_pending();
+    g_video_read_format = g_out_format;
     return g_video_buffer;
 }
 
+int yage_core_get_video_format(YageCore* core) {
+    (void)core;
+    return g_video_read_format;
+}
+
 int yage_core_get_width(YageCore* core) {
     (void)core;
     return g_width;
@@ -1596,6 +2552,30 @@ int yage_core_get_height(YageCore* core) {
     return g_height;
 }
 
+int yage_core_set_output_format(YageCore* core, int format) {
+    (void)core;
+    if (format < YAGE_OUTPUT_RGBA8888 || format > YAGE_OUTPUT_INDEX8) return -1;
+    if (format == g_output_format) return 0;
+    g_output_format = format;
+    invalidate_video_converter();
+    LOGI("Output format set to %d", format);
+    return 0;
+}
+
+int yage_core_get_output_format(YageCore* core) {
+    (void)core;
+    return g_output_format;
+}
+
+int yage_core_get_output_bytes_per_pixel(YageCore* core) {
+    (void)core;
+#ifndef _WIN32
+    return yage_pixconv_output_bpp(atomic_load_explicit(&g_out_format_pub, memory_order_relaxed));
+#else
+    return yage_pixconv_output_bpp(g_out_format_pub);
+#endif
+}
+
 int16_t* yage_core_get_audio_buffer(YageCore* core) {
     (void)core;
     return g_audio_buffer;
@@ -1753,22 +2733,115 @@ int yage_core_load_sram(YageCore* core, const char* path) {
     }
 }
 
-/*
- * Audio Volume Control
- */
+/*
+ * Audio Volume Control
+ */
+
+void yage_core_set_volume(YageCore* core, float volume) {
+    (void)core;
+    if (volume < 0.0f) volume = 0.0f;
+    if (volume > 1.0f) volume = 1.0f;
+    g_volume = volume;
+    LOGI("Volume set to %.2f", volume);
+}
+
+void yage_core_set_audio_enabled(YageCore* core, int enabled) {
+    (void)core;
+    g_audio_enabled = enabled ? 1 : 0;
+    LOGI("Audio %s", enabled ? "enabled" : "disabled");
+}
+
+int32_t yage_audio_output_start(YageCore* core, int32_t backend, const char* target) {
+    (void)core;
+#ifdef __ANDROID__
+    (void)backend; (void)target;
+    return -1;  /* OpenSL ES output is managed by the wrapper */
+#else
+    if (backend == YAGE_AUDIO_BACKEND_EXTERNAL) return -1;
+    if (yage_audio_open(backend, target, AUDIO_DEVICE_RATE, AUDIO_BUFFER_FRAMES) != 0) {
+        LOGE("Failed to start audio output (backend %d)", backend);
+        return -1;
+    }
+    g_logged_overflows = 0;
+    g_logged_underruns = 0;
+    LOGI("Audio output started: backend %d at %.0f Hz, %d-frame periods",
+         yage_audio_backend(), AUDIO_DEVICE_RATE, AUDIO_BUFFER_FRAMES);
+    return 0;
+#endif
+}
+
+void yage_audio_output_stop(YageCore* core) {
+    (void)core;
+#ifndef __ANDROID__
+    if (yage_audio_backend() < 0) return;
+    yage_audio_close();
+    LOGI("Audio output stopped");
+#endif
+}
 
-void yage_core_set_volume(YageCore* core, float volume) {
+int32_t yage_audio_output_get_backend(YageCore* core) {
     (void)core;
-    if (volume < 0.0f) volume = 0.0f;
-    if (volume > 1.0f) volume = 1.0f;
-    g_volume = volume;
-    LOGI("Volume set to %.2f", volume);
+    return yage_audio_backend();
 }
 
-void yage_core_set_audio_enabled(YageCore* core, int enabled) {
+void yage_audio_output_get_stats(YageCore* core, uint32_t* underruns,
+                                 uint32_t* overflows, int32_t* buffered_frames) {
     (void)core;
-    g_audio_enabled = enabled ? 1 : 0;
-    LOGI("Audio %s", enabled ? "enabled" : "disabled");
+    yage_audio_stats(underruns, overflows, buffered_frames);
+}
+
+/* Consumer: apply a pending new-game flush */
+static void pull_stream_flush(void) {
+#ifndef _WIN32
+    unsigned flush = atomic_exchange(&g_pull_flush, 0);
+#else
+    uint32_t flush = g_pull_flush;
+    g_pull_flush = 0;
+#endif
+    if (flush > 0) yage_ring_skip(g_pull, flush);
+}
+
+int32_t yage_audio_read(YageCore* core, int16_t* dst, int32_t max_frames) {
+    (void)core;
+    if (!dst || max_frames <= 0) return 0;
+#ifndef _WIN32
+    atomic_store_explicit(&g_pull_on, 1, memory_order_relaxed);
+#else
+    g_pull_on = 1;
+#endif
+    pull_stream_flush();
+    return (int32_t)yage_ring_read(g_pull, dst, (size_t)max_frames);
+}
+
+int32_t yage_audio_read_available(YageCore* core) {
+    (void)core;
+    pull_stream_flush();
+    return (int32_t)yage_ring_available(g_pull);
+}
+
+double yage_audio_read_rate(YageCore* core) {
+    (void)core;
+    return g_rate_detected ? g_detected_rate : g_reported_rate;
+}
+
+void yage_audio_output_get_telemetry(YageCore* core, YageAudioStats* out) {
+    (void)core;
+    if (!out) return;
+    yage_audio_telemetry(out);
+    out->core_rate = g_rate_detected ? g_detected_rate : g_reported_rate;
+#ifndef _WIN32
+    out->pull_dropped = atomic_load_explicit(&g_pull_dropped, memory_order_relaxed);
+#else
+    out->pull_dropped = g_pull_dropped;
+#endif
+}
+
+void yage_audio_output_set_fast_forward(YageCore* core, int32_t mode) {
+    (void)core;
+    if (mode < YAGE_AUDIO_FF_AUTO || mode > YAGE_AUDIO_FF_DECIMATE) mode = YAGE_AUDIO_FF_AUTO;
+    yage_audio_set_fast_forward(mode);
+    LOGI("Fast-forward audio: %s", mode == YAGE_AUDIO_FF_STRETCH ? "stretch" :
+         mode == YAGE_AUDIO_FF_DECIMATE ? "decimate" : "auto");
 }
 
 /*
@@ -1781,22 +2854,63 @@ void yage_core_set_color_palette(YageCore* core, int palette_index,
                                   uint32_t color0, uint32_t color1,
                                   uint32_t color2, uint32_t color3) {
     (void)core;
+    /* INDEX8 frames keep their shade numbers across a colour change:
+     * only the recolour at upload has to pick the new shades up */
+#ifndef _WIN32
+    int was_enabled = atomic_exchange_explicit(&g_palette_enabled, palette_index >= 0,
+                                               memory_order_relaxed);
+#else
+    int was_enabled = g_palette_enabled;
+    g_palette_enabled = palette_index >= 0;
+#endif
+    int recolour_only = was_enabled && palette_index >= 0 &&
+                        g_output_format == YAGE_OUTPUT_INDEX8;
     if (palette_index < 0) {
-        g_palette_enabled = 0;
         LOGI("Color palette disabled (using original colors)");
     } else {
-        g_palette_enabled = 1;
         /* Convert from ARGB to ABGR (RGBA in little-endian memory for Flutter) */
         #define ARGB_TO_ABGR(c) ( ((c) & 0xFF00FF00) | (((c) & 0x00FF0000) >> 16) | (((c) & 0x000000FF) << 16) )
-        g_palette_colors[0] = ARGB_TO_ABGR(color0);
-        g_palette_colors[1] = ARGB_TO_ABGR(color1);
-        g_palette_colors[2] = ARGB_TO_ABGR(color2);
-        g_palette_colors[3] = ARGB_TO_ABGR(color3);
+        uint32_t colors[4] = {
+            ARGB_TO_ABGR(color0), ARGB_TO_ABGR(color1),
+            ARGB_TO_ABGR(color2), ARGB_TO_ABGR(color3)
+        };
         #undef ARGB_TO_ABGR
+        /* Staged only: the converter picks them up on its own thread when
+         * it rebuilds (requested below) */
+        for (int i = 0; i < 4; i++) {
+#ifndef _WIN32
+            atomic_store_explicit(&g_index_palette[i], colors[i], memory_order_relaxed);
+#else
+            g_index_palette[i] = colors[i];
+#endif
+        }
+#ifndef _WIN32
+        atomic_fetch_add_explicit(&g_index_palette_gen, 1, memory_order_release);
+#else
+        g_index_palette_gen++;
+#endif
         LOGI("Color palette set: #%06X #%06X #%06X #%06X",
              color0 & 0xFFFFFF, color1 & 0xFFFFFF,
              color2 & 0xFFFFFF, color3 & 0xFFFFFF);
     }
+    if (recolour_only) {
+#if !defined(_WIN32) && !defined(__ANDROID__)
+        desktop_texture_notify();   /* re-upload the shown frame in the new colours */
+#endif
+        return;
+    }
+    invalidate_video_converter();
+}
+
+int32_t yage_core_get_output_palette(YageCore* core, uint32_t* colors) {
+    (void)core;
+    if (colors) index_palette_load(colors);
+#ifndef _WIN32
+    int enabled = atomic_load_explicit(&g_palette_enabled, memory_order_relaxed);
+#else
+    int enabled = g_palette_enabled;
+#endif
+    return g_output_format == YAGE_OUTPUT_INDEX8 && enabled;
 }
 
 /*
@@ -2063,10 +3177,25 @@ int yage_core_get_memory_size(YageCore* core, int32_t region_id) {
 
 #ifdef __ANDROID__
 
-/* Blit g_video_buffer → ANativeWindow.  Protected by g_nw_mutex so
- * nativeReleaseSurface never releases while we're blitting (use-after-free).
- * Returns 0 on success, -1 on failure. */
-static int blit_to_native_window(void) {
+/* HAL_PIXEL_FORMAT_BGRA_8888 — accepted by Surface but not exposed as a
+ * WINDOW_FORMAT_* constant in the NDK headers */
+#define YAGE_WINDOW_FORMAT_BGRA_8888 5
+
+/* ANativeWindow buffer format matching the active output layout */
+static int native_window_format(void) {
+    switch (g_out_format) {
+        case YAGE_OUTPUT_RGB565:   return WINDOW_FORMAT_RGB_565;
+        case YAGE_OUTPUT_BGRA8888: return YAGE_WINDOW_FORMAT_BGRA_8888;
+        default:                   return WINDOW_FORMAT_RGBA_8888;
+    }
+}
+
+/* Blit the w × h frame in g_video_buffer → ANativeWindow.  Protected by
+ * g_nw_mutex so nativeReleaseSurface never releases while we're blitting
+ * (use-after-free).  Returns 0 on success, 1 if the window already shows
+ * this frame (nothing posted), -1 on failure. */
+static int blit_to_native_window(int w, int h) {
+    video_flush_pending();
     pthread_mutex_lock(&g_nw_mutex);
     ANativeWindow* win = g_native_window;
     if (!win || !g_video_buffer) {
@@ -2074,43 +3203,108 @@ static int blit_to_native_window(void) {
         return -1;
     }
 
-    int w = g_width;
-    int h = g_height;
     if (w <= 0 || h <= 0) {
         pthread_mutex_unlock(&g_nw_mutex);
         return -1;
     }
 
+    /* With post-processing the window holds the blended / scaled frame */
+    DisplayPost post;
+    display_post(&post);
+    int f = post.factor;
+    int ow = w * f, oh = h * f;
+    const uint32_t* pixels = g_video_buffer;
+    uint32_t serial = g_video_buffer_sync.serial;
+    if (post.key != 0) {
+        pixels = display_source(&post, w, h, &serial);
+        if (!pixels) {
+            pthread_mutex_unlock(&g_nw_mutex);
+            return -1;
+        }
+    }
+
     /* Reconfigure buffer geometry when the resolution changes
-     * (e.g. GB 160×144 → SGB 256×224). */
-    if (w != g_nw_configured_w || h != g_nw_configured_h) {
-        ANativeWindow_setBuffersGeometry(win, w, h, WINDOW_FORMAT_RGBA_8888);
-        g_nw_configured_w = w;
-        g_nw_configured_h = h;
-        LOGI("ANativeWindow geometry set to %dx%d", w, h);
+     * (e.g. GB 160×144 → SGB 256×224) or the output format does. */
+    int fmt = native_window_format();
+    if (ow != g_nw_configured_w || oh != g_nw_configured_h || fmt != g_nw_configured_fmt) {
+        ANativeWindow_setBuffersGeometry(win, ow, oh, fmt);
+        g_nw_configured_w = ow;
+        g_nw_configured_h = oh;
+        g_nw_configured_fmt = fmt;
+        g_nw_valid = 0;
+        LOGI("ANativeWindow geometry set to %dx%d (format %d)", ow, oh, fmt);
+    }
+    if (post.key != g_nw_post) {
+        g_nw_post = post.key;
+        g_nw_valid = 0;
+    }
+    /* INDEX8 frames are recoloured here, so a palette change redraws */
+    uint32_t pal[4];
+    if (g_out_format == YAGE_OUTPUT_INDEX8) {
+        uint32_t gen = atomic_load_explicit(&g_index_palette_gen, memory_order_acquire);
+        if (gen != g_nw_palette_gen) {
+            g_nw_palette_gen = gen;
+            g_nw_valid = 0;
+        }
+        index_palette_load(pal);
+    }
+
+    /* Only the rows converted since the last post need to reach the
+     * window; nothing changed means nothing to post. */
+    int top = 0, bottom = h - 1;
+    if (g_nw_valid) {
+        if (present_dirty_rows(&post, g_nw_serial, h, &top, &bottom) == 0) {
+            pthread_mutex_unlock(&g_nw_mutex);
+            return 1;
+        }
+        if (f > 1) {
+            if (top > 0) top--;           /* filters read neighbouring rows */
+            if (bottom < h - 1) bottom++;
+        }
     }
 
+    /* The window may grow the dirty rect (e.g. when the queued buffer
+     * holds an older frame), so copy whatever bounds it hands back. */
+    ARect dirty = { 0, top * f, ow, (bottom + 1) * f };
     ANativeWindow_Buffer buf;
-    if (ANativeWindow_lock(win, &buf, NULL) != 0) {
+    if (ANativeWindow_lock(win, &buf, &dirty) != 0) {
         pthread_mutex_unlock(&g_nw_mutex);
         return -1;
     }
-
-    uint32_t* dst = (uint32_t*)buf.bits;
-    uint32_t* src = g_video_buffer;
-
-    if (buf.stride == w) {
+    if (dirty.top < 0) dirty.top = 0;
+    if (dirty.bottom > oh) dirty.bottom = oh;
+
+    uint8_t* dst = (uint8_t*)buf.bits;
+    const uint8_t* src = (const uint8_t*)pixels;
+    size_t row_bytes = (size_t)w * g_out_bpp;
+
+    if (f > 1) {
+        /* Scale straight into the window buffer, whole source rows */
+        if (dirty.bottom > dirty.top) {
+            yage_scaler_run(post.scaler, f, pixels, w, h, (uint32_t*)buf.bits, buf.stride,
+                            dirty.top / f, (dirty.bottom + f - 1) / f);
+        }
+    } else if (g_out_format == YAGE_OUTPUT_INDEX8) {
+        /* Recolour shade indices into the RGBA window buffer */
+        for (int y = dirty.top; y < dirty.bottom; y++) {
+            yage_pixconv_row_index8_expand(dst + (size_t)y * buf.stride * 4,
+                                           src + (size_t)y * row_bytes, w, pal);
+        }
+    } else if (buf.stride == w) {
         /* Fast path: no stride mismatch — single memcpy */
-        memcpy(dst, src, (size_t)w * h * sizeof(uint32_t));
+        memcpy(dst + (size_t)dirty.top * row_bytes, src + (size_t)dirty.top * row_bytes,
+               row_bytes * (dirty.bottom - dirty.top));
     } else {
-        /* Stride-aware row-by-row copy */
-        for (int y = 0; y < h; y++) {
-            memcpy(dst + y * buf.stride, src + y * w,
-                   (size_t)w * sizeof(uint32_t));
+        /* Stride-aware row-by-row copy (stride is in pixels) */
+        for (int y = dirty.top; y < dirty.bottom; y++) {
+            memcpy(dst + (size_t)y * buf.stride * g_out_bpp, src + (size_t)y * row_bytes,
+                   row_bytes);
         }
     }
 
     ANativeWindow_unlockAndPost(win);
+    g_nw_serial = serial;
+    g_nw_valid = 1;
     pthread_mutex_unlock(&g_nw_mutex);
     return 0;
 }
@@ -2134,10 +3328,12 @@ Java_com_yourmateapps_retropal_YageTextureBridge_nativeSetSurface(
     if (surface) {
         g_native_window = ANativeWindow_fromSurface(env, surface);
         if (g_native_window) {
+            g_nw_configured_fmt = native_window_format();
             ANativeWindow_setBuffersGeometry(
-                g_native_window, g_width, g_height, WINDOW_FORMAT_RGBA_8888);
+                g_native_window, g_width, g_height, g_nw_configured_fmt);
             g_nw_configured_w = g_width;
             g_nw_configured_h = g_height;
+            g_nw_valid = 0;
             LOGI("ANativeWindow attached (%dx%d)", g_width, g_height);
         } else {
             LOGE("ANativeWindow_fromSurface returned NULL");
@@ -2173,9 +3369,16 @@ Java_com_yourmateapps_retropal_YageTextureBridge_nativeReleaseSurface(
 YAGE_API int yage_texture_blit(YageCore* core) {
     (void)core;
 #ifdef __ANDROID__
-    return blit_to_native_window();
+    return blit_to_native_window(g_width, g_height) < 0 ? -1 : 0;
+#elif !defined(_WIN32)
+    /* Publish for the runner's copy_pixels; the caller runs retro_run()
+     * so it is the slot writer here */
+    if (!desktop_texture_attached()) return -1;
+    int rc = publish_display_slot(g_width, g_height);
+    if (rc == 0) desktop_texture_notify();
+    return rc < 0 ? -1 : 0;
 #else
-    return -1;  /* no texture surface on non-Android platforms */
+    return -1;  /* no texture surface on Windows */
 #endif
 }
 
@@ -2183,11 +3386,225 @@ YAGE_API int32_t yage_texture_is_attached(YageCore* core) {
     (void)core;
 #ifdef __ANDROID__
     return g_native_window != NULL ? 1 : 0;
+#elif !defined(_WIN32)
+    return desktop_texture_attached();
 #else
     return 0;
 #endif
 }
 
+#if !defined(__ANDROID__) && !defined(_WIN32)
+
+YAGE_API void yage_texture_attach(yage_texture_frame_available_t frame_available,
+                                  void* user_data) {
+    pthread_mutex_lock(&g_tex_mutex);
+    g_tex_notify = frame_available;
+    g_tex_user   = user_data;
+    /* Not while a Dart-side acquire is between its check and the swap */
+    pthread_mutex_lock(&g_tex_slot_mutex);
+    atomic_store_explicit(&g_tex_attached, frame_available ? 1 : 0, memory_order_release);
+    pthread_mutex_unlock(&g_tex_slot_mutex);
+    pthread_mutex_unlock(&g_tex_mutex);
+    LOGI("Desktop texture %s", frame_available ? "attached" : "detached");
+}
+
+static const uint8_t* texture_acquire_locked(uint32_t* width, uint32_t* height) {
+    static const uint8_t black[4] = { 0, 0, 0, 255 };
+    YageDisplaySlot* slot = acquire_display_slot();
+    int w = slot->width, h = slot->height;
+    if (w <= 0 || h <= 0 || !slot->pixels) {
+        *width = *height = 1;   /* nothing published yet */
+        return black;
+    }
+    *width  = (uint32_t)w;
+    *height = (uint32_t)h;
+    if (slot->format == YAGE_OUTPUT_RGBA8888) return (const uint8_t*)slot->pixels;
+
+    /* RGB565 / BGRA / INDEX8 slots: one conversion pass into a reader-owned
+     * buffer (INDEX8 picks up palette changes here) */
+    size_t bytes = (size_t)w * h * 4;
+    if (bytes > g_tex_rgba_capacity) {
+        /* Room for the largest geometry the core announced */
+        size_t reserve = (size_t)atomic_load_explicit(&g_tex_reserve, memory_order_relaxed) * 4;
+        size_t grow = reserve > bytes ? reserve : bytes;
+        uint8_t* buf = (uint8_t*)realloc(g_tex_rgba, grow);
+        if (!buf) {
+            *width = *height = 1;
+            return black;
+        }
+        g_tex_rgba = buf;
+        g_tex_rgba_capacity = grow;
+    }
+    if (slot->format == YAGE_OUTPUT_INDEX8) {
+        uint32_t pal[4];
+        index_palette_load(pal);
+        const uint8_t* src = (const uint8_t*)slot->pixels;
+        for (int y = 0; y < h; y++) {
+            yage_pixconv_row_index8_expand(g_tex_rgba + (size_t)y * w * 4, src + (size_t)y * w,
+                                           w, pal);
+        }
+    } else {
+        yage_image_to_rgba(slot->pixels, w, h, slot->format, g_tex_rgba);
+    }
+    return g_tex_rgba;
+}
+
+YAGE_API const uint8_t* yage_texture_acquire_pixels(uint32_t* width, uint32_t* height) {
+    pthread_mutex_lock(&g_tex_slot_mutex);
+    const uint8_t* pixels = texture_acquire_locked(width, height);
+    pthread_mutex_unlock(&g_tex_slot_mutex);
+    return pixels;
+}
+
+#endif /* !__ANDROID__ && !_WIN32 */
+
+/* ── Public API: recording ─────────────────────────────────────────── */
+
+int32_t yage_record_start(YageCore* core, const char* path) {
+    if (!core || !core->game_loaded || !path) return -1;
+    video_flush_pending();
+    int w = g_video_buffer_sync.width > 0 ? g_video_buffer_sync.width : g_width;
+    int h = g_video_buffer_sync.height > 0 ? g_video_buffer_sync.height : g_height;
+    if (yage_recorder_open(path, w, h, g_av_fps, g_av_sample_rate) != 0) {
+        LOGE("Failed to start recording to %s", path);
+        return -1;
+    }
+    LOGI("Recording started: %s (%dx%d, %.4f fps, %.0f Hz)",
+         path, w, h, g_av_fps, g_av_sample_rate);
+    return 0;
+}
+
+void yage_record_stop(YageCore* core) {
+    (void)core;
+    if (!yage_recorder_active()) return;
+    yage_recorder_close();
+    uint32_t written, dropped, audio_dropped;
+    yage_recorder_stats(&written, &dropped, &audio_dropped);
+    LOGI("Recording stopped: %u frames written, %u dropped, %u audio frames dropped",
+         written, dropped, audio_dropped);
+}
+
+int32_t yage_record_is_active(YageCore* core) {
+    (void)core;
+    return yage_recorder_active();
+}
+
+void yage_record_get_stats(YageCore* core, uint32_t* frames_written,
+                           uint32_t* frames_dropped, uint32_t* audio_frames_dropped) {
+    (void)core;
+    yage_recorder_stats(frames_written, frames_dropped, audio_frames_dropped);
+}
+
+/* ── Public API: instant replay ────────────────────────────────────── */
+
+int32_t yage_replay_buffer_configure(YageCore* core, int32_t seconds, int64_t max_bytes) {
+    (void)core;
+    if (max_bytes < 0) max_bytes = 0;
+    if (yage_replay_configure(seconds, (size_t)max_bytes, g_av_fps) != 0) {
+        LOGE("Failed to configure replay buffer (%d s)", seconds);
+        return -1;
+    }
+    if (seconds > 0) {
+        LOGI("Replay buffer: %d s at %.4f fps, cap %lld bytes",
+             seconds, g_av_fps, (long long)max_bytes);
+    }
+    return 0;
+}
+
+int32_t yage_replay_buffer_dump(YageCore* core, const char* path) {
+    (void)core;
+    if (!path) return -1;
+    int frames = yage_replay_dump(path, g_av_fps, g_av_sample_rate);
+    if (frames < 0) LOGE("Replay dump to %s failed", path);
+    else LOGI("Replay dumped: %d frames to %s", frames, path);
+    return frames;
+}
+
+void yage_replay_buffer_get_stats(YageCore* core, uint32_t* frames, uint32_t* bytes,
+                                  uint32_t* dropped) {
+    (void)core;
+    yage_replay_stats(frames, bytes, dropped);
+}
+
+/* ── Public API: shared-memory frame export ─────────────────────────── */
+
+int32_t yage_frame_export_start(YageCore* core, const char* name, int32_t slots) {
+    if (!core || !name) return -1;
+    /* Room for the largest frame the core declared, in any output format */
+    size_t capacity = g_video_buffer_capacity * 4;
+    if (capacity == 0) capacity = (size_t)VIDEO_BUFFER_SIZE * 4;
+    if (yage_shm_open(name, slots, capacity) != 0) {
+        LOGE("Failed to start frame export to shared memory %s", name);
+        return -1;
+    }
+    LOGI("Frame export started: %s (%d slots, %zu bytes per frame)", name, slots, capacity);
+    return 0;
+}
+
+void yage_frame_export_stop(YageCore* core) {
+    (void)core;
+    if (!yage_shm_active()) return;
+    yage_shm_close();
+    uint32_t published, dropped;
+    yage_shm_stats(&published, &dropped);
+    LOGI("Frame export stopped: %u frames published, %u dropped", published, dropped);
+}
+
+int32_t yage_frame_export_is_active(YageCore* core) {
+    (void)core;
+    return yage_shm_active();
+}
+
+void yage_frame_export_get_stats(YageCore* core, uint32_t* published, uint32_t* dropped) {
+    (void)core;
+    yage_shm_stats(published, dropped);
+}
+
+/* ── Public API: screenshots ──────────────────────────────────────── */
+
+int32_t yage_screenshot_save(YageCore* core, const char* path, int32_t format,
+                             int32_t max_width, int32_t max_height,
+                             yage_screenshot_callback_t callback) {
+    if (!core || !core->game_loaded || !path) return -1;
+    if (format != YAGE_IMAGE_PNG && format != YAGE_IMAGE_QOI) return -1;
+
+    size_t len = strlen(path);
+    ScreenshotJob* job = (ScreenshotJob*)calloc(1, sizeof(ScreenshotJob) + len + 1);
+    if (!job) return -1;
+    memcpy(job->path, path, len + 1);
+    job->format     = format;
+    job->max_width  = max_width > 0 ? max_width : 0;
+    job->max_height = max_height > 0 ? max_height : 0;
+    job->callback   = callback;
+
+#ifndef _WIN32
+    int32_t id = atomic_fetch_add(&g_shot_next_id, 1);
+    job->id = id;
+    atomic_fetch_add(&g_shot_inflight, 1);
+    if (atomic_load_explicit(&g_floop_running, memory_order_acquire)) {
+        /* Only the frame loop may touch g_video_buffer now */
+        ScreenshotJob* head = atomic_load_explicit(&g_shot_requests, memory_order_relaxed);
+        do {
+            job->next = head;
+        } while (!atomic_compare_exchange_weak_explicit(&g_shot_requests, &head, job,
+                                                        memory_order_release,
+                                                        memory_order_relaxed));
+        return id;
+    }
+    screenshot_dispatch(job);
+    return id;
+#else
+    int32_t id = g_shot_next_id++;
+    job->id = id;
+    if (screenshot_snapshot(job) != 0) {
+        free(job->pixels);
+        job->pixels = NULL;
+    }
+    screenshot_finish(job);
+    return id;
+#endif
+}
+
 /* ════════════════════════════════════════════════════════════════════════
  *  Native Frame Loop — pthread implementation (POSIX only)
  *
@@ -2198,6 +3615,252 @@ YAGE_API int32_t yage_texture_is_attached(YageCore* core) {
 
 #ifndef _WIN32
 
+/* ── Display slot handoff ──────────────────────────────────────────────── */
+
+/* Convert the current frame into the back slot and publish it.
+ * Returns 0 if published, 1 if the frame is identical to the one published
+ * last (nothing done), -1 on failure.  Frame loop thread only. */
+static int publish_display_slot(int w, int h) {
+    YageDisplaySlot* slot = &g_display_slots[g_display_back];
+    if (w <= 0 || h <= 0) return -1;
+
+    /* The core rendered this frame into the slot itself (see
+     * get_software_framebuffer): it already is the output, rows packed.
+     * Then it is not folded into the shadow here - no row compare, no
+     * copy - but left pending in the slot, to be folded only if something
+     * needs the source rows before the slot is written again.  Recording,
+     * replay and pending screenshots fold each frame as it is produced,
+     * in which case it is in the shadow already. */
+    int direct = g_display_back_core && g_video_passthrough && w == g_width && h == g_height &&
+                 !atomic_load_explicit(&g_video_conv_dirty, memory_order_acquire);
+    if (!direct) video_consume_pending();   /* settles g_out_bpp before picking post-processing */
+    DisplayPost post;
+    display_post(&post);   /* RGB565 output: never post-processed */
+    int f = post.factor;
+    int ow = w * f, oh = h * f;
+    size_t pixels = (size_t)ow * oh;
+
+    /* Post-processed frames are built from g_video_buffer; plain ones are
+     * converted straight into the slot */
+    const uint32_t* src = NULL;
+    uint32_t serial = 0;
+    if (post.key != 0) {
+        src = display_source(&post, w, h, &serial);
+        if (!src) return -1;
+    }
+
+    /* Duplicate frame: the reader already has (or can still take) these
+     * exact pixels, so skip the conversion and the handoff.  An unfolded
+     * frame has no dirty rows to tell. */
+    int unfolded = direct && g_video_pending;
+    if (!unfolded && ow == g_display_pub_width && oh == g_display_pub_height &&
+        post.key == g_display_pub_post && g_out_format == g_display_pub_format) {
+        int top, bottom;
+        if (present_dirty_rows(&post, g_display_pub_serial, h, &top, &bottom) == 0) return 1;
+    }
+
+    /* Capacity is counted in 32-bit pixels — enough for every output format */
+    if (display_slot_reserve(slot, pixels) != 0) {
+        LOGE("Failed to grow display slot to %dx%d", w, h);
+        return -1;
+    }
+
+    int same = slot->width == ow && slot->height == oh && slot->post == post.key &&
+               slot->format == g_out_format;
+    if (direct) {
+        serial = g_video_serial;
+    } else if (!src) {
+        VideoSyncState st = { slot->serial, same ? w : 0, same ? h : 0 };
+        video_sync(slot->pixels, &st);
+        if (st.width != w || st.height != h) return -1;  /* nothing converted yet */
+        serial = st.serial;
+    } else {
+        /* Only the rows that changed since this slot was last filled */
+        int top = 0, bottom = h - 1;
+        int rows = same ? present_dirty_rows(&post, slot->serial, h, &top, &bottom) : h;
+        if (rows > 0) display_emit_rows(&post, src, slot->pixels, ow, w, h, top, bottom);
+    }
+
+    /* Rows that differ from the previously published frame */
+    int top = 0, bottom = h - 1, rows = h;
+    if (unfolded) {
+        /* Every row counts as changed, here and for whatever is synced
+         * to the shadow once the frame is folded */
+        g_display_unfolded = g_display_back;
+        g_video_force_full = 1;
+    } else if (ow == g_display_pub_width && oh == g_display_pub_height &&
+        post.key == g_display_pub_post) {
+        rows = present_dirty_rows(&post, g_display_pub_serial, h, &top, &bottom);
+        if (rows > 0 && f > 1) {
+            if (top > 0) top--;
+            if (bottom < h - 1) bottom++;
+        }
+    }
+    g_display_pub_serial = serial;
+    g_display_pub_width  = ow;
+    g_display_pub_height = oh;
+    g_display_pub_post   = post.key;
+    g_display_pub_format = g_out_format;
+
+    slot->serial  = serial;
+    slot->width   = ow;
+    slot->height  = oh;
+    slot->format  = g_out_format;
+    slot->post    = post.key;
+    slot->dirty_y = rows > 0 ? top * f : 0;
+    slot->dirty_h = rows > 0 ? (bottom - top + 1) * f : 0;
+    slot->generation = atomic_fetch_add_explicit(&g_display_generation, 1,
+                                                 memory_order_relaxed) + 1;
+
+    /* Release the slot contents to the reader, take back the stale one */
+    int old = atomic_exchange_explicit(&g_display_middle,
+                                       g_display_back | DISPLAY_SLOT_FRESH,
+                                       memory_order_acq_rel);
+    g_display_back = old & ~DISPLAY_SLOT_FRESH;
+    g_display_back_core = 0;
+    atomic_store_explicit(&g_display_via_slots, 1, memory_order_relaxed);
+
+    /* The slot just taken back may predate a geometry change: grow it now,
+     * after the handoff, rather than while converting the next frame */
+    display_slot_reserve(&g_display_slots[g_display_back], g_video_buffer_capacity);
+    return 0;
+}
+
+/* Make the newest published slot the reader's front slot.
+ * Reader thread only (Dart, or the raster thread with a desktop texture). */
+static YageDisplaySlot* acquire_display_slot(void) {
+    YageDisplaySlot* front = &g_display_slots[g_display_front];
+    if (!(atomic_load_explicit(&g_display_middle, memory_order_relaxed) & DISPLAY_SLOT_FRESH)) {
+        g_display_read_dirty_y = 0;
+        g_display_read_dirty_h = 0;   /* nothing new since the last acquire */
+        return front;
+    }
+
+    uint32_t prev_gen = front->generation;
+    int prev_w = front->width, prev_h = front->height, prev_fmt = front->format;
+    int mid = atomic_exchange_explicit(&g_display_middle, g_display_front,
+                                       memory_order_acq_rel);
+    g_display_front = mid & ~DISPLAY_SLOT_FRESH;
+    front = &g_display_slots[g_display_front];
+
+    if (front->generation == prev_gen + 1 && front->width == prev_w &&
+        front->height == prev_h && front->format == prev_fmt) {
+        g_display_read_dirty_y = front->dirty_y;
+        g_display_read_dirty_h = front->dirty_h;
+    } else {
+        /* Skipped a generation (or resized): report the whole frame */
+        g_display_read_dirty_y = 0;
+        g_display_read_dirty_h = front->height;
+    }
+    return front;
+}
+
+/* Present the w × h frame: blit it to the ANativeWindow or publish it to
+ * the display slots, then export it.  Returns 0 when a new frame was
+ * shown, 1 for a duplicate, -1 on failure.  Runs on the loop thread, or
+ * on the pipeline worker with g_video_mutex held. */
+static int present_frame(int w, int h) {
+    int presented;
+#ifdef __ANDROID__
+    /* Prefer zero-copy blit to ANativeWindow (Flutter Texture) */
+    if (g_native_window) {
+        presented = blit_to_native_window(w, h);
+        atomic_store_explicit(&g_display_via_slots, 0, memory_order_relaxed);
+    } else
+#endif
+    {
+        /* Fallback: convert into the back display slot and publish it
+         * for the Dart-side decodeImageFromPixels path (or the desktop
+         * texture) */
+        presented = publish_display_slot(w, h);
+#ifndef __ANDROID__
+        if (presented == 0) desktop_texture_notify();
+#endif
+    }
+    if (presented == 0) {
+        atomic_fetch_add_explicit(&g_present_count, 1, memory_order_relaxed);
+        export_presented_frame();
+    } else if (presented == 1) {
+        atomic_fetch_add_explicit(&g_present_skipped, 1, memory_order_relaxed);
+    }
+    return presented;
+}
+
+/* Pipeline worker: present each handed-off frame.  Finishes a pending job
+ * before honouring g_pipe_quit, so nothing handed off is lost. */
+static void* pipeline_thread(void* arg) {
+    (void)arg;
+    for (;;) {
+        pthread_mutex_lock(&g_pipe_mutex);
+        while (!g_pipe_job && !g_pipe_quit) pthread_cond_wait(&g_pipe_cond, &g_pipe_mutex);
+        if (!g_pipe_job) {
+            pthread_mutex_unlock(&g_pipe_mutex);
+            break;
+        }
+        int w = g_pipe_job_width, h = g_pipe_job_height;
+        g_pipe_job = 0;
+        pthread_mutex_unlock(&g_pipe_mutex);
+
+        video_lock();
+        int presented = present_frame(w, h);
+        video_unlock();
+        atomic_store_explicit(&g_pipe_result, presented, memory_order_relaxed);
+    }
+    return NULL;
+}
+
+/* Start / stop the worker.  Loop thread only, between frames. */
+static void pipeline_start(void) {
+    /* A frame the core rendered into the back slot must be folded into
+     * the shadow before the worker takes the slots over */
+    if (g_display_back_core) {
+        video_consume_pending();
+        g_display_back_core = 0;
+    }
+    g_pipe_job = 0;
+    g_pipe_quit = 0;
+    atomic_store_explicit(&g_pipe_result, 1, memory_order_relaxed);
+    g_pipe_on = 1;
+    if (pthread_create(&g_pipe_thread, NULL, pipeline_thread, NULL) != 0) {
+        g_pipe_on = 0;
+        atomic_store(&g_floop_pipelined, 0);
+        LOGE("Failed to start conversion pipeline; presenting on the loop thread");
+        return;
+    }
+    LOGI("Conversion pipeline started");
+}
+
+static void pipeline_stop(void) {
+    if (!g_pipe_on) return;
+    pthread_mutex_lock(&g_pipe_mutex);
+    g_pipe_quit = 1;
+    pthread_cond_signal(&g_pipe_cond);
+    pthread_mutex_unlock(&g_pipe_mutex);
+    pthread_join(g_pipe_thread, NULL);
+    g_pipe_on = 0;
+    LOGI("Conversion pipeline stopped");
+}
+
+/* Hand the frame retro_run() just produced to the worker.  Folding it into
+ * the shadow waits for a conversion still in progress — that wait is the
+ * pipeline's backpressure, bounded by one present.  Returns the result of
+ * the worker's previous present, for the loop's notification logic. */
+static int pipeline_submit(int w, int h) {
+    video_lock();
+    video_consume_pending();
+    video_unlock();
+
+    pthread_mutex_lock(&g_pipe_mutex);
+    if (g_pipe_job) atomic_fetch_add_explicit(&g_pipe_replaced, 1, memory_order_relaxed);
+    g_pipe_job = 1;
+    g_pipe_job_width = w;
+    g_pipe_job_height = h;
+    pthread_cond_signal(&g_pipe_cond);
+    pthread_mutex_unlock(&g_pipe_mutex);
+    atomic_fetch_add_explicit(&g_pipe_handoffs, 1, memory_order_relaxed);
+    return atomic_load_explicit(&g_pipe_result, memory_order_relaxed);
+}
+
 static void* frame_loop_thread(void* arg) {
     YageCore* core = (YageCore*)arg;
 
@@ -2208,12 +3871,20 @@ static void* frame_loop_thread(void* arg) {
     int64_t display_accum_ns = 0;
     int     total_frames     = 0;       /* for FPS counter */
     int     rewind_counter   = 0;
+    int     unreported_frames = 0;      /* run since the last callback */
 
     struct timespec fps_time = last_time;
+    struct timespec notify_time = last_time;
 
     LOGI("Frame loop thread started");
 
     while (atomic_load_explicit(&g_floop_running, memory_order_acquire)) {
+        /* ── Conversion pipeline on / off, between frames ── */
+        if (atomic_load_explicit(&g_floop_pipelined, memory_order_relaxed) != g_pipe_on) {
+            if (g_pipe_on) pipeline_stop();
+            else pipeline_start();
+        }
+
         /* ── Measure elapsed wall-clock time ── */
         struct timespec now;
         clock_gettime(CLOCK_MONOTONIC, &now);
@@ -2228,16 +3899,21 @@ static void* frame_loop_thread(void* arg) {
         int speed_pct = atomic_load_explicit(&g_floop_speed_pct,
                                               memory_order_relaxed);
         if (speed_pct < 25) speed_pct = 25;
-        int64_t target_ns = BASE_FRAME_NS * 100LL / speed_pct;
+        int64_t frame_ns = atomic_load_explicit(&g_floop_frame_ns, memory_order_relaxed);
+        int64_t target_ns = frame_ns * 100LL / speed_pct;
 
         /* ── Run emulation frames to catch up ── */
+        /* Only the last frame of the batch can be presented, and only if
+         * a display update is due after it */
+        int64_t batch = emu_accum_ns / target_ns;
+        if (batch > 8) batch = 8;
+        int present_due = display_accum_ns >= DISPLAY_INTERVAL_NS;
         int frames_run = 0;
         while (atomic_load_explicit(&g_floop_running, memory_order_relaxed) &&
                emu_accum_ns >= target_ns &&
                frames_run < 8) {
 
-            g_audio_samples = 0;
-            core->retro_run();
+            run_core_frame(core, present_due && frames_run == batch - 1);
             total_frames++;
 
             /* Rewind capture */
@@ -2273,34 +3949,30 @@ static void* frame_loop_thread(void* arg) {
                 display_accum_ns = 0;
             }
 
+            /* Only the frame that is about to be shown gets converted —
+             * here, or by the pipeline worker during the next frames */
             int w = g_width;
             int h = g_height;
 
-#ifdef __ANDROID__
-            /* Prefer zero-copy blit to ANativeWindow (Flutter Texture) */
-            if (g_native_window) {
-                blit_to_native_window();
-            } else
-#endif
-            {
-                /* Fallback: snapshot video buffer → display buffer for
-                 * Dart-side decodeImageFromPixels path */
-                size_t pixels = (size_t)w * h;
-                if (g_display_buf && pixels <= g_display_buf_capacity && g_video_buffer) {
-                    pthread_mutex_lock(&g_display_mutex);
-                    memcpy(g_display_buf, g_video_buffer,
-                           pixels * sizeof(uint32_t));
-                    g_display_width  = w;
-                    g_display_height = h;
-                    pthread_mutex_unlock(&g_display_mutex);
-                }
-            }
+            /* 0 = new frame shown, 1 = duplicate, -1 = failed; with the
+             * pipeline this is the previous hand-off's result */
+            int presented = g_pipe_on ? pipeline_submit(w, h) : present_frame(w, h);
 
             /* Notify Dart (runs on the Dart event loop via NativeCallable).
              * With texture rendering this is only used for FPS tracking
-             * and link cable polling — no pixel data is passed. */
-            if (g_frame_callback) {
-                g_frame_callback(frames_run);
+             * and link cable polling — no pixel data is passed.  When
+             * duplicate notifications are suppressed, a heartbeat still
+             * goes out every DUPE_NOTIFY_INTERVAL_NS to keep the FPS
+             * readout current. */
+            unreported_frames += frames_run;
+            int64_t since_notify = (now.tv_sec - notify_time.tv_sec) * 1000000000LL
+                                 + (now.tv_nsec - notify_time.tv_nsec);
+            if (g_frame_callback &&
+                (presented != 1 || since_notify >= DUPE_NOTIFY_INTERVAL_NS ||
+                 !atomic_load_explicit(&g_floop_skip_dupes, memory_order_relaxed))) {
+                g_frame_callback(unreported_frames);
+                unreported_frames = 0;
+                notify_time = now;
             }
         }
 
@@ -2329,33 +4001,89 @@ static void* frame_loop_thread(void* arg) {
         }
     }
 
+    pipeline_stop();   /* presents the last hand-off */
     LOGI("Frame loop thread exiting");
     return NULL;
 }
 
 /* ── Public API ───────────────────────────────────────────────────────── */
 
+/* Pre-size the display slots to match the video buffer so the frame loop
+ * only reallocates on a resolution change, and empty them.  Slot `keep`
+ * (-1 = none) stays untouched and becomes the front slot.  Neither the
+ * writer nor the reader may be active. */
+static int reset_display_slots(int keep) {
+    size_t needed = g_video_buffer_capacity;
+    for (int i = 0; i < DISPLAY_SLOT_COUNT; i++) {
+        YageDisplaySlot* slot = &g_display_slots[i];
+        if (i == keep) continue;
+        if (!slot->pixels || slot->capacity < needed) {
+            free(slot->pixels);
+            slot->pixels = (uint32_t*)malloc(needed * sizeof(uint32_t));
+            if (!slot->pixels) {
+                slot->capacity = 0;
+                return -1;
+            }
+            slot->capacity = needed;
+        }
+        slot->width = slot->height = 0;
+        slot->generation = 0;
+        slot->post = 0;
+        slot->dirty_y = slot->dirty_h = 0;
+    }
+    if (keep < 0) keep = 2;
+    g_display_back  = (keep + 1) % DISPLAY_SLOT_COUNT;
+    atomic_store_explicit(&g_display_middle, (keep + 2) % DISPLAY_SLOT_COUNT,
+                          memory_order_release);
+    g_display_front = keep;
+    atomic_store_explicit(&g_display_generation, 0, memory_order_relaxed);
+    atomic_store_explicit(&g_display_via_slots, 0, memory_order_relaxed);
+    g_display_pub_width = g_display_pub_height = 0;
+    g_display_pub_post   = 0;
+    g_display_pub_format = 0;
+    g_display_read_dirty_y = g_display_read_dirty_h = 0;
+    return 0;
+}
+
 int yage_frame_loop_start(YageCore* core, yage_frame_callback_t callback) {
     if (!core || !core->game_loaded || !core->retro_run) return -1;
     if (atomic_load(&g_floop_running)) return -1;  /* already running */
 
-    /* Allocate / reallocate display buffer to match video buffer */
-    size_t needed = g_video_buffer_capacity;
-    if (!g_display_buf || g_display_buf_capacity < needed) {
-        free(g_display_buf);
-        g_display_buf = (uint32_t*)malloc(needed * sizeof(uint32_t));
-        if (!g_display_buf) {
-            LOGE("Failed to allocate display buffer");
-            return -1;
-        }
-        g_display_buf_capacity = needed;
+    if (g_display_back_core) {
+        g_video_pending = 0;   /* the unconsumed frame lives in a slot */
+        g_display_back_core = 0;
+    } else if (g_display_unfolded >= 0) {
+        /* A frame published without being folded: take it in before the
+         * slots are reset */
+        video_lock();
+        video_consume_pending();
+        video_unlock();
+    }
+    g_display_unfolded = -1;
+    /* The writer is stopped; the reader is Dart (this thread) unless a
+     * desktop texture is attached.  Its raster thread is held off for the
+     * reset, and its front slot - which it may still be uploading from -
+     * is kept. */
+    int keep = -1;
+#ifndef __ANDROID__
+    pthread_mutex_lock(&g_tex_slot_mutex);
+    if (desktop_texture_attached()) keep = g_display_front;
+#endif
+    int slots = reset_display_slots(keep);
+#ifndef __ANDROID__
+    pthread_mutex_unlock(&g_tex_slot_mutex);
+#endif
+    if (slots != 0) {
+        LOGE("Failed to allocate display slot");
+        return -1;
     }
-    memset(g_display_buf, 0, needed * sizeof(uint32_t));
-    g_display_width  = g_width;
-    g_display_height = g_height;
 
     g_frame_callback = callback;
     atomic_store_explicit(&g_floop_fps_x100, 0, memory_order_relaxed);
+    atomic_store_explicit(&g_present_count, 0, memory_order_relaxed);
+    atomic_store_explicit(&g_present_skipped, 0, memory_order_relaxed);
+    atomic_store_explicit(&g_pipe_handoffs, 0, memory_order_relaxed);
+    atomic_store_explicit(&g_pipe_replaced, 0, memory_order_relaxed);
     atomic_store_explicit(&g_floop_running, 1, memory_order_release);
 
     int rc = pthread_create(&g_frame_thread, NULL, frame_loop_thread, core);
@@ -2378,6 +4106,7 @@ void yage_frame_loop_stop(YageCore* core) {
     atomic_store_explicit(&g_floop_running, 0, memory_order_release);
     pthread_join(g_frame_thread, NULL);
     g_frame_callback = NULL;
+    screenshot_poll();   /* a request the loop did not get to */
     LOGI("Native frame loop stopped");
 }
 
@@ -2411,29 +4140,124 @@ int32_t yage_frame_loop_get_fps_x100(YageCore* core) {
     return atomic_load_explicit(&g_floop_fps_x100, memory_order_relaxed);
 }
 
-uint32_t* yage_frame_loop_get_display_buffer(YageCore* core) {
+uint32_t* yage_frame_loop_acquire_display(YageCore* core, int32_t* width,
+                                          int32_t* height, uint32_t* generation) {
+    (void)core;
+#ifndef __ANDROID__
+    /* The raster thread is the slot reader while a texture is attached.
+     * Checked and acquired under g_tex_slot_mutex, so the two readers
+     * never acquire at once. */
+    pthread_mutex_lock(&g_tex_slot_mutex);
+    if (desktop_texture_attached()) {
+        pthread_mutex_unlock(&g_tex_slot_mutex);
+        if (width)      *width = 0;
+        if (height)     *height = 0;
+        if (generation) *generation = 0;
+        return NULL;
+    }
+#endif
+    YageDisplaySlot* slot = acquire_display_slot();
+    if (width)      *width = slot->width;
+    if (height)     *height = slot->height;
+    if (generation) *generation = slot->generation;
+    uint32_t* pixels = slot->width > 0 ? slot->pixels : NULL;
+#ifndef __ANDROID__
+    pthread_mutex_unlock(&g_tex_slot_mutex);
+#endif
+    return pixels;
+}
+
+uint32_t yage_frame_loop_get_display_generation(YageCore* core) {
     (void)core;
-    return g_display_buf;
+    return atomic_load_explicit(&g_display_generation, memory_order_relaxed);
+}
+
+uint32_t* yage_frame_loop_get_display_buffer(YageCore* core) {
+    return yage_frame_loop_acquire_display(core, NULL, NULL, NULL);
 }
 
 int32_t yage_frame_loop_get_display_width(YageCore* core) {
     (void)core;
-    return g_display_width;
+    return g_display_slots[g_display_front].width;
 }
 
 int32_t yage_frame_loop_get_display_height(YageCore* core) {
     (void)core;
-    return g_display_height;
+    return g_display_slots[g_display_front].height;
 }
 
+int32_t yage_frame_loop_get_display_format(YageCore* core) {
+    (void)core;
+    return g_display_slots[g_display_front].format;
+}
+
+int32_t yage_frame_loop_get_dirty_rect(YageCore* core, int32_t* x, int32_t* y,
+                                        int32_t* w, int32_t* h) {
+    (void)core;
+    int32_t dw = g_display_read_dirty_h > 0 ? g_display_slots[g_display_front].width : 0;
+    int32_t dh = g_display_read_dirty_h;
+    if (x) *x = 0;
+    if (y) *y = dh > 0 ? g_display_read_dirty_y : 0;
+    if (w) *w = dw;
+    if (h) *h = dh;
+    return (dw > 0 && dh > 0) ? 1 : 0;
+}
+
+void yage_frame_loop_set_skip_duplicate_callbacks(YageCore* core, int32_t enabled) {
+    (void)core;
+    atomic_store_explicit(&g_floop_skip_dupes, enabled ? 1 : 0, memory_order_relaxed);
+}
+
+void yage_frame_loop_get_present_stats(YageCore* core, uint32_t* presented,
+                                       uint32_t* skipped) {
+    (void)core;
+    if (presented) *presented = atomic_load_explicit(&g_present_count, memory_order_relaxed);
+    if (skipped)   *skipped = atomic_load_explicit(&g_present_skipped, memory_order_relaxed);
+}
+
+void yage_frame_loop_set_pipelined(YageCore* core, int32_t enabled) {
+    (void)core;
+    atomic_store_explicit(&g_floop_pipelined, enabled ? 1 : 0, memory_order_relaxed);
+    LOGI("Conversion pipeline %s", enabled ? "requested" : "off");
+}
+
+void yage_frame_loop_get_pipeline_stats(YageCore* core, uint32_t* handoffs,
+                                        uint32_t* replaced) {
+    (void)core;
+    if (handoffs) *handoffs = atomic_load_explicit(&g_pipe_handoffs, memory_order_relaxed);
+    if (replaced) *replaced = atomic_load_explicit(&g_pipe_replaced, memory_order_relaxed);
+}
+
+void yage_frame_loop_set_frame_blend(YageCore* core, int32_t mode, int32_t weight_pct) {
+    (void)core;
+    if (mode < YAGE_FRAME_BLEND_OFF || mode > YAGE_FRAME_BLEND_DECAY) mode = YAGE_FRAME_BLEND_OFF;
+    if (weight_pct < 0)   weight_pct = 0;
+    if (weight_pct > 100) weight_pct = 100;
+    int weight = weight_pct * 128 / 100;
+    if (weight > YAGE_BLEND_MAX_WEIGHT) weight = YAGE_BLEND_MAX_WEIGHT;
+    atomic_store_explicit(&g_blend_weight, weight, memory_order_relaxed);
+    atomic_store_explicit(&g_blend_mode, mode, memory_order_relaxed);
+    LOGI("LCD frame blend set to mode %d (%d%% history)", mode, weight_pct);
+}
+
+int32_t yage_frame_loop_set_scaler(YageCore* core, int32_t mode, int32_t factor) {
+    (void)core;
+    if (mode < YAGE_SCALER_NONE || mode > YAGE_SCALER_XBR2X) mode = YAGE_SCALER_NONE;
+    int32_t f = yage_scaler_factor(mode, factor);
+    /* Mode last: the frame loop reads it first */
+    atomic_store_explicit(&g_scaler_factor, f, memory_order_relaxed);
+    atomic_store_explicit(&g_scaler_mode, mode, memory_order_relaxed);
+    LOGI("Display scaler set to mode %d (%dx)", mode, f);
+    return f;
+}
+
+/* The display handoff is lock-free; kept so existing callers still link */
 void yage_frame_loop_lock_display(YageCore* core) {
     (void)core;
-    pthread_mutex_lock(&g_display_mutex);
 }
 
 void yage_frame_loop_unlock_display(YageCore* core) {
     (void)core;
-    pthread_mutex_unlock(&g_display_mutex);
 }
 
 int32_t yage_frame_loop_is_running(YageCore* core) {
@@ -2453,9 +4277,46 @@ void  yage_frame_loop_set_rewind(YageCore* c, int32_t e, int32_t i) {
 }
 void  yage_frame_loop_set_rcheevos(YageCore* c, int32_t e) { (void)c; (void)e; }
 int32_t   yage_frame_loop_get_fps_x100(YageCore* c) { (void)c; return 0; }
+uint32_t* yage_frame_loop_acquire_display(YageCore* c, int32_t* w, int32_t* h,
+                                          uint32_t* gen) {
+    (void)c;
+    if (w) *w = 0;
+    if (h) *h = 0;
+    if (gen) *gen = 0;
+    return NULL;
+}
+uint32_t  yage_frame_loop_get_display_generation(YageCore* c) { (void)c; return 0; }
 uint32_t* yage_frame_loop_get_display_buffer(YageCore* c) { (void)c; return NULL; }
 int32_t   yage_frame_loop_get_display_width(YageCore* c) { (void)c; return 0; }
 int32_t   yage_frame_loop_get_display_height(YageCore* c) { (void)c; return 0; }
+int32_t   yage_frame_loop_get_display_format(YageCore* c) { (void)c; return YAGE_OUTPUT_RGBA8888; }
+int32_t   yage_frame_loop_get_dirty_rect(YageCore* c, int32_t* x, int32_t* y,
+                                         int32_t* w, int32_t* h) {
+    (void)c;
+    if (x) *x = 0;
+    if (y) *y = 0;
+    if (w) *w = 0;
+    if (h) *h = 0;
+    return 0;
+}
+void      yage_frame_loop_set_skip_duplicate_callbacks(YageCore* c, int32_t e) { (void)c; (void)e; }
+void      yage_frame_loop_get_present_stats(YageCore* c, uint32_t* p, uint32_t* s) {
+    (void)c;
+    if (p) *p = 0;
+    if (s) *s = 0;
+}
+void      yage_frame_loop_set_pipelined(YageCore* c, int32_t e) { (void)c; (void)e; }
+void      yage_frame_loop_get_pipeline_stats(YageCore* c, uint32_t* n, uint32_t* r) {
+    (void)c;
+    if (n) *n = 0;
+    if (r) *r = 0;
+}
+void      yage_frame_loop_set_frame_blend(YageCore* c, int32_t m, int32_t w) {
+    (void)c; (void)m; (void)w;
+}
+int32_t   yage_frame_loop_set_scaler(YageCore* c, int32_t m, int32_t f) {
+    (void)c; (void)m; (void)f; return 1;
+}
 void      yage_frame_loop_lock_display(YageCore* c) { (void)c; }
 void      yage_frame_loop_unlock_display(YageCore* c) { (void)c; }
 int32_t   yage_frame_loop_is_running(YageCore* c) { (void)c; return 0; }
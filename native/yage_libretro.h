@@ -30,6 +30,44 @@ extern "C" {
 #define RETRO_PIXEL_FORMAT_XRGB8888 1
 #define RETRO_PIXEL_FORMAT_RGB565   2
 
+/* Output pixel formats (yage_core_set_output_format) */
+#define YAGE_OUTPUT_RGBA8888 0   /* R,G,B,A bytes — Flutter rgba8888 (default) */
+#define YAGE_OUTPUT_BGRA8888 1   /* B,G,R,A bytes — native order of desktop GPUs */
+#define YAGE_OUTPUT_RGB565   2   /* 16-bit, passthrough for RGB565 cores */
+#define YAGE_OUTPUT_INDEX8   3   /* GB shade 0..3 per byte (palette on), see yage_core_get_output_palette */
+
+/* Display upscalers (yage_frame_loop_set_scaler) */
+#define YAGE_SCALER_NONE    0
+#define YAGE_SCALER_NEAREST 1   /* integer nearest-neighbour, 2×..4× */
+#define YAGE_SCALER_SCALE2X 2   /* AdvMAME Scale2x */
+#define YAGE_SCALER_SCALE3X 3   /* AdvMAME Scale3x */
+#define YAGE_SCALER_XBR2X   4   /* lightweight 2× xBR */
+
+/* LCD ghosting modes (yage_frame_loop_set_frame_blend) */
+#define YAGE_FRAME_BLEND_OFF   0
+#define YAGE_FRAME_BLEND_MIX   1   /* blend with the previous frame */
+#define YAGE_FRAME_BLEND_DECAY 2   /* exponential fade (LCD response time) */
+
+/* Screenshot file formats (yage_screenshot_save) */
+#define YAGE_IMAGE_PNG 0
+#define YAGE_IMAGE_QOI 1   /* qoiformat.org — much faster to encode */
+
+/* Audio output backends (yage_audio_output_start) */
+#define YAGE_AUDIO_BACKEND_AUTO     0   /* ALSA, else NULL */
+#define YAGE_AUDIO_BACKEND_ALSA     1   /* libasound, loaded at run time (Linux) */
+#define YAGE_AUDIO_BACKEND_NULL     2   /* discard, paced in real time */
+#define YAGE_AUDIO_BACKEND_WAV      3   /* write the played stream to a WAV file */
+#define YAGE_AUDIO_BACKEND_EXTERNAL 4   /* device driven by the wrapper (OpenSL ES on Android) */
+
+/* Fast-forward audio (yage_audio_output_set_fast_forward) */
+#define YAGE_AUDIO_FF_AUTO      0   /* stretch up to 3×, decimate above */
+#define YAGE_AUDIO_FF_STRETCH   1   /* time-stretch, pitch preserved */
+#define YAGE_AUDIO_FF_DECIMATE  2   /* play faster, pitch rises with speed */
+
+/* Audio telemetry fill histogram (YageAudioStats) */
+#define YAGE_AUDIO_FILL_BUCKETS   16
+#define YAGE_AUDIO_FILL_BUCKET_MS 5    /* the last bucket also takes everything above */
+
 /* Libretro device types */
 #define RETRO_DEVICE_JOYPAD 1
 
@@ -99,18 +137,153 @@ YAGE_API void yage_core_set_keys(YageCore* core, uint32_t keys);
 /*
  * Video
  */
+/* Frames are converted lazily: this call converts the core's latest frame
+ * if needed.  While the native frame loop runs, the buffer holds the last
+ * frame it presented.  Pixels use the layout from
+ * yage_core_set_output_format (RGBA8888 unless changed); INDEX8 frames
+ * hold shade numbers.  yage_core_get_video_format reports the layout of
+ * the buffer returned last. */
 YAGE_API uint32_t* yage_core_get_video_buffer(YageCore* core);
+YAGE_API int yage_core_get_video_format(YageCore* core);
 YAGE_API int yage_core_get_width(YageCore* core);
 YAGE_API int yage_core_get_height(YageCore* core);
 
+/* Pixel layout of every frame the wrapper hands out (video buffer, display
+ * slots, texture blit).  RGB565 output halves memory bandwidth and is a
+ * straight copy when the core emits RGB565 with no color transform active
+ * (color correction / GB palette still apply, packed to 16 bits).  When
+ * that copy is in effect and the native frame loop publishes to the
+ * display slots on its own thread (no pipeline, no Android window), the
+ * core renders straight into a slot, which is published untouched - no
+ * conversion, no dirty-row compare, so the whole frame is reported dirty.
+ * GB/GBA sessions always run with color correction or the GB palette on
+ * and never take that path.
+ * INDEX8 stores the GB palette shade (0 = lightest .. 3 = darkest) in one
+ * byte per pixel, a quarter of RGBA8888; it applies while the GB palette
+ * is enabled and falls back to RGBA8888 otherwise.  Indexed frames are
+ * recoloured where they are uploaded — the Android window blit, the
+ * desktop texture, captures — and Dart recolours slot frames with
+ * yage_core_get_output_palette.  Like RGB565, they skip the scaler and
+ * frame blending.
+ * Takes effect from the next frame.  Returns 0, or -1 for an unknown format. */
+YAGE_API int yage_core_set_output_format(YageCore* core, int format);
+YAGE_API int yage_core_get_output_format(YageCore* core);
+
+/* Bytes per pixel of the frames being produced (4, 2 for RGB565, 1 for
+ * INDEX8).  This follows the active format, not the requested one: it
+ * changes with the first frame converted after yage_core_set_output_format,
+ * and INDEX8 reports 4 while the GB palette is off. */
+YAGE_API int yage_core_get_output_bytes_per_pixel(YageCore* core);
+
 /*
  * Audio
+ *
+ * The buffer holds the last frame's audio, volume-scaled: every batch and
+ * single sample the core delivered during it (up to 8192 stereo frames).
+ * It is valid until the next frame runs; the count is in stereo frames.
  */
 YAGE_API int16_t* yage_core_get_audio_buffer(YageCore* core);
 YAGE_API int yage_core_get_audio_samples(YageCore* core);
 YAGE_API void yage_core_set_volume(YageCore* core, float volume);
 YAGE_API void yage_core_set_audio_enabled(YageCore* core, int enabled);
 
+/*
+ * Audio pull stream
+ *
+ * Every frame's audio, as yage_core_get_audio_buffer() sees it, queued for
+ * a host that plays it itself and drains it in bulk at its own pace — no
+ * frame is missed, however the core delivers its samples.  Interleaved
+ * 16-bit stereo at the core's rate (yage_audio_read_rate).  The stream
+ * starts with the first yage_audio_read() and holds 65536 frames; audio
+ * that arrives while it is full is dropped, so a host that pauses reading
+ * should drain it before relying on it again.  Reset when a ROM loads.
+ * Call both functions from one thread, which may differ from the one
+ * running frames.
+ */
+
+/* Copy up to `max_frames` stereo frames into `dst`.  Returns the frames
+ * copied (0 when nothing is queued). */
+YAGE_API int32_t yage_audio_read(YageCore* core, int16_t* dst, int32_t max_frames);
+
+/* Stereo frames queued for yage_audio_read(). */
+YAGE_API int32_t yage_audio_read_available(YageCore* core);
+
+/* Sample rate of the stream in Hz: the core's reported rate, or the
+ * measured one when audio output found the report implausible. */
+YAGE_API double yage_audio_read_rate(YageCore* core);
+
+/*
+ * Audio output
+ *
+ * The wrapper resamples the core's audio to 48 kHz and plays it through
+ * the audio engine, whose ring buffer is steered toward ~32 ms of
+ * latency by small (±0.5%) rate adjustments.  On Android this happens
+ * automatically through OpenSL ES.  On Linux / macOS nothing is played
+ * until an output is started; it then runs on its own thread.  The NULL
+ * and WAV backends behave like a real-time device without one, for
+ * headless runs and tests.  Not available on Windows.
+ *
+ * While the native frame loop runs faster than 1× the engine still plays
+ * in real time: the audio is time-stretched (WSOLA, pitch preserved) or
+ * decimated (resampled down, pitch rises) instead of piling up and being
+ * skipped.
+ */
+
+/* Start playing through `backend` (YAGE_AUDIO_BACKEND_AUTO / ALSA / NULL /
+ * WAV).  `target` is the ALSA device name (NULL = "default") or the WAV
+ * file path.  Returns 0 on success, -1 if an output is already running,
+ * the backend is unavailable, or on Android / Windows. */
+YAGE_API int32_t yage_audio_output_start(YageCore* core, int32_t backend, const char* target);
+
+/* Stop the output started with yage_audio_output_start (finishes a WAV
+ * file).  Also done by yage_core_destroy. */
+YAGE_API void yage_audio_output_stop(YageCore* core);
+
+/* Backend currently playing (YAGE_AUDIO_BACKEND_*), or -1. */
+YAGE_API int32_t yage_audio_output_get_backend(YageCore* core);
+
+/* Underrun episodes and overflow episodes (audio produced faster than
+ * played, e.g. a stalled device) since the output opened, and the stereo
+ * frames currently buffered. */
+YAGE_API void yage_audio_output_get_stats(YageCore* core, uint32_t* underruns,
+                                          uint32_t* overflows, int32_t* buffered_frames);
+
+/* How fast-forward audio is played (YAGE_AUDIO_FF_*, default AUTO).
+ * Takes effect on the next audio batch, on every platform with output. */
+YAGE_API void yage_audio_output_set_fast_forward(YageCore* core, int32_t mode);
+
+/* Audio telemetry snapshot.  Fixed layout (offsets on the right), read
+ * field by field from Dart.  The fill is what the device has yet to play
+ * from the engine's ring, sampled once per device period; min / max and
+ * the histogram cover the last 5-10 seconds (window_s).  Counters and
+ * window restart when the output opens. */
+typedef struct YageAudioStats {
+    double   device_rate;      /*   0  Hz, 0 when no output is open */
+    double   core_rate;        /*   8  Hz the core produces (measured if implausible) */
+    double   resample_ratio;   /*  16  device frames per resampler input frame, rate
+                                *      control included; decimation feeds it speed ×
+                                *      the core rate */
+    double   speed;            /*  24  emulation speed played back (1 = real time) */
+    float    fill_ms;          /*  32  ring fill now */
+    float    fill_min_ms;      /*  36  lowest fill over window_s */
+    float    fill_max_ms;      /*  40  highest fill over window_s */
+    float    target_ms;        /*  44  fill that rate control steers toward */
+    float    latency_ms;       /*  48  estimated core sample → device output: ring,
+                                *      device buffer, resampler and time-stretch */
+    float    window_s;         /*  52  span of min / max and the histogram */
+    uint32_t underruns;        /*  56  episodes */
+    uint32_t overflows;        /*  60  episodes */
+    uint32_t pull_dropped;     /*  64  frames the pull stream dropped */
+    int32_t  backend;          /*  68  YAGE_AUDIO_BACKEND_*, -1 = none */
+    uint32_t fill_histogram[YAGE_AUDIO_FILL_BUCKETS];
+                               /*  72  device periods per YAGE_AUDIO_FILL_BUCKET_MS
+                                *      of fill */
+} YageAudioStats;              /* 136 bytes */
+
+/* Fill `out` with the current audio telemetry.  Any thread; works (with
+ * the output fields zero) when no output is open. */
+YAGE_API void yage_audio_output_get_telemetry(YageCore* core, YageAudioStats* out);
+
 /*
  * Color palette (for original GB)
  * palette_index: -1 = disabled (original colors), 0+ = enabled
@@ -120,6 +293,12 @@ YAGE_API void yage_core_set_color_palette(YageCore* core, int palette_index,
                                            uint32_t color0, uint32_t color1,
                                            uint32_t color2, uint32_t color3);
 
+/* The 4 shades INDEX8 frames are shown in, as RGBA bytes (lightest
+ * first).  With INDEX8 output, changing the palette colours only swaps
+ * these — frames are not reconverted.  Returns 1 while frames are
+ * indexed (INDEX8 requested and the palette enabled), 0 otherwise. */
+YAGE_API int32_t yage_core_get_output_palette(YageCore* core, uint32_t* colors);
+
 /*
  * SGB (Super Game Boy) border control
  * enabled: 1 = show SGB borders (256×224), 0 = standard GB (160×144)
@@ -208,7 +387,9 @@ YAGE_API int yage_core_get_memory_size(YageCore* core, int32_t region_id);
  * responsiveness, especially at turbo speeds (8× = 480 emulation fps).
  *
  * The thread handles: frame timing (nanosleep), retro_run(), rewind
- * capture, rcheevos per-frame processing, and FPS calculation.
+ * capture, rcheevos per-frame processing, and FPS calculation.  Frames
+ * are paced at the core's own rate (AV info, updated by
+ * SET_SYSTEM_AV_INFO), e.g. 59.7275 Hz for GBA or 60.0988 Hz for NES.
  *
  * A display callback is fired at ~60 Hz to notify Dart when a new
  * frame is ready for rendering.  At turbo speeds the emulation runs
@@ -242,25 +423,198 @@ YAGE_API void yage_frame_loop_set_rcheevos(YageCore* core, int32_t enabled);
 /* Get FPS × 100 (e.g. 5973 = 59.73 fps).  Safe to call from any thread. */
 YAGE_API int32_t yage_frame_loop_get_fps_x100(YageCore* core);
 
-/* Get the display buffer — a snapshot of the last completed frame.
- * Updated at ~60 Hz.  Safe to read from the Dart thread between
- * display callbacks (the native thread will not overwrite until the
- * next display interval). */
+/* Display frames are handed to Dart through three slots: the frame loop
+ * converts into a back slot and publishes it; the reader acquires the
+ * newest published slot.  Neither side blocks the other.  Call the
+ * acquire/get functions below from one reader thread (the Dart thread). */
+
+/* Acquire the newest published frame.  The returned pixels stay valid and
+ * unchanged until the next acquire (or get_display_buffer) call.  Fills the
+ * frame's dimensions and generation (count of frames published since the
+ * loop started).  Returns NULL if no frame has been published yet. */
+YAGE_API uint32_t* yage_frame_loop_acquire_display(YageCore* core, int32_t* width,
+                                                   int32_t* height, uint32_t* generation);
+
+/* Generation of the newest published frame — compare with the value from
+ * the last acquire to see whether a new frame is waiting. */
+YAGE_API uint32_t yage_frame_loop_get_display_generation(YageCore* core);
+
+/* Acquire the newest published frame (same as
+ * yage_frame_loop_acquire_display without the out-parameters). */
 YAGE_API uint32_t* yage_frame_loop_get_display_buffer(YageCore* core);
 
-/* Get display dimensions of the last completed frame. */
+/* Get display dimensions of the frame acquired last. */
 YAGE_API int32_t yage_frame_loop_get_display_width(YageCore* core);
 YAGE_API int32_t yage_frame_loop_get_display_height(YageCore* core);
 
-/* Lock/unlock the display buffer for safe reading from the Dart thread.
- * Hold the lock while reading display buffer contents and dimensions to
- * prevent the frame loop from overwriting mid-read. */
+/* Get the YAGE_OUTPUT_* layout of the frame acquired last. */
+YAGE_API int32_t yage_frame_loop_get_display_format(YageCore* core);
+
+/* Get the region of the acquired frame that differs from the frame acquired
+ * before it.  Only scanlines are tracked, so the rect always spans the
+ * full width (x = 0, w = display width).  Returns 1 if the rect is
+ * non-empty, 0 if nothing changed (the caller can skip re-uploading). */
+YAGE_API int32_t yage_frame_loop_get_dirty_rect(YageCore* core, int32_t* x, int32_t* y,
+                                                int32_t* w, int32_t* h);
+
+/* Frames identical to the one shown last (static screens, menus, pauses)
+ * are not converted, handed off or blitted.  With `enabled` set their
+ * frame callback is dropped too, apart from a 2 Hz heartbeat; leave it off
+ * while the callback drives anything per-frame (e.g. link cable polling). */
+YAGE_API void yage_frame_loop_set_skip_duplicate_callbacks(YageCore* core, int32_t enabled);
+
+/* Present counters since yage_frame_loop_start: new frames shown and
+ * duplicate frames skipped. */
+YAGE_API void yage_frame_loop_get_present_stats(YageCore* core, uint32_t* presented,
+                                                uint32_t* skipped);
+
+/* Present on a conversion worker instead of the loop thread.  The loop
+ * copies each frame to be shown out of the core's buffer and hands it
+ * off; conversion, post-processing, the slot publish / window blit and
+ * the shared-memory export then overlap the next retro_run().  One frame
+ * can wait for the worker (a newer hand-off replaces it) and the loop
+ * waits for a conversion still in progress rather than queue more.
+ * Screenshots, recording and the replay buffer still capture on the loop
+ * thread, from the exact frame just run.  Disables core rendering into
+ * the display slots.  Takes effect between frames. */
+YAGE_API void yage_frame_loop_set_pipelined(YageCore* core, int32_t enabled);
+
+/* Pipeline counters since yage_frame_loop_start: frames handed to the
+ * worker, and hand-offs replaced by a newer frame before it took them. */
+YAGE_API void yage_frame_loop_get_pipeline_stats(YageCore* core, uint32_t* handoffs,
+                                                 uint32_t* replaced);
+
+/* Blend presented frames with their predecessors to imitate LCD ghosting
+ * (30 Hz flicker transparency).  `weight_pct` is the share of the history
+ * in each output pixel (0..100, capped at ~94%): MIX mixes with the
+ * previous frame, DECAY with the previous output so changes fade out over
+ * several frames.  Applied before upscaling; ignored while the output
+ * format is YAGE_OUTPUT_RGB565. */
+YAGE_API void yage_frame_loop_set_frame_blend(YageCore* core, int32_t mode, int32_t weight_pct);
+
+/* Upscale presented frames with a YAGE_SCALER_* filter.  `factor` is only
+ * used by YAGE_SCALER_NEAREST (2..4); the other filters have a fixed one.
+ * Applies to the display slots and the Android texture window — the
+ * display width/height getters report the scaled size.  Ignored while the
+ * output format is YAGE_OUTPUT_RGB565.  Returns the effective factor. */
+YAGE_API int32_t yage_frame_loop_set_scaler(YageCore* core, int32_t mode, int32_t factor);
+
+/* Deprecated: the display handoff is lock-free and these are no-ops. */
 YAGE_API void yage_frame_loop_lock_display(YageCore* core);
 YAGE_API void yage_frame_loop_unlock_display(YageCore* core);
 
 /* Check whether the native frame loop is currently running. */
 YAGE_API int32_t yage_frame_loop_is_running(YageCore* core);
 
+/*
+ * Gameplay recording
+ *
+ * Every emulated frame and the core's audio are captured to
+ * `<path>.y4m` (YUV4MPEG2, 4:4:4 full range, at the core's frame rate) and
+ * `<path>.wav` (16-bit stereo PCM).  The emulation thread only queues the
+ * data; a background encoder thread converts and writes it.  When the
+ * encoder falls behind, frames are dropped (never waited for) and counted.
+ * Frames of a different resolution than the first one are dropped too.
+ * Not available on Windows.
+ */
+
+/* Start recording to `path` + ".y4m" / ".wav" (path without extension).
+ * Returns 0 on success, -1 if already recording, no game is loaded, or a
+ * file cannot be created. */
+YAGE_API int32_t yage_record_start(YageCore* core, const char* path);
+
+/* Stop recording: drains the queues and finishes both files (blocks until
+ * the encoder thread is done). */
+YAGE_API void yage_record_stop(YageCore* core);
+
+/* Returns 1 while a recording is in progress. */
+YAGE_API int32_t yage_record_is_active(YageCore* core);
+
+/* Counters of the current (or last) recording: frames written to the
+ * video file, frames dropped, and stereo audio frames dropped. */
+YAGE_API void yage_record_get_stats(YageCore* core, uint32_t* frames_written,
+                                    uint32_t* frames_dropped, uint32_t* audio_frames_dropped);
+
+/*
+ * Instant replay
+ *
+ * An always-on ring of the last N seconds of frames and audio, compressed
+ * in memory by a worker thread (XOR delta against the previous frame plus
+ * LZ, a keyframe every second).  Oldest frames are evicted in one-second
+ * groups to respect both the duration and the byte cap.  A resolution or
+ * output-format change restarts the buffer.  Not available on Windows.
+ */
+
+/* Keep the last `seconds` of gameplay in at most `max_bytes` of compressed
+ * memory (0 = 64 MiB).  Reconfiguring discards the buffered frames;
+ * seconds <= 0 turns the buffer off.  Uses the loaded game's frame rate,
+ * so configure after yage_core_load_rom.  Returns 0 on success, -1 on
+ * failure. */
+YAGE_API int32_t yage_replay_buffer_configure(YageCore* core, int32_t seconds, int64_t max_bytes);
+
+/* Write the buffered clip to `path` + ".y4m" / ".wav" (same formats as
+ * recording).  Decodes and writes on the calling thread while capture
+ * continues.  Returns the number of frames written, or -1. */
+YAGE_API int32_t yage_replay_buffer_dump(YageCore* core, const char* path);
+
+/* Frames and compressed bytes currently buffered, and frames dropped
+ * because the compression worker fell behind. */
+YAGE_API void yage_replay_buffer_get_stats(YageCore* core, uint32_t* frames, uint32_t* bytes,
+                                           uint32_t* dropped);
+
+/*
+ * Shared-memory frame export
+ *
+ * Every presented frame, as the core produced it (before display
+ * post-processing), is copied into a ring in a POSIX shared-memory object
+ * that capture and streaming tools can map read-only.  Each slot carries
+ * a sequence number, a CLOCK_MONOTONIC timestamp, the size and the
+ * YAGE_OUTPUT_* format; readers validate a slot seqlock-style and can
+ * never hold up the frame thread.  The layout is documented in
+ * yage_shm.h.  Linux / macOS only.
+ */
+
+/* Create the shared-memory object `name` (e.g. "/yage-frames") with
+ * `slots` frames (0 = 3, clamped to 2..16), each sized for the largest
+ * frame the loaded game declared.  Returns 0 on success, -1 on failure or
+ * if an export is already running. */
+YAGE_API int32_t yage_frame_export_start(YageCore* core, const char* name, int32_t slots);
+
+/* Stop exporting and unlink the object.  Also done by yage_core_destroy. */
+YAGE_API void yage_frame_export_stop(YageCore* core);
+
+YAGE_API int32_t yage_frame_export_is_active(YageCore* core);
+
+/* Frames published, and frames dropped because they did not fit a slot. */
+YAGE_API void yage_frame_export_get_stats(YageCore* core, uint32_t* published,
+                                          uint32_t* dropped);
+
+/*
+ * Screenshots and save-state thumbnails
+ *
+ * The newest emulated frame is copied on the thread that drives
+ * retro_run() (the frame loop after its next frame, or immediately when
+ * the loop is stopped), then converted, downscaled and encoded to `path`
+ * on a background thread.  Completion is reported through `callback` from
+ * that thread — use a NativeCallable.listener.  On Windows the encode runs
+ * synchronously and the callback fires before yage_screenshot_save
+ * returns.
+ */
+
+/* `request_id` as returned by yage_screenshot_save; `result` is 0 when the
+ * file was written, -1 otherwise. */
+typedef void (*yage_screenshot_callback_t)(int32_t request_id, int32_t result);
+
+/* Save the current frame as YAGE_IMAGE_PNG / YAGE_IMAGE_QOI.  The image is
+ * shrunk by the smallest integer factor that fits max_width × max_height
+ * (0 = no limit).  Call from the thread that starts / stops the frame loop.
+ * Requests made while the frame loop runs queue up and are all served
+ * after its next frame.  Returns a request id (> 0), or -1 if no game is
+ * loaded or the arguments are invalid. */
+YAGE_API int32_t yage_screenshot_save(YageCore* core, const char* path, int32_t format,
+                                      int32_t max_width, int32_t max_height,
+                                      yage_screenshot_callback_t callback);
+
 /*
  * Android Texture Rendering — zero-copy frame delivery
  *
@@ -276,10 +630,16 @@ YAGE_API int32_t yage_frame_loop_is_running(YageCore* core);
  *      writes pixels directly to the ANativeWindow at ~60 Hz.
  *   3. Flutter composites the Texture widget — zero Dart-side allocation.
  *
- * On non-Android platforms yage_texture_blit() is a no-op returning -1.
+ * On Linux the GTK runner registers an FlPixelBufferTexture and attaches
+ * to it with yage_texture_attach(); the frame loop (or yage_texture_blit)
+ * publishes display slots and signals frame-available, and copy_pixels
+ * takes the newest slot via yage_texture_acquire_pixels() without copying.
+ *
+ * On Windows yage_texture_blit() is a no-op returning -1.
  */
 
-/* Blit the current video buffer to the attached ANativeWindow surface.
+/* Blit the current video buffer to the attached ANativeWindow surface
+ * (Linux: publish it to the attached texture).
  * Call from the Dart Timer frame loop path (the native frame loop
  * blits automatically).
  * Returns 0 on success, -1 if no surface is attached or blit fails. */
@@ -289,6 +649,20 @@ YAGE_API int yage_texture_blit(YageCore* core);
  * Returns 1 if attached, 0 if not. */
 YAGE_API int32_t yage_texture_is_attached(YageCore* core);
 
+/* Linux runner only.  Attach the texture's frame-available notifier
+ * (called from the frame loop thread); NULL detaches, and no notifier call
+ * is in progress once it returns.  While attached the caller of
+ * yage_texture_acquire_pixels() is the display reader and the Dart display
+ * buffer getters return nothing. */
+typedef void (*yage_texture_frame_available_t)(void* user_data);
+YAGE_API void yage_texture_attach(yage_texture_frame_available_t frame_available,
+                                  void* user_data);
+
+/* Newest published frame as RGBA8888, valid until the next call (raster
+ * thread, from copy_pixels).  Returns a 1×1 black pixel before the first
+ * frame. */
+YAGE_API const uint8_t* yage_texture_acquire_pixels(uint32_t* width, uint32_t* height);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,126 @@
+/*
+ * YAGE LZ — Implementation
+ *
+ * Greedy matcher over a 4096-entry hash of 4-byte sequences.  Positions
+ * that keep missing are skipped at a growing stride, so incompressible
+ * input costs little more than a copy.
+ */
+
+#include "yage_lz.h"
+
+#include <string.h>
+
+#define LZ_HASH_BITS   12
+#define LZ_MIN_MATCH   4
+#define LZ_MAX_OFFSET  65535
+#define LZ_SKIP_SHIFT  6   /* after 64 missed positions, step by 2, … */
+
+static inline uint32_t lz_read32(const uint8_t* p) {
+    uint32_t v;
+    memcpy(&v, p, 4);
+    return v;
+}
+
+static inline uint64_t lz_read64(const uint8_t* p) {
+    uint64_t v;
+    memcpy(&v, p, 8);
+    return v;
+}
+
+static inline uint32_t lz_hash(uint32_t v) {
+    return (v * 2654435761u) >> (32 - LZ_HASH_BITS);
+}
+
+static uint8_t* lz_put_length(uint8_t* op, size_t len) {
+    for (; len >= 255; len -= 255) *op++ = 255;
+    *op++ = (uint8_t)len;
+    return op;
+}
+
+/* Emit one sequence; match_len 0 means literals only (the final one). */
+static uint8_t* lz_put_sequence(uint8_t* op, const uint8_t* lit, size_t lit_len,
+                                size_t offset, size_t match_len) {
+    uint8_t* token = op++;
+    size_t ml = match_len ? match_len - LZ_MIN_MATCH : 0;
+    *token = (uint8_t)(((lit_len < 15 ? lit_len : 15) << 4) | (ml < 15 ? ml : 15));
+    if (lit_len >= 15) op = lz_put_length(op, lit_len - 15);
+    memcpy(op, lit, lit_len);
+    op += lit_len;
+    if (match_len) {
+        *op++ = (uint8_t)offset;
+        *op++ = (uint8_t)(offset >> 8);
+        if (ml >= 15) op = lz_put_length(op, ml - 15);
+    }
+    return op;
+}
+
+size_t yage_lz_compress(const uint8_t* src, size_t n, uint8_t* dst, size_t dst_cap) {
+    if (dst_cap < YAGE_LZ_BOUND(n)) return 0;
+
+    uint32_t table[1u << LZ_HASH_BITS];
+    memset(table, 0, sizeof(table));
+    uint8_t* op = dst;
+    size_t ip = 0, anchor = 0;
+
+    while (n >= LZ_MIN_MATCH && ip <= n - LZ_MIN_MATCH) {
+        uint32_t seq = lz_read32(src + ip);
+        uint32_t h = lz_hash(seq);
+        size_t cand = table[h];
+        table[h] = (uint32_t)ip;
+        if (cand >= ip || ip - cand > LZ_MAX_OFFSET || lz_read32(src + cand) != seq) {
+            ip += 1 + ((ip - anchor) >> LZ_SKIP_SHIFT);
+            continue;
+        }
+        size_t len = LZ_MIN_MATCH;
+        while (ip + len + 8 <= n && lz_read64(src + cand + len) == lz_read64(src + ip + len)) len += 8;
+        while (ip + len < n && src[cand + len] == src[ip + len]) len++;
+
+        op = lz_put_sequence(op, src + anchor, ip - anchor, ip - cand, len);
+        ip += len;
+        anchor = ip;
+    }
+    op = lz_put_sequence(op, src + anchor, n - anchor, 0, 0);
+    return (size_t)(op - dst);
+}
+
+/* Read a 255-continued length extension; returns 0 on truncated input. */
+static int lz_get_length(const uint8_t* src, size_t n, size_t* ip, size_t* len) {
+    uint8_t b;
+    do {
+        if (*ip >= n) return 0;
+        b = src[(*ip)++];
+        *len += b;
+    } while (b == 255);
+    return 1;
+}
+
+size_t yage_lz_decompress(const uint8_t* src, size_t n, uint8_t* dst, size_t dst_cap) {
+    size_t ip = 0, op = 0;
+    while (ip < n) {
+        uint8_t token = src[ip++];
+        size_t lit = token >> 4;
+        if (lit == 15 && !lz_get_length(src, n, &ip, &lit)) return 0;
+        if (lit > n - ip || lit > dst_cap - op) return 0;
+        memcpy(dst + op, src + ip, lit);
+        ip += lit;
+        op += lit;
+        if (ip == n) break;   /* final literals-only sequence */
+
+        if (n - ip < 2) return 0;
+        size_t offset = (size_t)src[ip] | ((size_t)src[ip + 1] << 8);
+        ip += 2;
+        size_t len = (token & 15) + LZ_MIN_MATCH;
+        if ((token & 15) == 15 && !lz_get_length(src, n, &ip, &len)) return 0;
+        if (offset == 0 || offset > op || len > dst_cap - op) return 0;
+
+        uint8_t* d = dst + op;
+        const uint8_t* s = d - offset;
+        if (offset >= len) {
+            memcpy(d, s, len);
+        } else {
+            for (size_t i = 0; i < len; i++) d[i] = s[i];   /* overlapping run */
+        }
+        op += len;
+    }
+    return op;
+}
@@ -0,0 +1,40 @@
+/*
+ * YAGE LZ — small fast byte-oriented LZ77 codec
+ *
+ * An LZ4-style block format: each sequence is a token byte (literal run
+ * length in the high nibble, match length − 4 in the low nibble, 15 meaning
+ * "continued in 255-valued bytes"), the literals, then a 16-bit
+ * little-endian match offset.  The last sequence carries literals only.
+ *
+ * Tuned for XOR-delta frames, which are mostly zero runs; no entropy
+ * stage.  Used to keep the instant-replay buffer compact in memory.
+ *
+ * Internal to yage_core — not part of the FFI surface.
+ */
+
+#ifndef YAGE_LZ_H
+#define YAGE_LZ_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Worst-case compressed size of `n` input bytes. */
+#define YAGE_LZ_BOUND(n) ((n) + (n) / 255 + 16)
+
+/* Compress `n` bytes of `src` into `dst`.  Returns the compressed size,
+ * or 0 if `dst_cap` is below YAGE_LZ_BOUND(n). */
+size_t yage_lz_compress(const uint8_t* src, size_t n, uint8_t* dst, size_t dst_cap);
+
+/* Decompress `n` bytes of `src` into `dst`.  Returns the decompressed size,
+ * or 0 if the input is malformed or would overrun `dst_cap`. */
+size_t yage_lz_decompress(const uint8_t* src, size_t n, uint8_t* dst, size_t dst_cap);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* YAGE_LZ_H */
@@ -0,0 +1,767 @@
+/*
+ * YAGE Pixel Conversion Kernels — Implementation
+ *
+ * Every converter follows the same three steps per block of pixels:
+ *
+ *   1. load    decode the source format into 8-bit R, G, B channels
+ *   2. apply   contrast boost (CONTRAST) or nothing (PLAIN)
+ *   3. store   pack as ABGR — or, for PALETTE, classify luminance into
+ *              one of 4 shades and store the palette colour directly
+ *
+ * The store step also picks the output layout: RGBA8888 (ABGR words),
+ * BGRA8888 (red and blue swapped, palette swizzled to match), RGB565 or
+ * INDEX8 (the PALETTE shade number itself, one byte).  The SIMD paths
+ * cover the two 32-bit layouts; RGB565 and INDEX8 output are packed by the
+ * scalar path or, for 16-bit sources, a lookup table.
+ *
+ * The scalar path is the reference; the SIMD paths reproduce it exactly,
+ * including the truncating `(c - 128) * 110 / 100 + 128` contrast formula.
+ * That formula equals trunc((c - 128) * 11 / 10) + 128, and for
+ * |x| <= 1408 trunc(x / 10) == (|x| * 6554) >> 16 with the sign restored,
+ * which maps onto a 16-bit multiply-high on every instruction set.
+ */
+
+#include "yage_pixconv.h"
+#include "yage_libretro.h"  /* RETRO_PIXEL_FORMAT_*, YAGE_OUTPUT_* */
+
+#include <stddef.h>
+#include <string.h>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define YAGE_HAVE_SSE2 1
+#include <emmintrin.h>
+#endif
+
+/* AVX2 kernels are compiled with a per-function target attribute and only
+ * selected after a runtime CPUID check, so the library still loads on
+ * pre-Haswell x86-64 (e.g. older Android x86_64 emulators). */
+#if defined(YAGE_HAVE_SSE2) && (defined(__GNUC__) || defined(__clang__))
+#define YAGE_HAVE_AVX2 1
+#include <immintrin.h>
+#define YAGE_AVX2_FN __attribute__((target("avx2")))
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define YAGE_HAVE_NEON 1
+#include <arm_neon.h>
+#endif
+
+/* ── Scalar reference ─────────────────────────────────────────────────── */
+
+/* Color correction for GBA - makes colors more vibrant on modern displays */
+static inline uint32_t apply_color_correction(uint8_t r, uint8_t g, uint8_t b) {
+    /* GBA color correction - slight boost to saturation and contrast */
+    /* This compensates for the original GBA's dark, non-backlit screen */
+    int ri = r, gi = g, bi = b;
+
+    /* Boost contrast slightly */
+    ri = (ri - 128) * 110 / 100 + 128;
+    gi = (gi - 128) * 110 / 100 + 128;
+    bi = (bi - 128) * 110 / 100 + 128;
+
+    /* Clamp values */
+    if (ri < 0) ri = 0;
+    if (ri > 255) ri = 255;
+    if (gi < 0) gi = 0;
+    if (gi > 255) gi = 255;
+    if (bi < 0) bi = 0;
+    if (bi > 255) bi = 255;
+
+    /* Return as ABGR (which is RGBA in little-endian memory order for Flutter) */
+    return 0xFF000000 | ((uint32_t)bi << 16) | ((uint32_t)gi << 8) | (uint32_t)ri;
+}
+
+/* Map an RGB pixel to one of 4 palette colors based on luminance.
+ * GB games output 4 distinct shades - we classify by luminance thresholds. */
+static inline uint32_t apply_gb_palette(uint8_t r, uint8_t g, uint8_t b,
+                                        const uint32_t* palette) {
+    /* Fast luminance approximation: (r*2 + g*5 + b) / 8 */
+    int lum = (r * 2 + g * 5 + b) >> 3;
+
+    /* Map to 4 levels with thresholds tuned for mGBA's GB output */
+    if (lum >= 192) return palette[0];       /* Lightest */
+    else if (lum >= 128) return palette[1];  /* Light */
+    else if (lum >= 64) return palette[2];   /* Dark */
+    else return palette[3];                  /* Darkest */
+}
+
+static inline uint32_t scalar_pixel(uint8_t r, uint8_t g, uint8_t b,
+                                    YageConvMode mode, const uint32_t* palette) {
+    if (mode == YAGE_CONV_PALETTE) {
+        return apply_gb_palette(r, g, b, palette);
+    }
+    if (mode == YAGE_CONV_CONTRAST) {
+        return apply_color_correction(r, g, b);
+    }
+    return 0xFF000000 | ((uint32_t)b << 16) | ((uint32_t)g << 8) | (uint32_t)r;
+}
+
+/* ABGR word → ARGB word (BGRA bytes in little-endian memory) */
+static inline uint32_t abgr_to_argb(uint32_t c) {
+    return (c & 0xFF00FF00) | ((c >> 16) & 0xFF) | ((c & 0xFF) << 16);
+}
+
+/* ABGR word → RGB565 (truncating, like every 8-bit → 5/6-bit packer) */
+static inline uint16_t abgr_to_565(uint32_t c) {
+    return (uint16_t)(((c & 0xF8) << 8) | ((c & 0xFC00) >> 5) | ((c >> 19) & 0x1F));
+}
+
+/* PALETTE "colours" that make the kernels emit shade indices */
+static const uint32_t k_shade_index[4] = { 0, 1, 2, 3 };
+
+static inline void scalar_store(void* dst, int x, uint32_t abgr, int out) {
+    if (out == YAGE_OUTPUT_INDEX8) {
+        ((uint8_t*)dst)[x] = (uint8_t)abgr;
+    } else if (out == YAGE_OUTPUT_RGB565) {
+        ((uint16_t*)dst)[x] = abgr_to_565(abgr);
+    } else if (out == YAGE_OUTPUT_BGRA8888) {
+        ((uint32_t*)dst)[x] = abgr_to_argb(abgr);
+    } else {
+        ((uint32_t*)dst)[x] = abgr;
+    }
+}
+
+/* `fmt`, `mode` and `out` are compile-time constants at every call site, so
+ * each wrapper below gets its own branch-free inner loop. */
+static inline void scalar_row(void* dst, const void* src, int width,
+                              const uint32_t* palette, int fmt, YageConvMode mode,
+                              int out) {
+    if (out == YAGE_OUTPUT_INDEX8) palette = k_shade_index;
+    if (fmt == RETRO_PIXEL_FORMAT_XRGB8888) {
+        const uint32_t* row = (const uint32_t*)src;
+        for (int x = 0; x < width; x++) {
+            uint32_t pixel = row[x];
+            uint8_t r = (pixel >> 16) & 0xFF;
+            uint8_t g = (pixel >> 8) & 0xFF;
+            uint8_t b = pixel & 0xFF;
+            scalar_store(dst, x, scalar_pixel(r, g, b, mode, palette), out);
+        }
+    } else if (fmt == RETRO_PIXEL_FORMAT_RGB565) {
+        const uint16_t* row = (const uint16_t*)src;
+        for (int x = 0; x < width; x++) {
+            uint16_t pixel = row[x];
+            /* RGB565: RRRRRGGGGGGBBBBB */
+            uint8_t r = (pixel >> 11) & 0x1F;
+            uint8_t g = (pixel >> 5) & 0x3F;
+            uint8_t b = pixel & 0x1F;
+            /* Expand to 8-bit with proper bit replication */
+            r = (r << 3) | (r >> 2);
+            g = (g << 2) | (g >> 4);
+            b = (b << 3) | (b >> 2);
+            scalar_store(dst, x, scalar_pixel(r, g, b, mode, palette), out);
+        }
+    } else {
+        const uint16_t* row = (const uint16_t*)src;
+        for (int x = 0; x < width; x++) {
+            uint16_t pixel = row[x];
+            uint8_t r = (pixel >> 10) & 0x1F;
+            uint8_t g = (pixel >> 5) & 0x1F;
+            uint8_t b = pixel & 0x1F;
+            r = (r << 3) | (r >> 2);
+            g = (g << 3) | (g >> 2);
+            b = (b << 3) | (b >> 2);
+            scalar_store(dst, x, scalar_pixel(r, g, b, mode, palette), out);
+        }
+    }
+}
+
+/* Advance a source row pointer by `x` pixels */
+static inline const void* src_at(const void* src, int x, int fmt) {
+    return (fmt == RETRO_PIXEL_FORMAT_XRGB8888)
+        ? (const void*)((const uint32_t*)src + x)
+        : (const void*)((const uint16_t*)src + x);
+}
+
+/* Palette entries in the output's byte order (32-bit outputs only) */
+static inline uint32_t palette_entry(const uint32_t* palette, int i, int out) {
+    return out == YAGE_OUTPUT_BGRA8888 ? abgr_to_argb(palette[i]) : palette[i];
+}
+
+/* ── SSE2 — 8 pixels per iteration, channels in 16-bit lanes ─────────── */
+
+#ifdef YAGE_HAVE_SSE2
+
+static inline void sse2_load(const void* src, int fmt,
+                             __m128i* r, __m128i* g, __m128i* b) {
+    if (fmt == RETRO_PIXEL_FORMAT_XRGB8888) {
+        const __m128i mff = _mm_set1_epi32(0xFF);
+        __m128i p0 = _mm_loadu_si128((const __m128i*)src);
+        __m128i p1 = _mm_loadu_si128((const __m128i*)src + 1);
+        /* Channels are <= 255 so signed saturation in packs is a no-op */
+        *r = _mm_packs_epi32(_mm_and_si128(_mm_srli_epi32(p0, 16), mff),
+                             _mm_and_si128(_mm_srli_epi32(p1, 16), mff));
+        *g = _mm_packs_epi32(_mm_and_si128(_mm_srli_epi32(p0, 8), mff),
+                             _mm_and_si128(_mm_srli_epi32(p1, 8), mff));
+        *b = _mm_packs_epi32(_mm_and_si128(p0, mff), _mm_and_si128(p1, mff));
+        return;
+    }
+
+    const __m128i m5 = _mm_set1_epi16(0x1F);
+    __m128i p = _mm_loadu_si128((const __m128i*)src);
+    __m128i r5, g5, b5;
+    b5 = _mm_and_si128(p, m5);
+    if (fmt == RETRO_PIXEL_FORMAT_RGB565) {
+        r5 = _mm_srli_epi16(p, 11);
+        __m128i g6 = _mm_and_si128(_mm_srli_epi16(p, 5), _mm_set1_epi16(0x3F));
+        *g = _mm_or_si128(_mm_slli_epi16(g6, 2), _mm_srli_epi16(g6, 4));
+    } else {
+        r5 = _mm_and_si128(_mm_srli_epi16(p, 10), m5);
+        g5 = _mm_and_si128(_mm_srli_epi16(p, 5), m5);
+        *g = _mm_or_si128(_mm_slli_epi16(g5, 3), _mm_srli_epi16(g5, 2));
+    }
+    *r = _mm_or_si128(_mm_slli_epi16(r5, 3), _mm_srli_epi16(r5, 2));
+    *b = _mm_or_si128(_mm_slli_epi16(b5, 3), _mm_srli_epi16(b5, 2));
+}
+
+static inline __m128i sse2_contrast(__m128i c) {
+    __m128i t = _mm_mullo_epi16(_mm_sub_epi16(c, _mm_set1_epi16(128)),
+                                _mm_set1_epi16(11));
+    __m128i sign = _mm_srai_epi16(t, 15);
+    __m128i a = _mm_sub_epi16(_mm_xor_si128(t, sign), sign);
+    __m128i q = _mm_mulhi_epu16(a, _mm_set1_epi16(6554));
+    q = _mm_sub_epi16(_mm_xor_si128(q, sign), sign);
+    c = _mm_add_epi16(q, _mm_set1_epi16(128));
+    c = _mm_max_epi16(c, _mm_setzero_si128());
+    return _mm_min_epi16(c, _mm_set1_epi16(255));
+}
+
+static inline void sse2_store_abgr(uint32_t* dst, __m128i r, __m128i g, __m128i b) {
+    __m128i rg = _mm_or_si128(r, _mm_slli_epi16(g, 8));
+    __m128i ba = _mm_or_si128(b, _mm_set1_epi16((short)0xFF00));
+    _mm_storeu_si128((__m128i*)dst,     _mm_unpacklo_epi16(rg, ba));
+    _mm_storeu_si128((__m128i*)dst + 1, _mm_unpackhi_epi16(rg, ba));
+}
+
+static inline __m128i sse2_select(__m128i mask, __m128i a, __m128i b) {
+    return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+static inline __m128i sse2_shade(__m128i lum32, const __m128i* pal) {
+    __m128i out = pal[3];
+    out = sse2_select(_mm_cmpgt_epi32(lum32, _mm_set1_epi32(63)),  pal[2], out);
+    out = sse2_select(_mm_cmpgt_epi32(lum32, _mm_set1_epi32(127)), pal[1], out);
+    out = sse2_select(_mm_cmpgt_epi32(lum32, _mm_set1_epi32(191)), pal[0], out);
+    return out;
+}
+
+static inline void sse2_store_palette(uint32_t* dst, __m128i r, __m128i g, __m128i b,
+                                      const __m128i* pal) {
+    __m128i lum = _mm_add_epi16(_mm_slli_epi16(r, 1),
+                                _mm_mullo_epi16(g, _mm_set1_epi16(5)));
+    lum = _mm_srli_epi16(_mm_add_epi16(lum, b), 3);
+    const __m128i zero = _mm_setzero_si128();
+    _mm_storeu_si128((__m128i*)dst,     sse2_shade(_mm_unpacklo_epi16(lum, zero), pal));
+    _mm_storeu_si128((__m128i*)dst + 1, sse2_shade(_mm_unpackhi_epi16(lum, zero), pal));
+}
+
+static inline void sse2_row(uint32_t* dst, const void* src, int width,
+                            const uint32_t* palette, int fmt, YageConvMode mode,
+                            int out) {
+    __m128i pal[4];
+    for (int i = 0; i < 4; i++) {
+        pal[i] = _mm_set1_epi32(mode == YAGE_CONV_PALETTE
+                                ? (int)palette_entry(palette, i, out) : 0);
+    }
+
+    int x = 0;
+    for (; x + 8 <= width; x += 8) {
+        __m128i r, g, b;
+        sse2_load(src_at(src, x, fmt), fmt, &r, &g, &b);
+        if (mode == YAGE_CONV_PALETTE) {
+            sse2_store_palette(dst + x, r, g, b, pal);
+            continue;
+        }
+        if (mode == YAGE_CONV_CONTRAST) {
+            r = sse2_contrast(r);
+            g = sse2_contrast(g);
+            b = sse2_contrast(b);
+        }
+        if (out == YAGE_OUTPUT_BGRA8888) {
+            sse2_store_abgr(dst + x, b, g, r);
+        } else {
+            sse2_store_abgr(dst + x, r, g, b);
+        }
+    }
+    if (x < width) {
+        scalar_row(dst + x, src_at(src, x, fmt), width - x, palette, fmt, mode, out);
+    }
+}
+
+#endif /* YAGE_HAVE_SSE2 */
+
+/* ── AVX2 — 16 pixels per iteration, channels in 16-bit lanes ────────── */
+
+#ifdef YAGE_HAVE_AVX2
+
+static inline YAGE_AVX2_FN void avx2_load(const void* src, int fmt,
+                                          __m256i* r, __m256i* g, __m256i* b) {
+    if (fmt == RETRO_PIXEL_FORMAT_XRGB8888) {
+        const __m256i mff = _mm256_set1_epi32(0xFF);
+        __m256i p0 = _mm256_loadu_si256((const __m256i*)src);
+        __m256i p1 = _mm256_loadu_si256((const __m256i*)src + 1);
+        /* packs works per 128-bit lane: fix the pixel order with 0xD8 */
+        *r = _mm256_permute4x64_epi64(
+                _mm256_packs_epi32(_mm256_and_si256(_mm256_srli_epi32(p0, 16), mff),
+                                   _mm256_and_si256(_mm256_srli_epi32(p1, 16), mff)), 0xD8);
+        *g = _mm256_permute4x64_epi64(
+                _mm256_packs_epi32(_mm256_and_si256(_mm256_srli_epi32(p0, 8), mff),
+                                   _mm256_and_si256(_mm256_srli_epi32(p1, 8), mff)), 0xD8);
+        *b = _mm256_permute4x64_epi64(
+                _mm256_packs_epi32(_mm256_and_si256(p0, mff),
+                                   _mm256_and_si256(p1, mff)), 0xD8);
+        return;
+    }
+
+    const __m256i m5 = _mm256_set1_epi16(0x1F);
+    __m256i p = _mm256_loadu_si256((const __m256i*)src);
+    __m256i r5, g5, b5;
+    b5 = _mm256_and_si256(p, m5);
+    if (fmt == RETRO_PIXEL_FORMAT_RGB565) {
+        r5 = _mm256_srli_epi16(p, 11);
+        __m256i g6 = _mm256_and_si256(_mm256_srli_epi16(p, 5), _mm256_set1_epi16(0x3F));
+        *g = _mm256_or_si256(_mm256_slli_epi16(g6, 2), _mm256_srli_epi16(g6, 4));
+    } else {
+        r5 = _mm256_and_si256(_mm256_srli_epi16(p, 10), m5);
+        g5 = _mm256_and_si256(_mm256_srli_epi16(p, 5), m5);
+        *g = _mm256_or_si256(_mm256_slli_epi16(g5, 3), _mm256_srli_epi16(g5, 2));
+    }
+    *r = _mm256_or_si256(_mm256_slli_epi16(r5, 3), _mm256_srli_epi16(r5, 2));
+    *b = _mm256_or_si256(_mm256_slli_epi16(b5, 3), _mm256_srli_epi16(b5, 2));
+}
+
+static inline YAGE_AVX2_FN __m256i avx2_contrast(__m256i c) {
+    __m256i t = _mm256_mullo_epi16(_mm256_sub_epi16(c, _mm256_set1_epi16(128)),
+                                   _mm256_set1_epi16(11));
+    __m256i q = _mm256_mulhi_epu16(_mm256_abs_epi16(t), _mm256_set1_epi16(6554));
+    q = _mm256_sign_epi16(q, t);
+    c = _mm256_add_epi16(q, _mm256_set1_epi16(128));
+    c = _mm256_max_epi16(c, _mm256_setzero_si256());
+    return _mm256_min_epi16(c, _mm256_set1_epi16(255));
+}
+
+static inline YAGE_AVX2_FN void avx2_store_abgr(uint32_t* dst, __m256i r, __m256i g,
+                                                __m256i b) {
+    __m256i rg = _mm256_or_si256(r, _mm256_slli_epi16(g, 8));
+    __m256i ba = _mm256_or_si256(b, _mm256_set1_epi16((short)0xFF00));
+    /* unpack is per 128-bit lane: lo = px 0-3 | 8-11, hi = px 4-7 | 12-15 */
+    __m256i lo = _mm256_unpacklo_epi16(rg, ba);
+    __m256i hi = _mm256_unpackhi_epi16(rg, ba);
+    _mm256_storeu_si256((__m256i*)dst,     _mm256_permute2x128_si256(lo, hi, 0x20));
+    _mm256_storeu_si256((__m256i*)dst + 1, _mm256_permute2x128_si256(lo, hi, 0x31));
+}
+
+static inline YAGE_AVX2_FN __m256i avx2_shade(__m256i lum32, const __m256i* pal) {
+    __m256i out = pal[3];
+    out = _mm256_blendv_epi8(out, pal[2], _mm256_cmpgt_epi32(lum32, _mm256_set1_epi32(63)));
+    out = _mm256_blendv_epi8(out, pal[1], _mm256_cmpgt_epi32(lum32, _mm256_set1_epi32(127)));
+    out = _mm256_blendv_epi8(out, pal[0], _mm256_cmpgt_epi32(lum32, _mm256_set1_epi32(191)));
+    return out;
+}
+
+static inline YAGE_AVX2_FN void avx2_store_palette(uint32_t* dst, __m256i r, __m256i g,
+                                                   __m256i b, const __m256i* pal) {
+    __m256i lum = _mm256_add_epi16(_mm256_slli_epi16(r, 1),
+                                   _mm256_mullo_epi16(g, _mm256_set1_epi16(5)));
+    lum = _mm256_srli_epi16(_mm256_add_epi16(lum, b), 3);
+    __m256i lo = _mm256_cvtepu16_epi32(_mm256_castsi256_si128(lum));
+    __m256i hi = _mm256_cvtepu16_epi32(_mm256_extracti128_si256(lum, 1));
+    _mm256_storeu_si256((__m256i*)dst,     avx2_shade(lo, pal));
+    _mm256_storeu_si256((__m256i*)dst + 1, avx2_shade(hi, pal));
+}
+
+static inline YAGE_AVX2_FN void avx2_row(uint32_t* dst, const void* src, int width,
+                                         const uint32_t* palette, int fmt,
+                                         YageConvMode mode, int out) {
+    __m256i pal[4];
+    for (int i = 0; i < 4; i++) {
+        pal[i] = _mm256_set1_epi32(mode == YAGE_CONV_PALETTE
+                                   ? (int)palette_entry(palette, i, out) : 0);
+    }
+
+    int x = 0;
+    for (; x + 16 <= width; x += 16) {
+        __m256i r, g, b;
+        avx2_load(src_at(src, x, fmt), fmt, &r, &g, &b);
+        if (mode == YAGE_CONV_PALETTE) {
+            avx2_store_palette(dst + x, r, g, b, pal);
+            continue;
+        }
+        if (mode == YAGE_CONV_CONTRAST) {
+            r = avx2_contrast(r);
+            g = avx2_contrast(g);
+            b = avx2_contrast(b);
+        }
+        if (out == YAGE_OUTPUT_BGRA8888) {
+            avx2_store_abgr(dst + x, b, g, r);
+        } else {
+            avx2_store_abgr(dst + x, r, g, b);
+        }
+    }
+    if (x < width) {
+        /* SSE2 is always present alongside AVX2 — finish the row with it */
+        sse2_row(dst + x, src_at(src, x, fmt), width - x, palette, fmt, mode, out);
+    }
+}
+
+#endif /* YAGE_HAVE_AVX2 */
+
+/* ── NEON — 8 pixels per iteration, channels in 8-bit lanes ───────────── */
+
+#ifdef YAGE_HAVE_NEON
+
+static inline void neon_load(const void* src, int fmt,
+                             uint8x8_t* r, uint8x8_t* g, uint8x8_t* b) {
+    if (fmt == RETRO_PIXEL_FORMAT_XRGB8888) {
+        /* Little-endian 0x00RRGGBB is B, G, R, X in memory */
+        uint8x8x4_t px = vld4_u8((const uint8_t*)src);
+        *b = px.val[0];
+        *g = px.val[1];
+        *r = px.val[2];
+        return;
+    }
+
+    const uint16x8_t m5 = vdupq_n_u16(0x1F);
+    uint16x8_t p = vld1q_u16((const uint16_t*)src);
+    uint16x8_t r5, g5, b5;
+    b5 = vandq_u16(p, m5);
+    if (fmt == RETRO_PIXEL_FORMAT_RGB565) {
+        r5 = vshrq_n_u16(p, 11);
+        uint16x8_t g6 = vandq_u16(vshrq_n_u16(p, 5), vdupq_n_u16(0x3F));
+        *g = vmovn_u16(vorrq_u16(vshlq_n_u16(g6, 2), vshrq_n_u16(g6, 4)));
+    } else {
+        r5 = vandq_u16(vshrq_n_u16(p, 10), m5);
+        g5 = vandq_u16(vshrq_n_u16(p, 5), m5);
+        *g = vmovn_u16(vorrq_u16(vshlq_n_u16(g5, 3), vshrq_n_u16(g5, 2)));
+    }
+    *r = vmovn_u16(vorrq_u16(vshlq_n_u16(r5, 3), vshrq_n_u16(r5, 2)));
+    *b = vmovn_u16(vorrq_u16(vshlq_n_u16(b5, 3), vshrq_n_u16(b5, 2)));
+}
+
+static inline uint8x8_t neon_contrast(uint8x8_t c) {
+    int16x8_t v = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(c)), vdupq_n_s16(128));
+    int16x8_t t = vmulq_n_s16(v, 11);
+    /* doubling multiply-high: (2 * |t| * 3277) >> 16 == (|t| * 6554) >> 16 */
+    int16x8_t q = vqdmulhq_n_s16(vabsq_s16(t), 3277);
+    q = vbslq_s16(vcltq_s16(t, vdupq_n_s16(0)), vnegq_s16(q), q);
+    return vqmovun_s16(vaddq_s16(q, vdupq_n_s16(128)));
+}
+
+static inline void neon_row(uint32_t* dst, const void* src, int width,
+                            const uint32_t* palette, int fmt, YageConvMode mode,
+                            int out) {
+    /* Per-channel shade tables for vtbl: entry i = channel of palette[i] */
+    uint8x8_t tab_r = vdup_n_u8(0), tab_g = tab_r, tab_b = tab_r, tab_a = tab_r;
+    if (mode == YAGE_CONV_PALETTE) {
+        uint8_t t[4][8] = {{0}};
+        for (int i = 0; i < 4; i++) {
+            uint32_t c = palette_entry(palette, i, out);
+            t[0][i] = (uint8_t)(c);
+            t[1][i] = (uint8_t)(c >> 8);
+            t[2][i] = (uint8_t)(c >> 16);
+            t[3][i] = (uint8_t)(c >> 24);
+        }
+        tab_r = vld1_u8(t[0]);
+        tab_g = vld1_u8(t[1]);
+        tab_b = vld1_u8(t[2]);
+        tab_a = vld1_u8(t[3]);
+    }
+
+    int x = 0;
+    for (; x + 8 <= width; x += 8) {
+        uint8x8_t r, g, b;
+        uint8x8x4_t px;
+        neon_load(src_at(src, x, fmt), fmt, &r, &g, &b);
+        if (mode == YAGE_CONV_PALETTE) {
+            uint16x8_t lum = vaddq_u16(vshll_n_u8(r, 1), vmull_u8(g, vdup_n_u8(5)));
+            lum = vshrq_n_u16(vaddw_u8(lum, b), 3);
+            /* lum >= 192 → 0 (lightest) ... lum < 64 → 3 (darkest) */
+            uint8x8_t idx = vsub_u8(vdup_n_u8(3), vmovn_u16(vshrq_n_u16(lum, 6)));
+            px.val[0] = vtbl1_u8(tab_r, idx);
+            px.val[1] = vtbl1_u8(tab_g, idx);
+            px.val[2] = vtbl1_u8(tab_b, idx);
+            px.val[3] = vtbl1_u8(tab_a, idx);
+        } else {
+            if (mode == YAGE_CONV_CONTRAST) {
+                r = neon_contrast(r);
+                g = neon_contrast(g);
+                b = neon_contrast(b);
+            }
+            px.val[0] = (out == YAGE_OUTPUT_BGRA8888) ? b : r;
+            px.val[1] = g;
+            px.val[2] = (out == YAGE_OUTPUT_BGRA8888) ? r : b;
+            px.val[3] = vdup_n_u8(0xFF);
+        }
+        vst4_u8((uint8_t*)(dst + x), px);
+    }
+    if (x < width) {
+        scalar_row(dst + x, src_at(src, x, fmt), width - x, palette, fmt, mode, out);
+    }
+}
+
+#endif /* YAGE_HAVE_NEON */
+
+/* ── Specialised entry points and dispatch tables ─────────────────────── */
+
+/* One function per (format, mode, output) so every inner loop is
+ * branch-free.  Table layout is [pixel_format][mode];
+ * RETRO_PIXEL_FORMAT_* are 0..2. */
+#define YAGE_ROW_FN(level, attr, fname, fmt, mode, out)                          \
+    static attr void level##_##fname(void* dst, const void* src, int width,      \
+                                     const uint32_t* palette) {                  \
+        level##_row((uint32_t*)dst, src, width, palette, fmt, mode, out);        \
+    }
+
+#define YAGE_ROW_SET(level, attr, oname, out)                                                  \
+    YAGE_ROW_FN(level, attr, oname##_1555_plain,    RETRO_PIXEL_FORMAT_0RGB1555, YAGE_CONV_PLAIN,    out) \
+    YAGE_ROW_FN(level, attr, oname##_1555_contrast, RETRO_PIXEL_FORMAT_0RGB1555, YAGE_CONV_CONTRAST, out) \
+    YAGE_ROW_FN(level, attr, oname##_1555_palette,  RETRO_PIXEL_FORMAT_0RGB1555, YAGE_CONV_PALETTE,  out) \
+    YAGE_ROW_FN(level, attr, oname##_8888_plain,    RETRO_PIXEL_FORMAT_XRGB8888, YAGE_CONV_PLAIN,    out) \
+    YAGE_ROW_FN(level, attr, oname##_8888_contrast, RETRO_PIXEL_FORMAT_XRGB8888, YAGE_CONV_CONTRAST, out) \
+    YAGE_ROW_FN(level, attr, oname##_8888_palette,  RETRO_PIXEL_FORMAT_XRGB8888, YAGE_CONV_PALETTE,  out) \
+    YAGE_ROW_FN(level, attr, oname##_565_plain,     RETRO_PIXEL_FORMAT_RGB565,   YAGE_CONV_PLAIN,    out) \
+    YAGE_ROW_FN(level, attr, oname##_565_contrast,  RETRO_PIXEL_FORMAT_RGB565,   YAGE_CONV_CONTRAST, out) \
+    YAGE_ROW_FN(level, attr, oname##_565_palette,   RETRO_PIXEL_FORMAT_RGB565,   YAGE_CONV_PALETTE,  out) \
+    static const yage_pixconv_row_fn level##_##oname##_rows[3][3] = {                          \
+        { level##_##oname##_1555_plain, level##_##oname##_1555_contrast, level##_##oname##_1555_palette }, \
+        { level##_##oname##_8888_plain, level##_##oname##_8888_contrast, level##_##oname##_8888_palette }, \
+        { level##_##oname##_565_plain,  level##_##oname##_565_contrast,  level##_##oname##_565_palette  }, \
+    };
+
+/* The 32-bit layouts exist for every instruction set; RGB565 output is
+ * scalar only (or a lookup table — see yage_pixconv_build_lut). */
+#define YAGE_ROW_SETS_32(level, attr)                      \
+    YAGE_ROW_SET(level, attr, rgba, YAGE_OUTPUT_RGBA8888)  \
+    YAGE_ROW_SET(level, attr, bgra, YAGE_OUTPUT_BGRA8888)
+
+YAGE_ROW_SETS_32(scalar, )
+YAGE_ROW_SET(scalar, , rgb565, YAGE_OUTPUT_RGB565)
+YAGE_ROW_SET(scalar, , index8, YAGE_OUTPUT_INDEX8)
+#ifdef YAGE_HAVE_SSE2
+YAGE_ROW_SETS_32(sse2, )
+#endif
+#ifdef YAGE_HAVE_AVX2
+YAGE_ROW_SETS_32(avx2, YAGE_AVX2_FN)
+#endif
+#ifdef YAGE_HAVE_NEON
+YAGE_ROW_SETS_32(neon, )
+#endif
+
+#undef YAGE_ROW_SETS_32
+#undef YAGE_ROW_SET
+#undef YAGE_ROW_FN
+
+static int level_supported(YageSimdLevel level) {
+    switch (level) {
+        case YAGE_SIMD_SCALAR:
+            return 1;
+#ifdef YAGE_HAVE_SSE2
+        case YAGE_SIMD_SSE2:
+            return 1;
+#endif
+#ifdef YAGE_HAVE_AVX2
+        case YAGE_SIMD_AVX2:
+            return __builtin_cpu_supports("avx2") ? 1 : 0;
+#endif
+#ifdef YAGE_HAVE_NEON
+        case YAGE_SIMD_NEON:
+            return 1;
+#endif
+        default:
+            return 0;
+    }
+}
+
+YageSimdLevel yage_pixconv_best_level(void) {
+    static int s_best = -1;  /* benign race: every thread computes the same value */
+    if (s_best < 0) {
+        YageSimdLevel best = YAGE_SIMD_SCALAR;
+        if (level_supported(YAGE_SIMD_NEON)) best = YAGE_SIMD_NEON;
+        if (level_supported(YAGE_SIMD_SSE2)) best = YAGE_SIMD_SSE2;
+        if (level_supported(YAGE_SIMD_AVX2)) best = YAGE_SIMD_AVX2;
+        s_best = (int)best;
+    }
+    return (YageSimdLevel)s_best;
+}
+
+/* Pick the [format][mode] table for `out`; RGB565 only has scalar rows */
+#define YAGE_PICK_ROWS(level)                                              \
+    ((out) == YAGE_OUTPUT_BGRA8888 ? level##_bgra_rows[pixel_format][mode] \
+                                   : level##_rgba_rows[pixel_format][mode])
+
+yage_pixconv_row_fn yage_pixconv_select_level(int pixel_format, YageConvMode mode,
+                                              int out, YageSimdLevel level) {
+    if (pixel_format < RETRO_PIXEL_FORMAT_0RGB1555 ||
+        pixel_format > RETRO_PIXEL_FORMAT_RGB565) return NULL;
+    if ((int)mode < YAGE_CONV_PLAIN || (int)mode > YAGE_CONV_PALETTE) return NULL;
+    if (out < YAGE_OUTPUT_RGBA8888 || out > YAGE_OUTPUT_INDEX8) return NULL;
+    if (!level_supported(level)) return NULL;
+
+    if (out == YAGE_OUTPUT_INDEX8) {
+        /* Shade indices only come out of the palette classifier */
+        return level == YAGE_SIMD_SCALAR && mode == YAGE_CONV_PALETTE
+            ? scalar_index8_rows[pixel_format][mode] : NULL;
+    }
+    if (out == YAGE_OUTPUT_RGB565) {
+        return level == YAGE_SIMD_SCALAR ? scalar_rgb565_rows[pixel_format][mode] : NULL;
+    }
+
+    switch (level) {
+        case YAGE_SIMD_SCALAR:
+            return YAGE_PICK_ROWS(scalar);
+#ifdef YAGE_HAVE_SSE2
+        case YAGE_SIMD_SSE2:
+            return YAGE_PICK_ROWS(sse2);
+#endif
+#ifdef YAGE_HAVE_AVX2
+        case YAGE_SIMD_AVX2:
+            return YAGE_PICK_ROWS(avx2);
+#endif
+#ifdef YAGE_HAVE_NEON
+        case YAGE_SIMD_NEON:
+            return YAGE_PICK_ROWS(neon);
+#endif
+        default:
+            return NULL;
+    }
+}
+
+#undef YAGE_PICK_ROWS
+
+yage_pixconv_row_fn yage_pixconv_select(int pixel_format, YageConvMode mode, int out) {
+    YageSimdLevel level = (out == YAGE_OUTPUT_RGB565 || out == YAGE_OUTPUT_INDEX8)
+                        ? YAGE_SIMD_SCALAR : yage_pixconv_best_level();
+    return yage_pixconv_select_level(pixel_format, mode, out, level);
+}
+
+int yage_pixconv_output_bpp(int out) {
+    if (out == YAGE_OUTPUT_INDEX8) return 1;
+    return out == YAGE_OUTPUT_RGB565 ? 2 : 4;
+}
+
+/* ── 16-bit lookup tables ─────────────────────────────────────────────── */
+
+int yage_pixconv_build_lut(uint32_t* lut, int pixel_format, YageConvMode mode,
+                           int out, const uint32_t* palette) {
+    if (!lut) return -1;
+    if (pixel_format != RETRO_PIXEL_FORMAT_RGB565 &&
+        pixel_format != RETRO_PIXEL_FORMAT_0RGB1555) return -1;
+
+    /* Build the 32-bit entries; RGB565 output packs them afterwards and
+     * INDEX8 entries are the shade numbers */
+    if (out == YAGE_OUTPUT_INDEX8) {
+        if (mode != YAGE_CONV_PALETTE) return -1;
+        palette = k_shade_index;
+    }
+    int out32 = (out == YAGE_OUTPUT_RGB565 || out == YAGE_OUTPUT_INDEX8)
+              ? YAGE_OUTPUT_RGBA8888 : out;
+    yage_pixconv_row_fn convert = yage_pixconv_select(pixel_format, mode, out32);
+    if (!convert) return -1;
+
+    /* Feed every source value through the regular converter in blocks, so
+     * the table is bit-exact with the direct kernels by construction. */
+    uint16_t block[256];
+    for (int base = 0; base < YAGE_PIXCONV_LUT_SIZE; base += 256) {
+        for (int i = 0; i < 256; i++) block[i] = (uint16_t)(base + i);
+        convert(lut + base, block, 256, palette);
+    }
+    if (out == YAGE_OUTPUT_RGB565) {
+        for (int i = 0; i < YAGE_PIXCONV_LUT_SIZE; i++) lut[i] = abgr_to_565(lut[i]);
+    }
+    return 0;
+}
+
+void yage_pixconv_row_lut16(void* dst, const void* src, int width,
+                            const uint32_t* table) {
+    const uint16_t* row = (const uint16_t*)src;
+    uint32_t* out = (uint32_t*)dst;
+    int x = 0;
+    for (; x + 4 <= width; x += 4) {
+        uint32_t a = table[row[x]];
+        uint32_t b = table[row[x + 1]];
+        uint32_t c = table[row[x + 2]];
+        uint32_t d = table[row[x + 3]];
+        out[x]     = a;
+        out[x + 1] = b;
+        out[x + 2] = c;
+        out[x + 3] = d;
+    }
+    for (; x < width; x++) {
+        out[x] = table[row[x]];
+    }
+}
+
+void yage_pixconv_row_lut16_565(void* dst, const void* src, int width,
+                                const uint32_t* table) {
+    const uint16_t* row = (const uint16_t*)src;
+    uint16_t* out = (uint16_t*)dst;
+    int x = 0;
+    for (; x + 4 <= width; x += 4) {
+        uint16_t a = (uint16_t)table[row[x]];
+        uint16_t b = (uint16_t)table[row[x + 1]];
+        uint16_t c = (uint16_t)table[row[x + 2]];
+        uint16_t d = (uint16_t)table[row[x + 3]];
+        out[x]     = a;
+        out[x + 1] = b;
+        out[x + 2] = c;
+        out[x + 3] = d;
+    }
+    for (; x < width; x++) {
+        out[x] = (uint16_t)table[row[x]];
+    }
+}
+
+void yage_pixconv_row_lut16_index8(void* dst, const void* src, int width,
+                                   const uint32_t* table) {
+    const uint16_t* row = (const uint16_t*)src;
+    uint8_t* out = (uint8_t*)dst;
+    int x = 0;
+    for (; x + 4 <= width; x += 4) {
+        uint8_t a = (uint8_t)table[row[x]];
+        uint8_t b = (uint8_t)table[row[x + 1]];
+        uint8_t c = (uint8_t)table[row[x + 2]];
+        uint8_t d = (uint8_t)table[row[x + 3]];
+        out[x]     = a;
+        out[x + 1] = b;
+        out[x + 2] = c;
+        out[x + 3] = d;
+    }
+    for (; x < width; x++) {
+        out[x] = (uint8_t)table[row[x]];
+    }
+}
+
+void yage_pixconv_row_index8_expand(void* dst, const void* src, int width,
+                                    const uint32_t* table) {
+    const uint8_t* row = (const uint8_t*)src;
+    uint32_t* out = (uint32_t*)dst;
+    int x = 0;
+    for (; x + 4 <= width; x += 4) {
+        uint32_t a = table[row[x] & 3];
+        uint32_t b = table[row[x + 1] & 3];
+        uint32_t c = table[row[x + 2] & 3];
+        uint32_t d = table[row[x + 3] & 3];
+        out[x]     = a;
+        out[x + 1] = b;
+        out[x + 2] = c;
+        out[x + 3] = d;
+    }
+    for (; x < width; x++) {
+        out[x] = table[row[x] & 3];
+    }
+}
+
+void yage_pixconv_row_copy16(void* dst, const void* src, int width,
+                             const uint32_t* table) {
+    (void)table;
+    memcpy(dst, src, (size_t)width * sizeof(uint16_t));
+}
+
+const char* yage_pixconv_level_name(YageSimdLevel level) {
+    switch (level) {
+        case YAGE_SIMD_SCALAR: return "scalar";
+        case YAGE_SIMD_SSE2:   return "SSE2";
+        case YAGE_SIMD_AVX2:   return "AVX2";
+        case YAGE_SIMD_NEON:   return "NEON";
+        default:               return "unknown";
+    }
+}
@@ -0,0 +1,120 @@
+/*
+ * YAGE Pixel Conversion Kernels
+ *
+ * Row converters that turn a libretro source row (RGB565, XRGB8888 or
+ * 0RGB1555) into 32-bit ABGR (RGBA bytes in little-endian memory — what
+ * Flutter and ANativeWindow expect).  Each converter also folds in one of
+ * the per-pixel transforms the wrapper applies:
+ *
+ *   PLAIN     straight channel expansion (NES/SNES/SMS/MD)
+ *   CONTRAST  GBA contrast boost (GB/GBC/GBA)
+ *   PALETTE   4-shade luminance remap (original GB with a custom palette)
+ *
+ * Output is RGBA8888 by default; BGRA8888 and RGB565 (YAGE_OUTPUT_*) are
+ * selected the same way.  INDEX8 output (PALETTE only) stores the shade
+ * number 0..3 instead of its colour; yage_pixconv_row_index8_expand
+ * recolours such rows.
+ *
+ * Vectorized variants exist for SSE2 and AVX2 (x86-64) and NEON
+ * (arm64 / armeabi-v7a).  All of them are bit-exact with the scalar
+ * reference.  The best variant for the running CPU is picked once via
+ * yage_pixconv_select() — the wrapper calls it whenever the pixel format
+ * or transform changes, never per frame.
+ *
+ * For 16-bit sources the whole transform can instead be baked into a
+ * 65,536-entry lookup table (yage_pixconv_build_lut) and applied with
+ * yage_pixconv_row_lut16 — one table load per pixel, no branches.
+ *
+ * Internal to yage_core — not part of the FFI surface.
+ */
+
+#ifndef YAGE_PIXCONV_H
+#define YAGE_PIXCONV_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Per-pixel transform folded into the row converter */
+typedef enum {
+    YAGE_CONV_PLAIN    = 0,
+    YAGE_CONV_CONTRAST = 1,
+    YAGE_CONV_PALETTE  = 2
+} YageConvMode;
+
+/* Instruction set a converter is written for */
+typedef enum {
+    YAGE_SIMD_SCALAR = 0,
+    YAGE_SIMD_SSE2   = 1,
+    YAGE_SIMD_AVX2   = 2,
+    YAGE_SIMD_NEON   = 3
+} YageSimdLevel;
+
+/* Convert `width` pixels of one source row into `dst` (32-, 16- or 8-bit
+ * pixels, depending on the output format the converter was selected for).
+ * `table` is the converter's lookup data: the 4 ABGR shades
+ * [lightest .. darkest] for YAGE_CONV_PALETTE kernels, the 64K LUT for
+ * yage_pixconv_row_lut16*, unused otherwise. */
+typedef void (*yage_pixconv_row_fn)(void* dst, const void* src, int width,
+                                    const uint32_t* table);
+
+/* Number of entries in a 16-bit lookup table */
+#define YAGE_PIXCONV_LUT_SIZE 65536
+
+/* Best instruction set available on this CPU (detected once, cached). */
+YageSimdLevel yage_pixconv_best_level(void);
+
+/* Converter for `pixel_format` (RETRO_PIXEL_FORMAT_*), `mode` and output
+ * format `out` (YAGE_OUTPUT_*), using the best instruction set available.
+ * Returns NULL for unknown formats. */
+yage_pixconv_row_fn yage_pixconv_select(int pixel_format, YageConvMode mode, int out);
+
+/* Converter for an explicit instruction set.  Returns NULL if `level` is
+ * not compiled in / not supported by this CPU, the format is unknown,
+ * `out` is RGB565 or INDEX8 with a SIMD level (both are scalar only), or
+ * `out` is INDEX8 with a mode other than YAGE_CONV_PALETTE.
+ * Used to cross-check SIMD kernels against the scalar reference. */
+yage_pixconv_row_fn yage_pixconv_select_level(int pixel_format, YageConvMode mode,
+                                              int out, YageSimdLevel level);
+
+/* Bytes per output pixel for YAGE_OUTPUT_* (4, 2 for RGB565, 1 for INDEX8). */
+int yage_pixconv_output_bpp(int out);
+
+/* Fill `lut` (YAGE_PIXCONV_LUT_SIZE entries) with the converted value of
+ * every 16-bit source pixel for `pixel_format` (RGB565 or 0RGB1555),
+ * `mode` and output format `out`; RGB565 entries use the low 16 bits,
+ * INDEX8 entries (PALETTE only, `palette` ignored) the low 8.  Returns 0
+ * on success, -1 for a non-16-bit format or an unsupported combination. */
+int yage_pixconv_build_lut(uint32_t* lut, int pixel_format, YageConvMode mode,
+                           int out, const uint32_t* palette);
+
+/* Row converters for any 16-bit source: dst[x] = table[src[x]] where
+ * `table` was filled by yage_pixconv_build_lut — 32-bit entries for
+ * RGBA/BGRA output, 16-bit entries for RGB565, 8-bit for INDEX8. */
+void yage_pixconv_row_lut16(void* dst, const void* src, int width,
+                            const uint32_t* table);
+void yage_pixconv_row_lut16_565(void* dst, const void* src, int width,
+                                const uint32_t* table);
+void yage_pixconv_row_lut16_index8(void* dst, const void* src, int width,
+                                   const uint32_t* table);
+
+/* Recolour an INDEX8 row: dst[x] = table[src[x] & 3], where `table` holds
+ * the 4 shades [lightest .. darkest] as 32-bit pixels in the wanted
+ * layout. */
+void yage_pixconv_row_index8_expand(void* dst, const void* src, int width,
+                                    const uint32_t* table);
+
+/* RGB565 → RGB565 passthrough (no transform): a plain row copy. */
+void yage_pixconv_row_copy16(void* dst, const void* src, int width,
+                             const uint32_t* table);
+
+/* Human-readable name of an instruction set, for logging. */
+const char* yage_pixconv_level_name(YageSimdLevel level);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* YAGE_PIXCONV_H */
@@ -0,0 +1,376 @@
+/*
+ * YAGE Gameplay Recorder — Implementation
+ *
+ * Queues
+ *   video: REC_FRAME_SLOTS preallocated frame buffers indexed by free-
+ *          running head (producer) / tail (encoder) counters
+ *   audio: power-of-two ring of interleaved int16 samples, same scheme
+ *
+ * Each side only writes its own counter, published with release /
+ * observed with acquire, so no lock is ever taken on the producer side.
+ * The encoder polls and sleeps briefly when both queues are empty —
+ * waking it through a condition variable would need the producer to take
+ * a mutex.
+ *
+ * Shutdown: the producer brackets every push with g_rec_pushing, and
+ * yage_recorder_close() clears g_rec_active then waits for g_rec_pushing
+ * to drain before the buffers go away (both sequentially consistent, so
+ * one side always sees the other).
+ */
+
+#include "yage_record.h"
+#include "yage_libretro.h"  /* YAGE_OUTPUT_* */
+
+#include <stdlib.h>
+#include <string.h>
+
+/* ── File formats ─────────────────────────────────────────────────────── */
+
+static void put_le16(uint8_t* p, uint32_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static void put_le32(uint8_t* p, uint32_t v) {
+    put_le16(p, v);
+    put_le16(p + 2, v >> 16);
+}
+
+void yage_record_wav_header(uint8_t* h, uint32_t sample_rate, uint32_t data_bytes) {
+    memcpy(h, "RIFF", 4);
+    put_le32(h + 4, 36 + data_bytes);
+    memcpy(h + 8, "WAVEfmt ", 8);
+    put_le32(h + 16, 16);                 /* fmt chunk size */
+    put_le16(h + 20, 1);                  /* PCM */
+    put_le16(h + 22, 2);                  /* stereo */
+    put_le32(h + 24, sample_rate);
+    put_le32(h + 28, sample_rate * 4);    /* byte rate */
+    put_le16(h + 32, 4);                  /* block align */
+    put_le16(h + 34, 16);                 /* bits per sample */
+    memcpy(h + 36, "data", 4);
+    put_le32(h + 40, data_bytes);
+}
+
+static void unpack_rgb(const uint8_t* row, int x, int format, int* r, int* g, int* b) {
+    if (format == YAGE_OUTPUT_RGB565) {
+        uint16_t p;
+        memcpy(&p, row + (size_t)x * 2, 2);
+        *r = ((p >> 11) & 0x1F) * 255 / 31;
+        *g = ((p >> 5) & 0x3F) * 255 / 63;
+        *b = (p & 0x1F) * 255 / 31;
+    } else {
+        const uint8_t* px = row + (size_t)x * 4;
+        *g = px[1];
+        *r = format == YAGE_OUTPUT_BGRA8888 ? px[2] : px[0];
+        *b = format == YAGE_OUTPUT_BGRA8888 ? px[0] : px[2];
+    }
+}
+
+static uint8_t clamp_u8(int v) {
+    return (uint8_t)(v < 0 ? 0 : (v > 255 ? 255 : v));
+}
+
+void yage_record_yuv444(const uint8_t* pixels, int width, int height, int format,
+                        uint8_t* planes) {
+    size_t plane = (size_t)width * height;
+    size_t stride = (size_t)width * (format == YAGE_OUTPUT_RGB565 ? 2 : 4);
+    uint8_t* yp = planes;
+    uint8_t* up = yp + plane;
+    uint8_t* vp = up + plane;
+    for (int y = 0; y < height; y++) {
+        const uint8_t* row = pixels + (size_t)y * stride;
+        for (int x = 0; x < width; x++) {
+            int r, g, b;
+            unpack_rgb(row, x, format, &r, &g, &b);
+            size_t i = (size_t)y * width + x;
+            yp[i] = clamp_u8((77 * r + 150 * g + 29 * b + 128) >> 8);
+            up[i] = clamp_u8((-43 * r - 85 * g + 128 * b + 32896) >> 8);
+            vp[i] = clamp_u8((128 * r - 107 * g - 21 * b + 32896) >> 8);
+        }
+    }
+}
+
+void yage_record_y4m_header(FILE* f, int width, int height, double fps) {
+    /* F is the exact rational for common rates (e.g. 59.7275 → 597275:10000) */
+    fprintf(f, "YUV4MPEG2 W%d H%d F%u:10000 Ip A1:1 C444 XCOLORRANGE=FULL\n",
+            width, height, (unsigned)(fps * 10000.0 + 0.5));
+}
+
+FILE* yage_record_fopen(const char* base, const char* ext) {
+    size_t len = strlen(base) + strlen(ext) + 1;
+    char* path = (char*)malloc(len);
+    if (!path) return NULL;
+    snprintf(path, len, "%s%s", base, ext);
+    FILE* f = fopen(path, "wb");
+    free(path);
+    return f;
+}
+
+#ifndef _WIN32
+#include <pthread.h>
+#include <stdatomic.h>
+#include <time.h>
+
+#define REC_FRAME_SLOTS     16        /* ~¼ s of video at 60 fps */
+#define REC_AUDIO_SECONDS   2
+#define REC_IDLE_SLEEP_NS   2000000L  /* encoder poll interval when idle */
+#define REC_WAV_MAX_DATA    0xFFFFFF00u  /* RIFF sizes are 32-bit */
+
+static pthread_t   g_rec_thread;
+static atomic_int  g_rec_active   = 0;   /* producers may push */
+static atomic_int  g_rec_running  = 0;   /* encoder keeps polling */
+static atomic_int  g_rec_pushing  = 0;   /* producers inside a push */
+
+/* Video queue */
+static uint8_t*    g_rec_frames[REC_FRAME_SLOTS];
+static int         g_rec_frame_format[REC_FRAME_SLOTS];
+static int         g_rec_width  = 0;
+static int         g_rec_height = 0;
+static atomic_uint g_rec_frame_head = 0;
+static atomic_uint g_rec_frame_tail = 0;
+
+/* Audio queue (interleaved stereo samples) */
+static int16_t*    g_rec_audio = NULL;
+static uint32_t    g_rec_audio_cap = 0;  /* samples, power of two */
+static atomic_uint g_rec_audio_head = 0;
+static atomic_uint g_rec_audio_tail = 0;
+
+/* Encoder-side state */
+static FILE*       g_rec_y4m = NULL;
+static FILE*       g_rec_wav = NULL;
+static uint8_t*    g_rec_planes = NULL;  /* Y, Cb, Cr planes of one frame */
+static uint32_t    g_rec_wav_bytes = 0;
+static uint32_t    g_rec_sample_rate = 0;
+static int         g_rec_io_error = 0;
+
+/* Statistics */
+static atomic_uint g_rec_written = 0;
+static atomic_uint g_rec_dropped = 0;
+static atomic_uint g_rec_audio_dropped = 0;   /* stereo frames */
+
+/* One Y4M FRAME of the recording's size */
+static void encode_frame(const uint8_t* pixels, int format) {
+    size_t bytes = (size_t)g_rec_width * g_rec_height * 3;
+    yage_record_yuv444(pixels, g_rec_width, g_rec_height, format, g_rec_planes);
+    if (fputs("FRAME\n", g_rec_y4m) < 0 || fwrite(g_rec_planes, 1, bytes, g_rec_y4m) != bytes) {
+        g_rec_io_error = 1;
+    }
+}
+
+/* ── Encoder thread ───────────────────────────────────────────────────── */
+
+/* Write everything queued in the audio ring.  Returns nonzero if any. */
+static int drain_audio(void) {
+    uint32_t tail = atomic_load_explicit(&g_rec_audio_tail, memory_order_relaxed);
+    uint32_t head = atomic_load_explicit(&g_rec_audio_head, memory_order_acquire);
+    if (head == tail) return 0;
+    while (tail != head) {
+        uint32_t pos = tail & (g_rec_audio_cap - 1);
+        uint32_t run = head - tail;
+        if (run > g_rec_audio_cap - pos) run = g_rec_audio_cap - pos;
+        uint32_t bytes = run * (uint32_t)sizeof(int16_t);
+        if (!g_rec_io_error && g_rec_wav_bytes + bytes <= REC_WAV_MAX_DATA) {
+            if (fwrite(g_rec_audio + pos, 1, bytes, g_rec_wav) != bytes) g_rec_io_error = 1;
+            else g_rec_wav_bytes += bytes;
+        }
+        tail += run;
+    }
+    atomic_store_explicit(&g_rec_audio_tail, tail, memory_order_release);
+    return 1;
+}
+
+static void* encoder_thread(void* arg) {
+    (void)arg;
+    for (;;) {
+        int busy = drain_audio();
+        uint32_t tail = atomic_load_explicit(&g_rec_frame_tail, memory_order_relaxed);
+        if (tail != atomic_load_explicit(&g_rec_frame_head, memory_order_acquire)) {
+            uint32_t slot = tail % REC_FRAME_SLOTS;
+            if (!g_rec_io_error) {
+                encode_frame(g_rec_frames[slot], g_rec_frame_format[slot]);
+                atomic_fetch_add_explicit(&g_rec_written, 1, memory_order_relaxed);
+            }
+            atomic_store_explicit(&g_rec_frame_tail, tail + 1, memory_order_release);
+            busy = 1;
+        }
+        if (!busy) {
+            /* Queues are empty; quitting is only safe once they are */
+            if (!atomic_load_explicit(&g_rec_running, memory_order_acquire)) break;
+            struct timespec ts = { 0, REC_IDLE_SLEEP_NS };
+            nanosleep(&ts, NULL);
+        }
+    }
+    return NULL;
+}
+
+/* ── Producer side ────────────────────────────────────────────────────── */
+
+void yage_recorder_push_video(const void* pixels, int width, int height, int format) {
+    atomic_fetch_add(&g_rec_pushing, 1);
+    if (!atomic_load(&g_rec_active) || !pixels) goto done;
+
+    uint32_t head = atomic_load_explicit(&g_rec_frame_head, memory_order_relaxed);
+    uint32_t tail = atomic_load_explicit(&g_rec_frame_tail, memory_order_acquire);
+    if (width != g_rec_width || height != g_rec_height || head - tail >= REC_FRAME_SLOTS) {
+        /* Encoder behind (or the core changed resolution): never wait */
+        atomic_fetch_add_explicit(&g_rec_dropped, 1, memory_order_relaxed);
+        goto done;
+    }
+    uint32_t slot = head % REC_FRAME_SLOTS;
+    size_t bytes = (size_t)width * height * (format == YAGE_OUTPUT_RGB565 ? 2 : 4);
+    memcpy(g_rec_frames[slot], pixels, bytes);
+    g_rec_frame_format[slot] = format;
+    atomic_store_explicit(&g_rec_frame_head, head + 1, memory_order_release);
+
+done:
+    atomic_fetch_sub(&g_rec_pushing, 1);
+}
+
+void yage_recorder_push_audio(const int16_t* samples, size_t frames) {
+    atomic_fetch_add(&g_rec_pushing, 1);
+    if (!atomic_load(&g_rec_active) || !samples || frames == 0) goto done;
+
+    uint32_t count = (uint32_t)frames * 2;
+    uint32_t head = atomic_load_explicit(&g_rec_audio_head, memory_order_relaxed);
+    uint32_t tail = atomic_load_explicit(&g_rec_audio_tail, memory_order_acquire);
+    if (count > g_rec_audio_cap - (head - tail)) {
+        atomic_fetch_add_explicit(&g_rec_audio_dropped, (unsigned)frames, memory_order_relaxed);
+        goto done;
+    }
+    uint32_t pos = head & (g_rec_audio_cap - 1);
+    uint32_t first = count < g_rec_audio_cap - pos ? count : g_rec_audio_cap - pos;
+    memcpy(g_rec_audio + pos, samples, first * sizeof(int16_t));
+    memcpy(g_rec_audio, samples + first, (count - first) * sizeof(int16_t));
+    atomic_store_explicit(&g_rec_audio_head, head + count, memory_order_release);
+
+done:
+    atomic_fetch_sub(&g_rec_pushing, 1);
+}
+
+/* ── Lifecycle ────────────────────────────────────────────────────────── */
+
+static void release_buffers(void) {
+    for (int i = 0; i < REC_FRAME_SLOTS; i++) {
+        free(g_rec_frames[i]);
+        g_rec_frames[i] = NULL;
+    }
+    free(g_rec_audio);
+    free(g_rec_planes);
+    g_rec_audio = NULL;
+    g_rec_planes = NULL;
+    if (g_rec_y4m) fclose(g_rec_y4m);
+    if (g_rec_wav) fclose(g_rec_wav);
+    g_rec_y4m = g_rec_wav = NULL;
+}
+
+int yage_recorder_open(const char* base_path, int width, int height,
+                       double fps, double sample_rate) {
+    if (!base_path || width <= 0 || height <= 0) return -1;
+    if (atomic_load(&g_rec_active) || atomic_load(&g_rec_running)) return -1;
+    if (fps <= 0.0) fps = 60.0;
+    if (sample_rate <= 0.0) sample_rate = 32768.0;
+
+    size_t frame_bytes = (size_t)width * height * 4;
+    g_rec_audio_cap = 1;
+    while (g_rec_audio_cap < (uint32_t)(sample_rate * 2 * REC_AUDIO_SECONDS)) g_rec_audio_cap <<= 1;
+
+    int ok = 1;
+    for (int i = 0; i < REC_FRAME_SLOTS; i++) {
+        g_rec_frames[i] = (uint8_t*)malloc(frame_bytes);
+        if (!g_rec_frames[i]) ok = 0;
+    }
+    g_rec_audio  = (int16_t*)malloc(g_rec_audio_cap * sizeof(int16_t));
+    g_rec_planes = (uint8_t*)malloc((size_t)width * height * 3);
+    g_rec_y4m = yage_record_fopen(base_path, ".y4m");
+    g_rec_wav = yage_record_fopen(base_path, ".wav");
+    if (!ok || !g_rec_audio || !g_rec_planes || !g_rec_y4m || !g_rec_wav) {
+        release_buffers();
+        return -1;
+    }
+
+    g_rec_width  = width;
+    g_rec_height = height;
+    g_rec_wav_bytes = 0;
+    g_rec_io_error = 0;
+
+    yage_record_y4m_header(g_rec_y4m, width, height, fps);
+    uint8_t header[YAGE_RECORD_WAV_HEADER];
+    g_rec_sample_rate = (uint32_t)(sample_rate + 0.5);
+    yage_record_wav_header(header, g_rec_sample_rate, 0);
+    fwrite(header, 1, sizeof(header), g_rec_wav);
+
+    atomic_store(&g_rec_frame_head, 0);
+    atomic_store(&g_rec_frame_tail, 0);
+    atomic_store(&g_rec_audio_head, 0);
+    atomic_store(&g_rec_audio_tail, 0);
+    atomic_store(&g_rec_written, 0);
+    atomic_store(&g_rec_dropped, 0);
+    atomic_store(&g_rec_audio_dropped, 0);
+
+    atomic_store(&g_rec_running, 1);
+    if (pthread_create(&g_rec_thread, NULL, encoder_thread, NULL) != 0) {
+        atomic_store(&g_rec_running, 0);
+        release_buffers();
+        return -1;
+    }
+    atomic_store(&g_rec_active, 1);
+    return 0;
+}
+
+void yage_recorder_close(void) {
+    if (!atomic_load(&g_rec_running)) return;
+
+    /* No new pushes; wait out any in flight before the queues go away */
+    atomic_store(&g_rec_active, 0);
+    while (atomic_load(&g_rec_pushing) > 0) {
+        struct timespec ts = { 0, 100000 };
+        nanosleep(&ts, NULL);
+    }
+
+    /* The encoder drains both queues before it exits */
+    atomic_store_explicit(&g_rec_running, 0, memory_order_release);
+    pthread_join(g_rec_thread, NULL);
+
+    /* Patch the WAV sizes now that the data length is known */
+    uint8_t header[YAGE_RECORD_WAV_HEADER];
+    yage_record_wav_header(header, g_rec_sample_rate, g_rec_wav_bytes);
+    if (fseek(g_rec_wav, 0, SEEK_SET) == 0) fwrite(header, 1, sizeof(header), g_rec_wav);
+    release_buffers();
+}
+
+int yage_recorder_active(void) {
+    return atomic_load_explicit(&g_rec_active, memory_order_relaxed);
+}
+
+void yage_recorder_stats(uint32_t* frames_written, uint32_t* frames_dropped,
+                         uint32_t* audio_frames_dropped) {
+    if (frames_written) *frames_written = atomic_load_explicit(&g_rec_written, memory_order_relaxed);
+    if (frames_dropped) *frames_dropped = atomic_load_explicit(&g_rec_dropped, memory_order_relaxed);
+    if (audio_frames_dropped) {
+        *audio_frames_dropped = atomic_load_explicit(&g_rec_audio_dropped, memory_order_relaxed);
+    }
+}
+
+#else /* _WIN32 — no encoder thread */
+
+int yage_recorder_open(const char* base_path, int width, int height,
+                       double fps, double sample_rate) {
+    (void)base_path; (void)width; (void)height; (void)fps; (void)sample_rate;
+    return -1;
+}
+void yage_recorder_close(void) {}
+int  yage_recorder_active(void) { return 0; }
+void yage_recorder_push_video(const void* pixels, int width, int height, int format) {
+    (void)pixels; (void)width; (void)height; (void)format;
+}
+void yage_recorder_push_audio(const int16_t* samples, size_t frames) {
+    (void)samples; (void)frames;
+}
+void yage_recorder_stats(uint32_t* frames_written, uint32_t* frames_dropped,
+                         uint32_t* audio_frames_dropped) {
+    if (frames_written) *frames_written = 0;
+    if (frames_dropped) *frames_dropped = 0;
+    if (audio_frames_dropped) *audio_frames_dropped = 0;
+}
+
+#endif /* _WIN32 */
@@ -0,0 +1,75 @@
+/*
+ * YAGE Gameplay Recorder
+ *
+ * Captures every emulated frame and the core's audio to two lossless-ish,
+ * universally readable files next to each other:
+ *
+ *   <base>.y4m   YUV4MPEG2, 4:4:4 full-range (no chroma subsampling)
+ *   <base>.wav   16-bit stereo PCM at the core's sample rate
+ *
+ * The thread running retro_run() only copies data into bounded lock-free
+ * single-producer / single-consumer queues; a dedicated encoder thread
+ * does the colour conversion and file I/O.  A full queue never blocks the
+ * producer — the frame (or audio batch) is dropped and counted instead.
+ *
+ * Internal to yage_core — the FFI surface is yage_record_* in
+ * yage_libretro.h.  POSIX only; on Windows opening always fails.
+ */
+
+#ifndef YAGE_RECORD_H
+#define YAGE_RECORD_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Start a recording of `width` × `height` frames at `fps`, with audio at
+ * `sample_rate` Hz, into base_path + ".y4m" / ".wav".  Returns 0 on
+ * success, -1 if already recording or on I/O / allocation failure. */
+int yage_recorder_open(const char* base_path, int width, int height,
+                       double fps, double sample_rate);
+
+/* Flush the queues, finish both files and stop the encoder thread. */
+void yage_recorder_close(void);
+
+/* Nonzero while a recording is open. */
+int yage_recorder_active(void);
+
+/* Queue one frame (`format` is YAGE_OUTPUT_*, rows packed).  Frames whose
+ * size differs from the recording's are dropped.  Producer thread only. */
+void yage_recorder_push_video(const void* pixels, int width, int height, int format);
+
+/* Queue `frames` interleaved stereo samples.  Producer thread only. */
+void yage_recorder_push_audio(const int16_t* samples, size_t frames);
+
+/* Counters for the current (or last) recording. */
+void yage_recorder_stats(uint32_t* frames_written, uint32_t* frames_dropped,
+                         uint32_t* audio_frames_dropped);
+
+/* ── File-format helpers (shared with the replay buffer) ──────────── */
+
+#define YAGE_RECORD_WAV_HEADER 44
+
+/* Fill a 44-byte 16-bit stereo PCM WAV header. */
+void yage_record_wav_header(uint8_t* header, uint32_t sample_rate, uint32_t data_bytes);
+
+/* Write the YUV4MPEG2 stream header matching yage_record_yuv444 frames. */
+void yage_record_y4m_header(FILE* f, int width, int height, double fps);
+
+/* Convert packed YAGE_OUTPUT_* pixels to full-range BT.601 Y, Cb, Cr
+ * planes (width × height × 3 bytes). */
+void yage_record_yuv444(const uint8_t* pixels, int width, int height, int format,
+                        uint8_t* planes);
+
+/* fopen(base + ext, "wb") */
+FILE* yage_record_fopen(const char* base, const char* ext);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* YAGE_RECORD_H */
@@ -0,0 +1,518 @@
+/*
+ * YAGE Instant Replay Buffer — Implementation
+ *
+ * Staging (producer → worker)
+ *   RP_STAGE_SLOTS frame slots indexed by free-running head / tail
+ *   counters, as in yage_record.c.  Audio batches are appended to the slot
+ *   at `head` while the frame runs; push_video publishes it.  The worker
+ *   empties a slot's audio before handing it back, so the producer always
+ *   finds a free slot clean.
+ *
+ * Store (worker ↔ dump / stats)
+ *   A ring of malloc'd RpEntry blobs under g_rp_lock.  Entries are only
+ *   decodable from the preceding keyframe, so eviction removes a whole
+ *   group at a time; the ring therefore holds between max_frames and
+ *   max_frames + gop − 1 frames, and a dump writes just the newest
+ *   max_frames of them.  Dumps copy the compressed blobs under the lock
+ *   and decode outside it, so the worker is held up only for a memcpy.
+ */
+
+#include "yage_replay.h"
+#include "yage_libretro.h"  /* YAGE_OUTPUT_* */
+#include "yage_lz.h"
+#include "yage_record.h"    /* Y4M / WAV helpers */
+
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <pthread.h>
+#include <stdatomic.h>
+#include <time.h>
+
+#define RP_STAGE_SLOTS      8
+#define RP_SLOT_AUDIO       4096      /* stereo frames kept per emulated frame */
+#define RP_IDLE_SLEEP_NS    2000000L  /* worker poll interval when idle */
+#define RP_DEFAULT_BYTES    (64u << 20)
+
+typedef struct {
+    uint8_t* pixels;
+    size_t   capacity;
+    int      width;
+    int      height;
+    int      format;
+    uint32_t audio_frames;
+    int16_t  audio[RP_SLOT_AUDIO * 2];
+} RpStage;
+
+typedef struct {
+    uint32_t video_bytes;    /* compressed sizes; data = video then audio */
+    uint32_t audio_bytes;
+    uint32_t audio_frames;
+    uint32_t key;            /* 1 = video is the frame itself, not a delta */
+    uint8_t  data[];
+} RpEntry;
+
+static pthread_t   g_rp_thread;
+static atomic_int  g_rp_active  = 0;   /* producers may push */
+static atomic_int  g_rp_running = 0;   /* worker keeps polling */
+static atomic_int  g_rp_pushing = 0;   /* producers inside a push */
+
+/* Staging queue */
+static RpStage*    g_rp_stage = NULL;
+static atomic_uint g_rp_head = 0;
+static atomic_uint g_rp_tail = 0;
+static int         g_rp_skip = 0;      /* producer: this frame's audio found no slot */
+
+/* Worker-side state */
+static uint8_t*    g_rp_prev = NULL;   /* previous raw frame */
+static uint8_t*    g_rp_delta = NULL;
+static uint8_t*    g_rp_packed = NULL; /* compressed video + audio of one frame */
+static size_t      g_rp_buf_bytes = 0; /* frame size the buffers are sized for */
+static int16_t     g_rp_audio_tmp[RP_SLOT_AUDIO * 2];
+static uint32_t    g_rp_gop = 60;
+static uint32_t    g_rp_since_key = 0;
+
+/* Store — g_rp_lock */
+static pthread_mutex_t g_rp_lock = PTHREAD_MUTEX_INITIALIZER;
+static RpEntry**   g_rp_ring = NULL;
+static uint32_t    g_rp_ring_cap = 0;
+static uint32_t    g_rp_first = 0;
+static uint32_t    g_rp_count = 0;
+static size_t      g_rp_bytes = 0;
+static size_t      g_rp_max_bytes = RP_DEFAULT_BYTES;
+static uint32_t    g_rp_max_frames = 0;
+static int         g_rp_width = 0;     /* geometry of the stored clip */
+static int         g_rp_height = 0;
+static int         g_rp_format = -1;
+
+static atomic_uint g_rp_dropped = 0;
+
+static size_t frame_bytes(int width, int height, int format) {
+    return (size_t)width * height * (format == YAGE_OUTPUT_RGB565 ? 2 : 4);
+}
+
+static size_t entry_size(const RpEntry* e) {
+    return sizeof(RpEntry) + e->video_bytes + e->audio_bytes;
+}
+
+static void xor_bytes(uint8_t* dst, const uint8_t* a, const uint8_t* b, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        uint64_t x, y;
+        memcpy(&x, a + i, 8);
+        memcpy(&y, b + i, 8);
+        x ^= y;
+        memcpy(dst + i, &x, 8);
+    }
+    for (; i < n; i++) dst[i] = a[i] ^ b[i];
+}
+
+/* Per-channel sample differences: square-wave audio becomes mostly zeros */
+static void audio_delta(int16_t* out, const int16_t* in, size_t samples) {
+    for (size_t i = 0; i < samples; i++) {
+        uint16_t prev = i >= 2 ? (uint16_t)in[i - 2] : 0;
+        out[i] = (int16_t)(uint16_t)((uint16_t)in[i] - prev);
+    }
+}
+
+static void audio_undelta(int16_t* s, size_t samples) {
+    for (size_t i = 2; i < samples; i++) {
+        s[i] = (int16_t)(uint16_t)((uint16_t)s[i] + (uint16_t)s[i - 2]);
+    }
+}
+
+/* ── Store (caller holds g_rp_lock) ───────────────────────────────────── */
+
+static RpEntry* store_at(uint32_t i) {
+    return g_rp_ring[(g_rp_first + i) % g_rp_ring_cap];
+}
+
+static void store_pop_front(void) {
+    RpEntry* e = store_at(0);
+    g_rp_bytes -= entry_size(e);
+    free(e);
+    g_rp_ring[g_rp_first] = NULL;
+    g_rp_first = (g_rp_first + 1) % g_rp_ring_cap;
+    g_rp_count--;
+}
+
+static void store_clear(void) {
+    while (g_rp_count > 0) store_pop_front();
+    g_rp_first = 0;
+}
+
+/* Frames from the front up to (not including) the next keyframe */
+static uint32_t store_first_group(void) {
+    uint32_t n = 1;
+    while (n < g_rp_count && !store_at(n)->key) n++;
+    return n;
+}
+
+/* Append `e`, then evict whole groups past the frame / byte limits.
+ * Returns 0 if the newest group itself had to go (next frame must be a
+ * keyframe). */
+static int store_push(RpEntry* e) {
+    if (g_rp_count == g_rp_ring_cap) store_pop_front();   /* not reached with sane limits */
+    g_rp_ring[(g_rp_first + g_rp_count) % g_rp_ring_cap] = e;
+    g_rp_count++;
+    g_rp_bytes += entry_size(e);
+
+    while (g_rp_count > 0) {
+        uint32_t group = store_first_group();
+        int over_bytes = g_rp_bytes > g_rp_max_bytes;
+        int over_frames = g_rp_count - group >= g_rp_max_frames;
+        if (!over_bytes && !over_frames) break;
+        if (group == g_rp_count) {
+            if (!over_bytes) break;
+            store_clear();
+            return 0;
+        }
+        for (uint32_t i = 0; i < group; i++) store_pop_front();
+    }
+    return 1;
+}
+
+/* ── Worker thread ────────────────────────────────────────────────────── */
+
+static int ensure_worker_buffers(size_t bytes) {
+    if (bytes <= g_rp_buf_bytes) return 0;
+    uint8_t* prev   = (uint8_t*)realloc(g_rp_prev, bytes);
+    if (prev) g_rp_prev = prev;
+    uint8_t* delta  = (uint8_t*)realloc(g_rp_delta, bytes);
+    if (delta) g_rp_delta = delta;
+    uint8_t* packed = (uint8_t*)realloc(g_rp_packed,
+                                        YAGE_LZ_BOUND(bytes) + YAGE_LZ_BOUND(sizeof(g_rp_audio_tmp)));
+    if (packed) g_rp_packed = packed;
+    if (!prev || !delta || !packed) return -1;
+    g_rp_buf_bytes = bytes;
+    return 0;
+}
+
+static void compress_frame(const RpStage* s) {
+    size_t bytes = frame_bytes(s->width, s->height, s->format);
+
+    if (s->width != g_rp_width || s->height != g_rp_height || s->format != g_rp_format) {
+        /* New clip: the old frames can't be written into the same file */
+        pthread_mutex_lock(&g_rp_lock);
+        store_clear();
+        g_rp_width  = s->width;
+        g_rp_height = s->height;
+        g_rp_format = s->format;
+        pthread_mutex_unlock(&g_rp_lock);
+        g_rp_since_key = g_rp_gop;
+    }
+    if (ensure_worker_buffers(bytes) != 0) {
+        atomic_fetch_add_explicit(&g_rp_dropped, 1, memory_order_relaxed);
+        g_rp_since_key = g_rp_gop;
+        return;
+    }
+
+    int key = g_rp_since_key >= g_rp_gop;
+    if (key) memcpy(g_rp_delta, s->pixels, bytes);
+    else     xor_bytes(g_rp_delta, s->pixels, g_rp_prev, bytes);
+    memcpy(g_rp_prev, s->pixels, bytes);
+
+    size_t packed_cap = YAGE_LZ_BOUND(bytes) + YAGE_LZ_BOUND(sizeof(g_rp_audio_tmp));
+    size_t vlen = yage_lz_compress(g_rp_delta, bytes, g_rp_packed, packed_cap);
+    size_t samples = (size_t)s->audio_frames * 2;
+    audio_delta(g_rp_audio_tmp, s->audio, samples);
+    size_t alen = yage_lz_compress((const uint8_t*)g_rp_audio_tmp, samples * sizeof(int16_t),
+                                   g_rp_packed + vlen, packed_cap - vlen);
+
+    RpEntry* e = (RpEntry*)malloc(sizeof(RpEntry) + vlen + alen);
+    if (!e) {
+        atomic_fetch_add_explicit(&g_rp_dropped, 1, memory_order_relaxed);
+        g_rp_since_key = g_rp_gop;   /* the delta chain is broken */
+        return;
+    }
+    e->video_bytes  = (uint32_t)vlen;
+    e->audio_bytes  = (uint32_t)alen;
+    e->audio_frames = s->audio_frames;
+    e->key          = (uint32_t)key;
+    memcpy(e->data, g_rp_packed, vlen + alen);
+
+    pthread_mutex_lock(&g_rp_lock);
+    int kept = store_push(e);
+    pthread_mutex_unlock(&g_rp_lock);
+    g_rp_since_key = kept ? (key ? 1 : g_rp_since_key + 1) : g_rp_gop;
+}
+
+static void* replay_worker(void* arg) {
+    (void)arg;
+    while (atomic_load_explicit(&g_rp_running, memory_order_acquire)) {
+        uint32_t tail = atomic_load_explicit(&g_rp_tail, memory_order_relaxed);
+        if (tail == atomic_load_explicit(&g_rp_head, memory_order_acquire)) {
+            struct timespec ts = { 0, RP_IDLE_SLEEP_NS };
+            nanosleep(&ts, NULL);
+            continue;
+        }
+        RpStage* s = &g_rp_stage[tail % RP_STAGE_SLOTS];
+        compress_frame(s);
+        s->audio_frames = 0;
+        atomic_store_explicit(&g_rp_tail, tail + 1, memory_order_release);
+    }
+    return NULL;
+}
+
+/* ── Producer side ────────────────────────────────────────────────────── */
+
+void yage_replay_push_audio(const int16_t* samples, size_t frames) {
+    atomic_fetch_add(&g_rp_pushing, 1);
+    if (!atomic_load(&g_rp_active) || !samples) goto done;
+
+    uint32_t head = atomic_load_explicit(&g_rp_head, memory_order_relaxed);
+    uint32_t tail = atomic_load_explicit(&g_rp_tail, memory_order_acquire);
+    if (head - tail >= RP_STAGE_SLOTS) {
+        g_rp_skip = 1;   /* this frame will be dropped as a whole */
+        goto done;
+    }
+    RpStage* s = &g_rp_stage[head % RP_STAGE_SLOTS];
+    size_t room = RP_SLOT_AUDIO - s->audio_frames;
+    if (frames > room) frames = room;
+    memcpy(s->audio + (size_t)s->audio_frames * 2, samples, frames * 2 * sizeof(int16_t));
+    s->audio_frames += (uint32_t)frames;
+
+done:
+    atomic_fetch_sub(&g_rp_pushing, 1);
+}
+
+void yage_replay_push_video(const void* pixels, int width, int height, int format) {
+    atomic_fetch_add(&g_rp_pushing, 1);
+    if (!atomic_load(&g_rp_active)) goto done;
+
+    uint32_t head = atomic_load_explicit(&g_rp_head, memory_order_relaxed);
+    uint32_t tail = atomic_load_explicit(&g_rp_tail, memory_order_acquire);
+    int skip = g_rp_skip;
+    g_rp_skip = 0;
+    if (head - tail >= RP_STAGE_SLOTS) {
+        atomic_fetch_add_explicit(&g_rp_dropped, 1, memory_order_relaxed);
+        goto done;
+    }
+    RpStage* s = &g_rp_stage[head % RP_STAGE_SLOTS];
+    size_t bytes = frame_bytes(width, height, format);
+    if (skip || !pixels || width <= 0 || height <= 0) {
+        s->audio_frames = 0;
+        atomic_fetch_add_explicit(&g_rp_dropped, 1, memory_order_relaxed);
+        goto done;
+    }
+    if (bytes > s->capacity) {
+        /* Only on the first frame or a resolution change */
+        uint8_t* grown = (uint8_t*)realloc(s->pixels, bytes);
+        if (!grown) {
+            s->audio_frames = 0;
+            atomic_fetch_add_explicit(&g_rp_dropped, 1, memory_order_relaxed);
+            goto done;
+        }
+        s->pixels = grown;
+        s->capacity = bytes;
+    }
+    memcpy(s->pixels, pixels, bytes);
+    s->width  = width;
+    s->height = height;
+    s->format = format;
+    atomic_store_explicit(&g_rp_head, head + 1, memory_order_release);
+
+done:
+    atomic_fetch_sub(&g_rp_pushing, 1);
+}
+
+/* ── Lifecycle ────────────────────────────────────────────────────────── */
+
+static void replay_stop(void) {
+    if (atomic_load(&g_rp_running)) {
+        atomic_store(&g_rp_active, 0);
+        while (atomic_load(&g_rp_pushing) > 0) {
+            struct timespec ts = { 0, 100000 };
+            nanosleep(&ts, NULL);
+        }
+        atomic_store_explicit(&g_rp_running, 0, memory_order_release);
+        pthread_join(g_rp_thread, NULL);
+    }
+
+    pthread_mutex_lock(&g_rp_lock);
+    if (g_rp_ring) store_clear();
+    free(g_rp_ring);
+    g_rp_ring = NULL;
+    g_rp_ring_cap = 0;
+    g_rp_width = g_rp_height = 0;
+    g_rp_format = -1;
+    pthread_mutex_unlock(&g_rp_lock);
+
+    if (g_rp_stage) {
+        for (int i = 0; i < RP_STAGE_SLOTS; i++) free(g_rp_stage[i].pixels);
+        free(g_rp_stage);
+        g_rp_stage = NULL;
+    }
+    free(g_rp_prev);
+    free(g_rp_delta);
+    free(g_rp_packed);
+    g_rp_prev = g_rp_delta = g_rp_packed = NULL;
+    g_rp_buf_bytes = 0;
+}
+
+int yage_replay_configure(double seconds, size_t max_bytes, double fps) {
+    replay_stop();
+    if (seconds <= 0.0) return 0;
+    if (fps <= 0.0) fps = 60.0;
+
+    uint32_t max_frames = (uint32_t)(seconds * fps + 0.5);
+    if (max_frames < 1) max_frames = 1;
+    g_rp_gop = (uint32_t)(fps + 0.5);   /* one keyframe per second */
+    if (g_rp_gop < 1) g_rp_gop = 1;
+
+    g_rp_stage = (RpStage*)calloc(RP_STAGE_SLOTS, sizeof(RpStage));
+    RpEntry** ring = (RpEntry**)calloc((size_t)max_frames + g_rp_gop, sizeof(RpEntry*));
+    if (!g_rp_stage || !ring) {
+        free(ring);
+        replay_stop();
+        return -1;
+    }
+
+    pthread_mutex_lock(&g_rp_lock);
+    g_rp_ring = ring;
+    g_rp_ring_cap = max_frames + g_rp_gop;
+    g_rp_first = g_rp_count = 0;
+    g_rp_bytes = 0;
+    g_rp_max_frames = max_frames;
+    g_rp_max_bytes = max_bytes ? max_bytes : RP_DEFAULT_BYTES;
+    pthread_mutex_unlock(&g_rp_lock);
+
+    g_rp_skip = 0;
+    atomic_store(&g_rp_head, 0);
+    atomic_store(&g_rp_tail, 0);
+    atomic_store(&g_rp_dropped, 0);
+
+    atomic_store(&g_rp_running, 1);
+    if (pthread_create(&g_rp_thread, NULL, replay_worker, NULL) != 0) {
+        atomic_store(&g_rp_running, 0);
+        replay_stop();
+        return -1;
+    }
+    atomic_store(&g_rp_active, 1);
+    return 0;
+}
+
+int yage_replay_active(void) {
+    return atomic_load_explicit(&g_rp_active, memory_order_relaxed);
+}
+
+void yage_replay_stats(uint32_t* frames, uint32_t* bytes, uint32_t* dropped) {
+    pthread_mutex_lock(&g_rp_lock);
+    uint32_t count = g_rp_count < g_rp_max_frames ? g_rp_count : g_rp_max_frames;
+    if (frames) *frames = count;
+    if (bytes) *bytes = g_rp_bytes > 0xFFFFFFFFu ? 0xFFFFFFFFu : (uint32_t)g_rp_bytes;
+    pthread_mutex_unlock(&g_rp_lock);
+    if (dropped) *dropped = atomic_load_explicit(&g_rp_dropped, memory_order_relaxed);
+}
+
+/* ── Dump ─────────────────────────────────────────────────────────────── */
+
+int yage_replay_dump(const char* base_path, double fps, double sample_rate) {
+    if (!base_path) return -1;
+    if (fps <= 0.0) fps = 60.0;
+    if (sample_rate <= 0.0) sample_rate = 32768.0;
+
+    /* Snapshot the compressed entries back to back */
+    pthread_mutex_lock(&g_rp_lock);
+    uint32_t count = g_rp_count;
+    uint32_t skip = count > g_rp_max_frames ? count - g_rp_max_frames : 0;
+    int width = g_rp_width, height = g_rp_height, format = g_rp_format;
+    uint8_t* blob = count ? (uint8_t*)malloc(g_rp_bytes) : NULL;
+    if (blob) {
+        size_t off = 0;
+        for (uint32_t i = 0; i < count; i++) {
+            const RpEntry* e = store_at(i);
+            memcpy(blob + off, e, entry_size(e));
+            off += entry_size(e);
+        }
+    }
+    pthread_mutex_unlock(&g_rp_lock);
+    if (!blob) return -1;
+
+    size_t bytes = frame_bytes(width, height, format);
+    uint8_t* frame  = (uint8_t*)malloc(bytes);
+    uint8_t* delta  = (uint8_t*)malloc(bytes);
+    uint8_t* planes = (uint8_t*)malloc((size_t)width * height * 3);
+    int16_t* audio  = (int16_t*)malloc(RP_SLOT_AUDIO * 2 * sizeof(int16_t));
+    FILE* y4m = yage_record_fopen(base_path, ".y4m");
+    FILE* wav = yage_record_fopen(base_path, ".wav");
+    int written = -1;
+    if (!frame || !delta || !planes || !audio || !y4m || !wav) goto cleanup;
+
+    yage_record_y4m_header(y4m, width, height, fps);
+    uint8_t header[YAGE_RECORD_WAV_HEADER];
+    uint32_t rate = (uint32_t)(sample_rate + 0.5);
+    uint32_t wav_bytes = 0;
+    yage_record_wav_header(header, rate, 0);
+    fwrite(header, 1, sizeof(header), wav);
+
+    written = 0;
+    size_t off = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        RpEntry e;
+        memcpy(&e, blob + off, sizeof(RpEntry));
+        const uint8_t* data = blob + off + sizeof(RpEntry);
+        off += entry_size(&e);
+
+        if (yage_lz_decompress(data, e.video_bytes, delta, bytes) != bytes) { written = -1; break; }
+        if (e.key) memcpy(frame, delta, bytes);
+        else       xor_bytes(frame, frame, delta, bytes);
+        if (i < skip) continue;
+
+        yage_record_yuv444(frame, width, height, format, planes);
+        size_t plane_bytes = (size_t)width * height * 3;
+        if (fputs("FRAME\n", y4m) < 0 || fwrite(planes, 1, plane_bytes, y4m) != plane_bytes) {
+            written = -1;
+            break;
+        }
+        size_t audio_bytes = (size_t)e.audio_frames * 2 * sizeof(int16_t);
+        if (yage_lz_decompress(data + e.video_bytes, e.audio_bytes, (uint8_t*)audio,
+                               RP_SLOT_AUDIO * 2 * sizeof(int16_t)) != audio_bytes) {
+            written = -1;
+            break;
+        }
+        audio_undelta(audio, (size_t)e.audio_frames * 2);
+        if (fwrite(audio, 1, audio_bytes, wav) != audio_bytes) { written = -1; break; }
+        wav_bytes += (uint32_t)audio_bytes;
+        written++;
+    }
+
+    yage_record_wav_header(header, rate, wav_bytes);
+    if (fseek(wav, 0, SEEK_SET) == 0) fwrite(header, 1, sizeof(header), wav);
+
+cleanup:
+    if (y4m) fclose(y4m);
+    if (wav) fclose(wav);
+    free(blob);
+    free(frame);
+    free(delta);
+    free(planes);
+    free(audio);
+    return written;
+}
+
+#else /* _WIN32 — no worker thread */
+
+int yage_replay_configure(double seconds, size_t max_bytes, double fps) {
+    (void)max_bytes; (void)fps;
+    return seconds <= 0.0 ? 0 : -1;
+}
+int  yage_replay_active(void) { return 0; }
+void yage_replay_push_audio(const int16_t* samples, size_t frames) {
+    (void)samples; (void)frames;
+}
+void yage_replay_push_video(const void* pixels, int width, int height, int format) {
+    (void)pixels; (void)width; (void)height; (void)format;
+}
+int yage_replay_dump(const char* base_path, double fps, double sample_rate) {
+    (void)base_path; (void)fps; (void)sample_rate;
+    return -1;
+}
+void yage_replay_stats(uint32_t* frames, uint32_t* bytes, uint32_t* dropped) {
+    if (frames) *frames = 0;
+    if (bytes) *bytes = 0;
+    if (dropped) *dropped = 0;
+}
+
+#endif /* _WIN32 */
@@ -0,0 +1,64 @@
+/*
+ * YAGE Instant Replay Buffer
+ *
+ * Always-on ring of the last N seconds of emulated frames and audio, kept
+ * compressed in memory so the host can save a clip after something
+ * interesting happened:
+ *
+ *   - the thread running retro_run() copies each frame (and the audio the
+ *     core produced alongside it) into a small lock-free staging queue;
+ *   - a worker thread XOR-deltas the frame against the previous one (a
+ *     keyframe once per second), delta-codes the audio, LZ-compresses
+ *     both (yage_lz) and appends the result to the ring;
+ *   - whole keyframe groups are evicted from the front once the ring
+ *     holds more than N seconds or exceeds its byte cap.
+ *
+ * A resolution or output-format change restarts the ring, so a dump is
+ * always a single clip.  Dumps use the recorder's formats
+ * (<path>.y4m + <path>.wav, see yage_record.h).
+ *
+ * Internal to yage_core — the FFI surface is yage_replay_buffer_* in
+ * yage_libretro.h.  POSIX only; on Windows configuring always fails.
+ */
+
+#ifndef YAGE_REPLAY_H
+#define YAGE_REPLAY_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* (Re)start the buffer to hold `seconds` of frames at `fps` in at most
+ * `max_bytes` of compressed data, discarding what it held.  seconds <= 0
+ * stops the worker and frees everything.  Returns 0 on success, -1 on
+ * allocation / thread failure (the buffer is then off). */
+int yage_replay_configure(double seconds, size_t max_bytes, double fps);
+
+/* Nonzero while the buffer is capturing. */
+int yage_replay_active(void);
+
+/* Queue audio produced during the current frame.  Producer thread only. */
+void yage_replay_push_audio(const int16_t* samples, size_t frames);
+
+/* Close the current frame (`format` is YAGE_OUTPUT_*, rows packed).
+ * Producer thread only; never blocks — drops the frame when the worker is
+ * behind. */
+void yage_replay_push_video(const void* pixels, int width, int height, int format);
+
+/* Decode the buffered clip to base_path + ".y4m" / ".wav" on the calling
+ * thread.  Capture continues meanwhile.  Returns the number of frames
+ * written, or -1 if nothing is buffered or a file cannot be written. */
+int yage_replay_dump(const char* base_path, double fps, double sample_rate);
+
+/* Frames and compressed bytes currently held, and frames dropped since
+ * the last configure. */
+void yage_replay_stats(uint32_t* frames, uint32_t* bytes, uint32_t* dropped);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* YAGE_REPLAY_H */
@@ -0,0 +1,293 @@
+/*
+ * YAGE Audio Resampler — Implementation
+ *
+ * Input is kept de-interleaved as float in buf_l / buf_r (raw int16
+ * values, no scaling).  `pos` is the fractional index of the first tap of
+ * the next output frame, whose centre lies taps/2 - 1 + frac samples
+ * later.  Phase row p of the table holds the kernel for frac = p / PHASES;
+ * row PHASES (frac = 1) exists so the interpolation never reads past the
+ * table.  Every row is normalised to unit DC gain, so a constant input
+ * stays constant whatever the phase.
+ *
+ * Input arrives in pieces of at most RS_CHUNK frames; after each piece
+ * the samples no later output needs are dropped from the front.
+ */
+
+#include "yage_resampler.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define YAGE_RESAMPLER_SSE2 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define YAGE_RESAMPLER_NEON 1
+#endif
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define RS_BASE_TAPS   32      /* kernel length at or above unity ratio */
+#define RS_CHUNK       1024    /* input frames buffered per pass */
+#define RS_KAISER_BETA 6.0     /* ~63 dB stopband */
+#define RS_PASSBAND    0.88    /* cutoff, as a fraction of the lower Nyquist */
+#define RS_MIN_RATE    1000.0
+#define RS_MAX_RATE    1536000.0   /* 8× fast-forward of 192 kHz */
+
+struct YageResampler {
+    double base_step;   /* in_rate / out_rate */
+    double step;        /* input frames per output frame, adjusted */
+    double adjust;
+    double pos;
+    double cutoff;      /* fraction of the input Nyquist frequency */
+    int    taps;
+    int    len;         /* frames in buf_l / buf_r */
+    float* table;       /* (PHASES + 1) × taps */
+    float* buf_l;       /* taps + RS_CHUNK frames each */
+    float* buf_r;
+};
+
+/* Zeroth-order modified Bessel function of the first kind */
+static double bessel_i0(double x) {
+    double sum = 1.0, term = 1.0, q = x * x / 4.0;
+    for (int k = 1; k < 64 && term > sum * 1e-12; k++) {
+        term *= q / ((double)k * k);
+        sum += term;
+    }
+    return sum;
+}
+
+static void build_table(float* table, int taps, double cutoff) {
+    const double half = taps / 2.0;
+    const double i0_beta = bessel_i0(RS_KAISER_BETA);
+    double row[YAGE_RESAMPLER_MAX_TAPS];
+
+    for (int p = 0; p <= YAGE_RESAMPLER_PHASES; p++) {
+        double frac = (double)p / YAGE_RESAMPLER_PHASES, sum = 0.0;
+        for (int k = 0; k < taps; k++) {
+            double t = k - (half - 1.0) - frac;
+            double r = t / half, h = 0.0;
+            if (r > -1.0 && r < 1.0) {
+                double x = M_PI * cutoff * t;
+                double sinc = (x == 0.0) ? 1.0 : sin(x) / x;
+                h = cutoff * sinc * bessel_i0(RS_KAISER_BETA * sqrt(1.0 - r * r)) / i0_beta;
+            }
+            row[k] = h;
+            sum += h;
+        }
+        for (int k = 0; k < taps; k++)
+            table[p * taps + k] = (float)(sum != 0.0 ? row[k] / sum : 0.0);
+    }
+}
+
+/* Interpolated kernel c0 + (c1 - c0) × frac applied to both channels */
+static inline void dot_stereo(const float* l, const float* r, const float* c0,
+                              const float* c1, float frac, int taps,
+                              float* out_l, float* out_r) {
+#if defined(YAGE_RESAMPLER_SSE2)
+    const __m128 f = _mm_set1_ps(frac);
+    __m128 al = _mm_setzero_ps(), ar = _mm_setzero_ps();
+    for (int k = 0; k < taps; k += 4) {
+        __m128 a = _mm_loadu_ps(c0 + k);
+        __m128 c = _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(c1 + k), a), f));
+        al = _mm_add_ps(al, _mm_mul_ps(c, _mm_loadu_ps(l + k)));
+        ar = _mm_add_ps(ar, _mm_mul_ps(c, _mm_loadu_ps(r + k)));
+    }
+    /* (l0+l2, r0+r2, l1+l3, r1+r3) → lanes 0 / 1 */
+    __m128 s = _mm_add_ps(_mm_unpacklo_ps(al, ar), _mm_unpackhi_ps(al, ar));
+    s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+    float lanes[4];
+    _mm_storeu_ps(lanes, s);
+    *out_l = lanes[0];
+    *out_r = lanes[1];
+#elif defined(YAGE_RESAMPLER_NEON)
+    float32x4_t al = vdupq_n_f32(0.0f), ar = vdupq_n_f32(0.0f);
+    for (int k = 0; k < taps; k += 4) {
+        float32x4_t a = vld1q_f32(c0 + k);
+        float32x4_t c = vmlaq_n_f32(a, vsubq_f32(vld1q_f32(c1 + k), a), frac);
+        al = vmlaq_f32(al, c, vld1q_f32(l + k));
+        ar = vmlaq_f32(ar, c, vld1q_f32(r + k));
+    }
+    float32x2_t s = vpadd_f32(vadd_f32(vget_low_f32(al), vget_high_f32(al)),
+                              vadd_f32(vget_low_f32(ar), vget_high_f32(ar)));
+    *out_l = vget_lane_f32(s, 0);
+    *out_r = vget_lane_f32(s, 1);
+#else
+    float sl = 0.0f, sr = 0.0f;
+    for (int k = 0; k < taps; k++) {
+        float c = c0[k] + (c1[k] - c0[k]) * frac;
+        sl += c * l[k];
+        sr += c * r[k];
+    }
+    *out_l = sl;
+    *out_r = sr;
+#endif
+}
+
+static inline int16_t to_s16(float v) {
+    int s = (int)(v + (v >= 0.0f ? 0.5f : -0.5f));
+    if (s > 32767) s = 32767;
+    if (s < -32768) s = -32768;
+    return (int16_t)s;
+}
+
+static int valid_rate(double rate) {
+    return rate >= RS_MIN_RATE && rate <= RS_MAX_RATE;
+}
+
+void yage_resampler_reset(YageResampler* rs) {
+    if (!rs) return;
+    /* Start as if taps/2 - 1 frames of silence preceded the first input,
+     * so the first output frame is centred on input frame 0 */
+    rs->len = rs->taps / 2 - 1;
+    memset(rs->buf_l, 0, (size_t)rs->len * sizeof(float));
+    memset(rs->buf_r, 0, (size_t)rs->len * sizeof(float));
+    rs->pos = 0.0;
+    rs->adjust = 1.0;
+    rs->step = rs->base_step;
+}
+
+int yage_resampler_set_rates(YageResampler* rs, double in_rate, double out_rate) {
+    if (!rs || !valid_rate(in_rate) || !valid_rate(out_rate)) return -1;
+
+    double scale = out_rate < in_rate ? out_rate / in_rate : 1.0;
+    int taps = (int)ceil(RS_BASE_TAPS / scale);
+    taps = (taps + 3) & ~3;
+    if (taps > YAGE_RESAMPLER_MAX_TAPS) taps = YAGE_RESAMPLER_MAX_TAPS;
+    double cutoff = RS_PASSBAND * scale;
+
+    rs->base_step = in_rate / out_rate;
+    rs->step = rs->base_step / rs->adjust;
+    if (rs->table && taps == rs->taps) {
+        /* Same length: the buffered input lines up with the new kernel */
+        if (cutoff != rs->cutoff) {
+            build_table(rs->table, taps, cutoff);
+            rs->cutoff = cutoff;
+        }
+        return 0;
+    }
+
+    float* table = (float*)malloc((size_t)(YAGE_RESAMPLER_PHASES + 1) * taps * sizeof(float));
+    float* buf_l = (float*)malloc((size_t)(taps + RS_CHUNK) * sizeof(float));
+    float* buf_r = (float*)malloc((size_t)(taps + RS_CHUNK) * sizeof(float));
+    if (!table || !buf_l || !buf_r) {
+        free(table);
+        free(buf_l);
+        free(buf_r);
+        return -1;
+    }
+    build_table(table, taps, cutoff);
+
+    free(rs->table);
+    free(rs->buf_l);
+    free(rs->buf_r);
+    rs->table = table;
+    rs->buf_l = buf_l;
+    rs->buf_r = buf_r;
+    rs->taps = taps;
+    rs->cutoff = cutoff;
+    yage_resampler_reset(rs);
+    return 0;
+}
+
+YageResampler* yage_resampler_create(double in_rate, double out_rate) {
+    YageResampler* rs = (YageResampler*)calloc(1, sizeof(YageResampler));
+    if (!rs) return NULL;
+    rs->adjust = 1.0;
+    if (yage_resampler_set_rates(rs, in_rate, out_rate) != 0) {
+        free(rs);
+        return NULL;
+    }
+    return rs;
+}
+
+void yage_resampler_destroy(YageResampler* rs) {
+    if (!rs) return;
+    free(rs->table);
+    free(rs->buf_l);
+    free(rs->buf_r);
+    free(rs);
+}
+
+void yage_resampler_set_adjust(YageResampler* rs, double adjust) {
+    if (!rs) return;
+    if (adjust < 1.0 - YAGE_RESAMPLER_MAX_ADJUST) adjust = 1.0 - YAGE_RESAMPLER_MAX_ADJUST;
+    if (adjust > 1.0 + YAGE_RESAMPLER_MAX_ADJUST) adjust = 1.0 + YAGE_RESAMPLER_MAX_ADJUST;
+    rs->adjust = adjust;
+    rs->step = rs->base_step / adjust;
+}
+
+double yage_resampler_ratio(const YageResampler* rs) {
+    return rs ? 1.0 / rs->step : 0.0;
+}
+
+double yage_resampler_delay(const YageResampler* rs) {
+    return rs ? rs->taps / 2.0 : 0.0;
+}
+
+size_t yage_resampler_max_output(const YageResampler* rs, size_t in_frames) {
+    if (!rs) return 0;
+    double min_step = rs->base_step / (1.0 + YAGE_RESAMPLER_MAX_ADJUST);
+    return (size_t)((double)(in_frames + (size_t)rs->len) / min_step) + 2;
+}
+
+size_t yage_resampler_process(YageResampler* rs, const int16_t* in, size_t in_frames,
+                              int16_t* out, size_t out_capacity) {
+    if (!rs || !in) return 0;
+    const int taps = rs->taps;
+    const int room = taps + RS_CHUNK;
+    size_t produced = 0;
+
+    while (in_frames > 0) {
+        int n = room - rs->len;
+        if ((size_t)n > in_frames) n = (int)in_frames;
+        float* l = rs->buf_l + rs->len;
+        float* r = rs->buf_r + rs->len;
+        for (int i = 0; i < n; i++) {
+            l[i] = in[2 * i];
+            r[i] = in[2 * i + 1];
+        }
+        in += 2 * (size_t)n;
+        in_frames -= (size_t)n;
+        rs->len += n;
+
+        for (;;) {
+            int i = (int)rs->pos;
+            if (i + taps > rs->len) break;
+            if (produced < out_capacity) {
+                double f = (rs->pos - i) * YAGE_RESAMPLER_PHASES;
+                int p = (int)f;
+                const float* c0 = rs->table + p * taps;
+                float sl, sr;
+                dot_stereo(rs->buf_l + i, rs->buf_r + i, c0, c0 + taps,
+                           (float)(f - p), taps, &sl, &sr);
+                out[2 * produced] = to_s16(sl);
+                out[2 * produced + 1] = to_s16(sr);
+                produced++;
+            }
+            rs->pos += rs->step;
+        }
+
+        int drop = (int)rs->pos;
+        if (drop > rs->len) drop = rs->len;
+        if (drop > 0) {
+            memmove(rs->buf_l, rs->buf_l + drop, (size_t)(rs->len - drop) * sizeof(float));
+            memmove(rs->buf_r, rs->buf_r + drop, (size_t)(rs->len - drop) * sizeof(float));
+            rs->len -= drop;
+            rs->pos -= drop;
+        }
+    }
+    return produced;
+}
+
+double yage_resampler_drc(size_t fill, size_t target, double max_adjust) {
+    if (target == 0) return 1.0;
+    double direction = ((double)target - (double)fill) / (double)target;
+    if (direction < -1.0) direction = -1.0;
+    if (direction > 1.0) direction = 1.0;
+    return 1.0 + max_adjust * direction;
+}
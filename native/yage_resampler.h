@@ -0,0 +1,86 @@
+/*
+ * YAGE Audio Resampler
+ *
+ * Converts the core's interleaved 16-bit stereo to the fixed rate the
+ * audio device runs at, so the device is opened once and never has to be
+ * re-created when a game (or a game mode) changes its sample rate.
+ *
+ * Polyphase windowed sinc (Kaiser window).  The kernel is tabulated at
+ * YAGE_RESAMPLER_PHASES sub-sample offsets and linearly interpolated
+ * between neighbouring phases, so any ratio — including one that moves on
+ * every call — costs the same.  When downsampling, the cutoff follows the
+ * output Nyquist frequency and the kernel widens to match, up to
+ * YAGE_RESAMPLER_MAX_TAPS.  The inner products run 4 taps at a time with
+ * SSE or NEON.
+ *
+ * Dynamic rate control: the device clock never quite matches the
+ * emulated one.  Instead of dropping or padding buffered audio, the
+ * producer nudges the ratio by at most ±YAGE_RESAMPLER_MAX_ADJUST so the
+ * device buffer drifts back toward its target fill (yage_resampler_drc).
+ *
+ * Platform-independent; no allocation outside create / set_rates.
+ * Internal to yage_core — not part of the FFI surface.
+ */
+
+#ifndef YAGE_RESAMPLER_H
+#define YAGE_RESAMPLER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define YAGE_RESAMPLER_PHASES     128
+#define YAGE_RESAMPLER_MAX_TAPS   64
+#define YAGE_RESAMPLER_MAX_ADJUST 0.005   /* ±0.5 % */
+
+typedef struct YageResampler YageResampler;
+
+/* Resampler from `in_rate` to `out_rate` Hz.  Returns NULL for rates
+ * outside 1 kHz..1.536 MHz or on allocation failure. */
+YageResampler* yage_resampler_create(double in_rate, double out_rate);
+void yage_resampler_destroy(YageResampler* rs);
+
+/* Change the rates.  Keeps the buffered input when the kernel length
+ * stays the same (only re-tabulating it if the cutoff moved), so the
+ * ratio can follow a changing playback speed without a gap; otherwise
+ * starts over from silence.  Returns 0 on success, -1 (old rates kept)
+ * for invalid rates or on allocation failure. */
+int yage_resampler_set_rates(YageResampler* rs, double in_rate, double out_rate);
+
+/* Forget the buffered input and the rate adjustment. */
+void yage_resampler_reset(YageResampler* rs);
+
+/* Scale the output rate by `adjust` (clamped to 1 ± MAX_ADJUST): values
+ * above 1 produce slightly more output per input frame. */
+void yage_resampler_set_adjust(YageResampler* rs, double adjust);
+
+/* Output frames per input frame, the adjustment included. */
+double yage_resampler_ratio(const YageResampler* rs);
+
+/* Delay the kernel adds, in input frames (half its length). */
+double yage_resampler_delay(const YageResampler* rs);
+
+/* Upper bound on the frames yage_resampler_process can return for
+ * `in_frames` input frames at any permitted adjustment. */
+size_t yage_resampler_max_output(const YageResampler* rs, size_t in_frames);
+
+/* Consume `in_frames` stereo frames and write up to `out_capacity`
+ * resampled frames to `out`.  Returns the frames written; output beyond
+ * `out_capacity` is discarded, so size `out` with
+ * yage_resampler_max_output. */
+size_t yage_resampler_process(YageResampler* rs, const int16_t* in, size_t in_frames,
+                              int16_t* out, size_t out_capacity);
+
+/* Dynamic rate control step: the adjustment for a device buffer holding
+ * `fill` frames when `target` is wanted — 1 + max_adjust when empty,
+ * 1 at the target, 1 - max_adjust at twice the target or above. */
+double yage_resampler_drc(size_t fill, size_t target, double max_adjust);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* YAGE_RESAMPLER_H */
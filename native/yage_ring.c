@@ -0,0 +1,192 @@
+/*
+ * YAGE Audio Ring — Implementation
+ *
+ * `write` and `read` count frames since the last reset and wrap at 2^32;
+ * write - read is the fill, which the capacity limit (at most 2^30) keeps
+ * unambiguous.  A slot's position is the counter masked by frames - 1.
+ *
+ * Cached indices: the producer only needs the read index when its cached
+ * copy says there is too little room, the consumer the write index when
+ * its copy says there is too little data.  Both copies can only be stale
+ * in the safe direction (too full / too empty), so acting on them is
+ * never wrong, merely conservative.
+ */
+
+#include "yage_ring.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define YAGE_RING_SSE2 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define YAGE_RING_NEON 1
+#endif
+
+#ifndef _WIN32
+#include <stdatomic.h>
+typedef atomic_uint ring_index;
+#define LOAD_ACQUIRE(v)   atomic_load_explicit(&(v), memory_order_acquire)
+#define LOAD_RELAXED(v)   atomic_load_explicit(&(v), memory_order_relaxed)
+#define STORE_RELEASE(v, x) atomic_store_explicit(&(v), (x), memory_order_release)
+#else
+typedef volatile uint32_t ring_index;
+#define LOAD_ACQUIRE(v)   (v)
+#define LOAD_RELAXED(v)   (v)
+#define STORE_RELEASE(v, x) ((v) = (x))
+#endif
+
+/* 64-byte lines, with room for adjacent-line prefetch (x86) and 128-byte
+ * lines (Apple silicon) */
+#define RING_LINE       128
+#define RING_MAX_FRAMES (1u << 30)
+
+struct YageRing {
+    /* Producer */
+    ring_index write;
+    uint32_t   read_cache;
+    uint8_t    pad_write[RING_LINE - sizeof(ring_index) - sizeof(uint32_t)];
+    /* Consumer */
+    ring_index read;
+    uint32_t   write_cache;
+    uint8_t    pad_read[RING_LINE - sizeof(ring_index) - sizeof(uint32_t)];
+    /* Fixed after create */
+    int16_t*   data;
+    uint32_t   frames;
+    uint32_t   mask;
+};
+
+YageRing* yage_ring_create(size_t frames) {
+    if (frames == 0 || frames > RING_MAX_FRAMES) return NULL;
+    uint32_t capacity = 1;
+    while (capacity < frames) capacity <<= 1;
+
+    YageRing* ring = (YageRing*)calloc(1, sizeof(YageRing));
+    if (!ring) return NULL;
+    ring->data = (int16_t*)calloc((size_t)capacity * 2, sizeof(int16_t));
+    if (!ring->data) {
+        free(ring);
+        return NULL;
+    }
+    ring->frames = capacity;
+    ring->mask = capacity - 1;
+    return ring;
+}
+
+void yage_ring_destroy(YageRing* ring) {
+    if (!ring) return;
+    free(ring->data);
+    free(ring);
+}
+
+size_t yage_ring_capacity(const YageRing* ring) {
+    return ring ? ring->frames : 0;
+}
+
+size_t yage_ring_available(const YageRing* ring) {
+    if (!ring) return 0;
+    YageRing* r = (YageRing*)ring;
+    uint32_t read = LOAD_ACQUIRE(r->read);
+    return (uint32_t)(LOAD_ACQUIRE(r->write) - read);
+}
+
+size_t yage_ring_space(YageRing* ring) {
+    if (!ring) return 0;
+    ring->read_cache = LOAD_ACQUIRE(ring->read);
+    return ring->frames - (uint32_t)(LOAD_RELAXED(ring->write) - ring->read_cache);
+}
+
+size_t yage_ring_write(YageRing* ring, const int16_t* src, size_t frames) {
+    if (!ring || !src || frames == 0) return 0;
+    uint32_t w = LOAD_RELAXED(ring->write);
+    size_t space = ring->frames - (uint32_t)(w - ring->read_cache);
+    if (space < frames) {
+        ring->read_cache = LOAD_ACQUIRE(ring->read);
+        space = ring->frames - (uint32_t)(w - ring->read_cache);
+        if (frames > space) frames = space;
+        if (frames == 0) return 0;
+    }
+
+    uint32_t at = w & ring->mask;
+    size_t first = ring->frames - at;
+    if (first > frames) first = frames;
+    memcpy(ring->data + (size_t)at * 2, src, first * 2 * sizeof(int16_t));
+    if (frames > first)
+        memcpy(ring->data, src + first * 2, (frames - first) * 2 * sizeof(int16_t));
+
+    STORE_RELEASE(ring->write, w + (uint32_t)frames);
+    return frames;
+}
+
+/* Frames the consumer may take, reloading the write index only when the
+ * cached one shows fewer than `wanted` */
+static size_t readable(YageRing* ring, uint32_t r, size_t wanted) {
+    size_t have = (uint32_t)(ring->write_cache - r);
+    if (have < wanted) {
+        ring->write_cache = LOAD_ACQUIRE(ring->write);
+        have = (uint32_t)(ring->write_cache - r);
+    }
+    return have < wanted ? have : wanted;
+}
+
+size_t yage_ring_read(YageRing* ring, int16_t* dst, size_t frames) {
+    if (!ring || !dst || frames == 0) return 0;
+    uint32_t r = LOAD_RELAXED(ring->read);
+    frames = readable(ring, r, frames);
+    if (frames == 0) return 0;
+
+    uint32_t at = r & ring->mask;
+    size_t first = ring->frames - at;
+    if (first > frames) first = frames;
+    memcpy(dst, ring->data + (size_t)at * 2, first * 2 * sizeof(int16_t));
+    if (frames > first)
+        memcpy(dst + first * 2, ring->data, (frames - first) * 2 * sizeof(int16_t));
+
+    STORE_RELEASE(ring->read, r + (uint32_t)frames);
+    return frames;
+}
+
+size_t yage_ring_skip(YageRing* ring, size_t frames) {
+    if (!ring || frames == 0) return 0;
+    uint32_t r = LOAD_RELAXED(ring->read);
+    frames = readable(ring, r, frames);
+    if (frames > 0) STORE_RELEASE(ring->read, r + (uint32_t)frames);
+    return frames;
+}
+
+void yage_ring_reset(YageRing* ring) {
+    if (!ring) return;
+    STORE_RELEASE(ring->write, 0);
+    STORE_RELEASE(ring->read, 0);
+    ring->read_cache = 0;
+    ring->write_cache = 0;
+}
+
+void yage_ring_gain(int16_t* dst, const int16_t* src, size_t samples, int gain_q8) {
+    if (gain_q8 < 0) gain_q8 = 0;
+    if (gain_q8 > 256) gain_q8 = 256;
+    size_t i = 0;
+#if defined(YAGE_RING_SSE2)
+    /* 16 × 16 → 32-bit products from the low and high halves, >> 8, pack */
+    const __m128i g = _mm_set1_epi16((short)gain_q8);
+    for (; i + 8 <= samples; i += 8) {
+        __m128i x = _mm_loadu_si128((const __m128i*)(src + i));
+        __m128i lo = _mm_mullo_epi16(x, g), hi = _mm_mulhi_epi16(x, g);
+        __m128i p0 = _mm_srai_epi32(_mm_unpacklo_epi16(lo, hi), 8);
+        __m128i p1 = _mm_srai_epi32(_mm_unpackhi_epi16(lo, hi), 8);
+        _mm_storeu_si128((__m128i*)(dst + i), _mm_packs_epi32(p0, p1));
+    }
+#elif defined(YAGE_RING_NEON)
+    const int16x4_t g = vdup_n_s16((int16_t)gain_q8);
+    for (; i + 8 <= samples; i += 8) {
+        int16x8_t x = vld1q_s16(src + i);
+        int32x4_t lo = vmull_s16(vget_low_s16(x), g);
+        int32x4_t hi = vmull_s16(vget_high_s16(x), g);
+        vst1q_s16(dst + i, vcombine_s16(vshrn_n_s32(lo, 8), vshrn_n_s32(hi, 8)));
+    }
+#endif
+    for (; i < samples; i++)
+        dst[i] = (int16_t)((src[i] * gain_q8) >> 8);
+}
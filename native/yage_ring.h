@@ -0,0 +1,76 @@
+/*
+ * YAGE Audio Ring
+ *
+ * Single-producer / single-consumer ring of interleaved 16-bit stereo
+ * frames, shared by the audio engine (core → device) and the pull stream
+ * (core → host).  Lock-free and never blocking:
+ *
+ *   - the indices are free-running frame counters, each stored only by
+ *     its own side (release) and read by the other (acquire), so the whole
+ *     capacity is usable and no slot is sacrificed to tell full from empty
+ *   - the write index, the read index and the read-only geometry each sit
+ *     on their own cache line, so the two sides never false-share; each
+ *     side also keeps a cached copy of the other's index and only reloads
+ *     it when the cached value says the ring is full / empty
+ *   - a push or pop is at most two memcpy's: up to the end of the buffer,
+ *     then from its start
+ *
+ * yage_ring_gain() is the volume pass that goes with it: Q8 fixed-point
+ * scaling, 8 samples at a time with SSE2 or NEON.
+ *
+ * On Windows there is no frame loop thread and the indices are plain
+ * volatiles: producer and consumer must run on the same thread there.
+ * Internal to yage_core — not part of the FFI surface.
+ */
+
+#ifndef YAGE_RING_H
+#define YAGE_RING_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct YageRing YageRing;
+
+/* Ring holding at least `frames` stereo frames (rounded up to a power of
+ * two).  Returns NULL for 0 or more than 2^30 frames, or on allocation
+ * failure. */
+YageRing* yage_ring_create(size_t frames);
+void yage_ring_destroy(YageRing* ring);
+
+/* Capacity in stereo frames. */
+size_t yage_ring_capacity(const YageRing* ring);
+
+/* Frames queued.  Exact on either side; a snapshot from any other thread. */
+size_t yage_ring_available(const YageRing* ring);
+
+/* Producer: append up to `frames` frames from `src`.  Returns the frames
+ * written — fewer than asked only when the ring is full. */
+size_t yage_ring_write(YageRing* ring, const int16_t* src, size_t frames);
+
+/* Producer: frames that can be written without dropping any. */
+size_t yage_ring_space(YageRing* ring);
+
+/* Consumer: take up to `frames` frames into `dst`.  Returns the frames
+ * read. */
+size_t yage_ring_read(YageRing* ring, int16_t* dst, size_t frames);
+
+/* Consumer: drop up to `frames` of the oldest frames.  Returns the frames
+ * dropped. */
+size_t yage_ring_skip(YageRing* ring, size_t frames);
+
+/* Empty the ring.  Neither side may be inside a call. */
+void yage_ring_reset(YageRing* ring);
+
+/* dst[i] = (src[i] × gain_q8) >> 8 for `samples` samples, gain_q8 in
+ * 0..256 (256 = unity).  dst may equal src. */
+void yage_ring_gain(int16_t* dst, const int16_t* src, size_t samples, int gain_q8);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* YAGE_RING_H */
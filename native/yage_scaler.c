@@ -0,0 +1,477 @@
+/*
+ * YAGE Pixel-Art Upscalers — Implementation
+ *
+ * Every filter is written once per pixel in scalar form (used for the
+ * first / last column, where neighbours are clamped) and once over a tiny
+ * 4-lane vector vocabulary (v_eq, v_sel, v_avg, ...) that maps onto SSE2
+ * or NEON.  Scale2x/3x use only equality tests, so their output is
+ * bit-exact across instruction sets; xBR-lite adds a per-pixel colour
+ * distance (sum of absolute channel differences) and a rounding byte
+ * average, which are exact too.
+ *
+ * Neighbourhood naming follows the Scale2x reference:
+ *
+ *     A B C
+ *     D E F
+ *     G H I
+ */
+
+#include "yage_scaler.h"
+#include "yage_libretro.h"  /* YAGE_SCALER_* */
+
+#include <stddef.h>
+#include <string.h>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define YAGE_SCALER_SSE2 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define YAGE_SCALER_NEON 1
+#endif
+
+#ifndef _WIN32
+#include <pthread.h>
+#include <stdatomic.h>
+#include <unistd.h>
+#endif
+
+/* Source rows per band handed to one worker */
+#define SCALER_BAND_ROWS   16
+#define SCALER_MAX_WORKERS 3
+
+/* ── Scalar reference ─────────────────────────────────────────────────── */
+
+/* Sum of absolute R, G, B differences (alpha ignored) */
+static inline uint32_t px_dist(uint32_t a, uint32_t b) {
+    uint32_t d = 0;
+    for (int s = 0; s < 24; s += 8) {
+        int ca = (int)((a >> s) & 0xFF), cb = (int)((b >> s) & 0xFF);
+        d += (uint32_t)(ca > cb ? ca - cb : cb - ca);
+    }
+    return d;
+}
+
+/* Per-byte (a + b + 1) >> 1 — same rounding as pavgb / vrhadd */
+static inline uint32_t px_avg(uint32_t a, uint32_t b) {
+    return (a | b) - (((a ^ b) & 0xFEFEFEFEu) >> 1);
+}
+
+static inline void scale2x_px(uint32_t B, uint32_t D, uint32_t E, uint32_t F, uint32_t H,
+                              uint32_t* o0, uint32_t* o1) {
+    if (B != H && D != F) {
+        o0[0] = (D == B) ? D : E;
+        o0[1] = (B == F) ? F : E;
+        o1[0] = (D == H) ? D : E;
+        o1[1] = (H == F) ? F : E;
+    } else {
+        o0[0] = o0[1] = o1[0] = o1[1] = E;
+    }
+}
+
+static inline void scale3x_px(uint32_t A, uint32_t B, uint32_t C, uint32_t D, uint32_t E,
+                              uint32_t F, uint32_t G, uint32_t H, uint32_t I,
+                              uint32_t* o0, uint32_t* o1, uint32_t* o2) {
+    if (B != H && D != F) {
+        o0[0] = (D == B) ? D : E;
+        o0[1] = ((D == B && E != C) || (B == F && E != A)) ? B : E;
+        o0[2] = (B == F) ? F : E;
+        o1[0] = ((D == B && E != G) || (D == H && E != A)) ? D : E;
+        o1[1] = E;
+        o1[2] = ((B == F && E != I) || (H == F && E != C)) ? F : E;
+        o2[0] = (D == H) ? D : E;
+        o2[1] = ((D == H && E != I) || (H == F && E != G)) ? H : E;
+        o2[2] = (H == F) ? F : E;
+    } else {
+        o0[0] = o0[1] = o0[2] = E;
+        o1[0] = o1[1] = o1[2] = E;
+        o2[0] = o2[1] = o2[2] = E;
+    }
+}
+
+/* One xBR-lite corner: if the P-Q diagonal (the two edge neighbours of the
+ * corner) is more continuous than E to the corner pixel K, blend E halfway
+ * toward whichever of P / Q is closer to it. */
+static inline uint32_t xbr_corner(uint32_t E, uint32_t P, uint32_t Q, uint32_t K) {
+    if (px_dist(P, Q) >= px_dist(E, K)) return E;
+    return px_avg(E, px_dist(E, P) <= px_dist(E, Q) ? P : Q);
+}
+
+static inline void xbr2x_px(uint32_t A, uint32_t B, uint32_t C, uint32_t D, uint32_t E,
+                            uint32_t F, uint32_t G, uint32_t H, uint32_t I,
+                            uint32_t* o0, uint32_t* o1) {
+    o0[0] = xbr_corner(E, D, B, A);
+    o0[1] = xbr_corner(E, B, F, C);
+    o1[0] = xbr_corner(E, D, H, G);
+    o1[1] = xbr_corner(E, F, H, I);
+}
+
+/* ── 4-lane vector vocabulary ─────────────────────────────────────────── */
+
+#if defined(YAGE_SCALER_SSE2)
+
+typedef __m128i vpx;
+
+static inline vpx v_load(const uint32_t* p) { return _mm_loadu_si128((const __m128i*)p); }
+static inline vpx v_eq(vpx a, vpx b) { return _mm_cmpeq_epi32(a, b); }
+static inline vpx v_and(vpx a, vpx b) { return _mm_and_si128(a, b); }
+static inline vpx v_or(vpx a, vpx b) { return _mm_or_si128(a, b); }
+static inline vpx v_andnot(vpx m, vpx a) { return _mm_andnot_si128(m, a); }  /* a & ~m */
+static inline vpx v_sel(vpx m, vpx a, vpx b) {
+    return _mm_or_si128(_mm_and_si128(m, a), _mm_andnot_si128(m, b));
+}
+static inline vpx v_avg(vpx a, vpx b) { return _mm_avg_epu8(a, b); }
+static inline vpx v_lt(vpx a, vpx b) { return _mm_cmplt_epi32(a, b); }  /* distances < 766 */
+static inline vpx v_dist(vpx a, vpx b) {
+    vpx d = _mm_or_si128(_mm_subs_epu8(a, b), _mm_subs_epu8(b, a));
+    const vpx mff = _mm_set1_epi32(0xFF);
+    return _mm_add_epi32(_mm_add_epi32(_mm_and_si128(d, mff),
+                                       _mm_and_si128(_mm_srli_epi32(d, 8), mff)),
+                         _mm_and_si128(_mm_srli_epi32(d, 16), mff));
+}
+static inline void v_store_zip2(uint32_t* p, vpx a, vpx b) {
+    _mm_storeu_si128((__m128i*)p,     _mm_unpacklo_epi32(a, b));
+    _mm_storeu_si128((__m128i*)p + 1, _mm_unpackhi_epi32(a, b));
+}
+static inline void v_store_zip3(uint32_t* p, vpx a, vpx b, vpx c) {
+    uint32_t t[3][4];
+    _mm_storeu_si128((__m128i*)t[0], a);
+    _mm_storeu_si128((__m128i*)t[1], b);
+    _mm_storeu_si128((__m128i*)t[2], c);
+    for (int i = 0; i < 4; i++) {
+        p[3 * i] = t[0][i];
+        p[3 * i + 1] = t[1][i];
+        p[3 * i + 2] = t[2][i];
+    }
+}
+
+#elif defined(YAGE_SCALER_NEON)
+
+typedef uint32x4_t vpx;
+
+static inline vpx v_load(const uint32_t* p) { return vld1q_u32(p); }
+static inline vpx v_eq(vpx a, vpx b) { return vceqq_u32(a, b); }
+static inline vpx v_and(vpx a, vpx b) { return vandq_u32(a, b); }
+static inline vpx v_or(vpx a, vpx b) { return vorrq_u32(a, b); }
+static inline vpx v_andnot(vpx m, vpx a) { return vbicq_u32(a, m); }  /* a & ~m */
+static inline vpx v_sel(vpx m, vpx a, vpx b) { return vbslq_u32(m, a, b); }
+static inline vpx v_avg(vpx a, vpx b) {
+    return vreinterpretq_u32_u8(vrhaddq_u8(vreinterpretq_u8_u32(a),
+                                           vreinterpretq_u8_u32(b)));
+}
+static inline vpx v_lt(vpx a, vpx b) { return vcltq_u32(a, b); }
+static inline vpx v_dist(vpx a, vpx b) {
+    uint8x16_t d = vabdq_u8(vreinterpretq_u8_u32(a), vreinterpretq_u8_u32(b));
+    d = vandq_u8(d, vreinterpretq_u8_u32(vdupq_n_u32(0x00FFFFFF)));
+    return vpaddlq_u16(vpaddlq_u8(d));
+}
+static inline void v_store_zip2(uint32_t* p, vpx a, vpx b) {
+    uint32x4x2_t z = vzipq_u32(a, b);
+    vst1q_u32(p, z.val[0]);
+    vst1q_u32(p + 4, z.val[1]);
+}
+static inline void v_store_zip3(uint32_t* p, vpx a, vpx b, vpx c) {
+    uint32x4x3_t z;
+    z.val[0] = a;
+    z.val[1] = b;
+    z.val[2] = c;
+    vst3q_u32(p, z);
+}
+
+#endif
+
+#if defined(YAGE_SCALER_SSE2) || defined(YAGE_SCALER_NEON)
+#define YAGE_SCALER_SIMD 1
+#endif
+
+/* ── Row kernels ──────────────────────────────────────────────────────── */
+
+/* Neighbour fetch with the frame edge replicated */
+#define NB(row, x, w) ((row)[(x) < 0 ? 0 : ((x) >= (w) ? (w) - 1 : (x))])
+
+static void scale2x_row(const uint32_t* up, const uint32_t* mid, const uint32_t* dn,
+                        int w, uint32_t* o0, uint32_t* o1) {
+    int x = 0;
+#ifdef YAGE_SCALER_SIMD
+    /* Vector loop covers columns whose left/right neighbours are in range */
+    if (w > 5) {
+        scale2x_px(up[0], mid[0], mid[0], mid[1], dn[0], o0, o1);
+        for (x = 1; x + 4 < w; x += 4) {
+            vpx B = v_load(up + x), H = v_load(dn + x), E = v_load(mid + x);
+            vpx D = v_load(mid + x - 1), F = v_load(mid + x + 1);
+            vpx DB = v_eq(D, B), BF = v_eq(B, F), DH = v_eq(D, H), HF = v_eq(H, F);
+            vpx c0 = v_andnot(v_or(BF, DH), DB);
+            vpx c1 = v_andnot(v_or(DB, HF), BF);
+            vpx c2 = v_andnot(v_or(DB, HF), DH);
+            vpx c3 = v_andnot(v_or(DH, BF), HF);
+            v_store_zip2(o0 + 2 * x, v_sel(c0, D, E), v_sel(c1, F, E));
+            v_store_zip2(o1 + 2 * x, v_sel(c2, D, E), v_sel(c3, F, E));
+        }
+    }
+#endif
+    for (; x < w; x++) {
+        scale2x_px(up[x], NB(mid, x - 1, w), mid[x], NB(mid, x + 1, w), dn[x],
+                   o0 + 2 * x, o1 + 2 * x);
+    }
+}
+
+static void scale3x_row(const uint32_t* up, const uint32_t* mid, const uint32_t* dn,
+                        int w, uint32_t* o0, uint32_t* o1, uint32_t* o2) {
+    int x = 0;
+#ifdef YAGE_SCALER_SIMD
+    if (w > 5) {
+        scale3x_px(up[0], up[0], up[1], mid[0], mid[0], mid[1], dn[0], dn[0], dn[1],
+                   o0, o1, o2);
+        for (x = 1; x + 4 < w; x += 4) {
+            vpx A = v_load(up + x - 1), B = v_load(up + x), C = v_load(up + x + 1);
+            vpx D = v_load(mid + x - 1), E = v_load(mid + x), F = v_load(mid + x + 1);
+            vpx G = v_load(dn + x - 1), H = v_load(dn + x), I = v_load(dn + x + 1);
+            vpx DB = v_eq(D, B), BF = v_eq(B, F), DH = v_eq(D, H), HF = v_eq(H, F);
+            vpx EA = v_eq(E, A), EC = v_eq(E, C), EG = v_eq(E, G), EI = v_eq(E, I);
+            /* c0..c3: the four Scale2x corner conditions (they imply B!=H, D!=F) */
+            vpx c0 = v_andnot(v_or(BF, DH), DB);
+            vpx c1 = v_andnot(v_or(DB, HF), BF);
+            vpx c2 = v_andnot(v_or(DB, HF), DH);
+            vpx c3 = v_andnot(v_or(DH, BF), HF);
+            vpx m1 = v_or(v_andnot(EC, c0), v_andnot(EA, c1));
+            vpx m3 = v_or(v_andnot(EG, c0), v_andnot(EA, c2));
+            vpx m5 = v_or(v_andnot(EI, c1), v_andnot(EC, c3));
+            vpx m7 = v_or(v_andnot(EI, c2), v_andnot(EG, c3));
+            v_store_zip3(o0 + 3 * x, v_sel(c0, D, E), v_sel(m1, B, E), v_sel(c1, F, E));
+            v_store_zip3(o1 + 3 * x, v_sel(m3, D, E), E, v_sel(m5, F, E));
+            v_store_zip3(o2 + 3 * x, v_sel(c2, D, E), v_sel(m7, H, E), v_sel(c3, F, E));
+        }
+    }
+#endif
+    for (; x < w; x++) {
+        scale3x_px(NB(up, x - 1, w), up[x], NB(up, x + 1, w),
+                   NB(mid, x - 1, w), mid[x], NB(mid, x + 1, w),
+                   NB(dn, x - 1, w), dn[x], NB(dn, x + 1, w),
+                   o0 + 3 * x, o1 + 3 * x, o2 + 3 * x);
+    }
+}
+
+#ifdef YAGE_SCALER_SIMD
+static inline vpx v_xbr_corner(vpx E, vpx P, vpx Q, vpx K) {
+    vpx blend = v_lt(v_dist(P, Q), v_dist(E, K));
+    vpx take_q = v_lt(v_dist(E, Q), v_dist(E, P));   /* !(d(E,P) <= d(E,Q)) */
+    return v_sel(blend, v_avg(E, v_sel(take_q, Q, P)), E);
+}
+#endif
+
+static void xbr2x_row(const uint32_t* up, const uint32_t* mid, const uint32_t* dn,
+                      int w, uint32_t* o0, uint32_t* o1) {
+    int x = 0;
+#ifdef YAGE_SCALER_SIMD
+    if (w > 5) {
+        xbr2x_px(up[0], up[0], up[1], mid[0], mid[0], mid[1], dn[0], dn[0], dn[1], o0, o1);
+        for (x = 1; x + 4 < w; x += 4) {
+            vpx A = v_load(up + x - 1), B = v_load(up + x), C = v_load(up + x + 1);
+            vpx D = v_load(mid + x - 1), E = v_load(mid + x), F = v_load(mid + x + 1);
+            vpx G = v_load(dn + x - 1), H = v_load(dn + x), I = v_load(dn + x + 1);
+            v_store_zip2(o0 + 2 * x, v_xbr_corner(E, D, B, A), v_xbr_corner(E, B, F, C));
+            v_store_zip2(o1 + 2 * x, v_xbr_corner(E, D, H, G), v_xbr_corner(E, F, H, I));
+        }
+    }
+#endif
+    for (; x < w; x++) {
+        xbr2x_px(NB(up, x - 1, w), up[x], NB(up, x + 1, w),
+                 NB(mid, x - 1, w), mid[x], NB(mid, x + 1, w),
+                 NB(dn, x - 1, w), dn[x], NB(dn, x + 1, w),
+                 o0 + 2 * x, o1 + 2 * x);
+    }
+}
+
+static void nearest_row(const uint32_t* mid, int w, int f, uint32_t* o0) {
+    int x = 0;
+#ifdef YAGE_SCALER_SIMD
+    if (f == 2 || f == 4) {
+        for (; x + 4 <= w; x += 4) {
+            vpx E = v_load(mid + x);
+            if (f == 2) {
+                v_store_zip2(o0 + 2 * x, E, E);
+            } else {
+                uint32_t t[8];
+                v_store_zip2(t, E, E);
+                vpx lo = v_load(t), hi = v_load(t + 4);
+                v_store_zip2(o0 + 4 * x, lo, lo);
+                v_store_zip2(o0 + 4 * x + 8, hi, hi);
+            }
+        }
+    }
+#endif
+    for (; x < w; x++) {
+        for (int k = 0; k < f; k++) o0[f * x + k] = mid[x];
+    }
+}
+
+#undef NB
+
+/* Scale source rows [y0, y1) — single-threaded */
+static void scale_rows(int mode, int f, const uint32_t* src, int w, int h,
+                       uint32_t* dst, int dst_stride, int y0, int y1) {
+    for (int y = y0; y < y1; y++) {
+        const uint32_t* mid = src + (size_t)y * w;
+        const uint32_t* up  = y > 0 ? mid - w : mid;
+        const uint32_t* dn  = y < h - 1 ? mid + w : mid;
+        uint32_t* o0 = dst + (size_t)y * f * dst_stride;
+        uint32_t* o1 = o0 + dst_stride;
+        switch (mode) {
+            case YAGE_SCALER_SCALE2X:
+                scale2x_row(up, mid, dn, w, o0, o1);
+                break;
+            case YAGE_SCALER_SCALE3X:
+                scale3x_row(up, mid, dn, w, o0, o1, o1 + dst_stride);
+                break;
+            case YAGE_SCALER_XBR2X:
+                xbr2x_row(up, mid, dn, w, o0, o1);
+                break;
+            default:
+                nearest_row(mid, w, f, o0);
+                for (int k = 1; k < f; k++) {
+                    memcpy(o0 + (size_t)k * dst_stride, o0, (size_t)w * f * sizeof(uint32_t));
+                }
+                break;
+        }
+    }
+}
+
+int yage_scaler_factor(int mode, int factor) {
+    switch (mode) {
+        case YAGE_SCALER_NEAREST:
+            return factor < 2 ? 2 : (factor > 4 ? 4 : factor);
+        case YAGE_SCALER_SCALE2X:
+        case YAGE_SCALER_XBR2X:
+            return 2;
+        case YAGE_SCALER_SCALE3X:
+            return 3;
+        default:
+            return 1;
+    }
+}
+
+/* ── Worker pool ──────────────────────────────────────────────────────── */
+
+#ifndef _WIN32
+
+typedef struct {
+    int mode, factor;
+    const uint32_t* src;
+    int width, height;
+    uint32_t* dst;
+    int dst_stride;
+    int y0, y1;
+} ScaleJob;
+
+static pthread_t       g_pool_threads[SCALER_MAX_WORKERS];
+static int             g_pool_size    = -1;    /* -1 → not started yet */
+static pthread_mutex_t g_pool_mutex   = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  g_pool_wake    = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t  g_pool_idle    = PTHREAD_COND_INITIALIZER;
+static unsigned        g_pool_gen     = 0;     /* bumped per job, under the mutex */
+static int             g_pool_busy    = 0;     /* workers inside a job, under the mutex */
+static int             g_pool_quit    = 0;
+static ScaleJob        g_pool_job;
+static int             g_pool_bands   = 0;
+static atomic_int      g_pool_next    = 0;     /* next band to take */
+
+static void run_bands(void) {
+    const ScaleJob* j = &g_pool_job;
+    int band;
+    while ((band = atomic_fetch_add_explicit(&g_pool_next, 1, memory_order_relaxed))
+           < g_pool_bands) {
+        int y0 = j->y0 + band * SCALER_BAND_ROWS;
+        int y1 = y0 + SCALER_BAND_ROWS < j->y1 ? y0 + SCALER_BAND_ROWS : j->y1;
+        scale_rows(j->mode, j->factor, j->src, j->width, j->height,
+                   j->dst, j->dst_stride, y0, y1);
+    }
+}
+
+static void* pool_worker(void* arg) {
+    (void)arg;
+    unsigned seen = 0;
+    pthread_mutex_lock(&g_pool_mutex);
+    for (;;) {
+        while (g_pool_gen == seen && !g_pool_quit) {
+            pthread_cond_wait(&g_pool_wake, &g_pool_mutex);
+        }
+        if (g_pool_quit) break;
+        seen = g_pool_gen;
+        g_pool_busy++;
+        pthread_mutex_unlock(&g_pool_mutex);
+
+        run_bands();
+
+        pthread_mutex_lock(&g_pool_mutex);
+        if (--g_pool_busy == 0) pthread_cond_signal(&g_pool_idle);
+    }
+    pthread_mutex_unlock(&g_pool_mutex);
+    return NULL;
+}
+
+static void pool_start(void) {
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    int want = cpus > 1 ? (int)cpus - 1 : 0;   /* the caller is one of the lanes */
+    if (want > SCALER_MAX_WORKERS) want = SCALER_MAX_WORKERS;
+    g_pool_quit = 0;
+    g_pool_size = 0;
+    for (int i = 0; i < want; i++) {
+        if (pthread_create(&g_pool_threads[i], NULL, pool_worker, NULL) != 0) break;
+        g_pool_size++;
+    }
+}
+
+void yage_scaler_run(int mode, int factor, const uint32_t* src, int width, int height,
+                     uint32_t* dst, int dst_stride, int y0, int y1) {
+    int f = yage_scaler_factor(mode, factor);
+    if (f < 2 || !src || !dst || width <= 0 || y0 >= y1) return;
+
+    if (g_pool_size < 0) pool_start();
+    int bands = (y1 - y0 + SCALER_BAND_ROWS - 1) / SCALER_BAND_ROWS;
+    if (g_pool_size == 0 || bands < 2) {
+        scale_rows(mode, f, src, width, height, dst, dst_stride, y0, y1);
+        return;
+    }
+
+    pthread_mutex_lock(&g_pool_mutex);
+    /* Workers still draining a previous job would race the job fields */
+    while (g_pool_busy > 0) pthread_cond_wait(&g_pool_idle, &g_pool_mutex);
+    g_pool_job = (ScaleJob){ mode, f, src, width, height, dst, dst_stride, y0, y1 };
+    g_pool_bands = bands;
+    atomic_store_explicit(&g_pool_next, 0, memory_order_relaxed);
+    g_pool_gen++;
+    pthread_cond_broadcast(&g_pool_wake);
+    pthread_mutex_unlock(&g_pool_mutex);
+
+    run_bands();
+
+    pthread_mutex_lock(&g_pool_mutex);
+    while (g_pool_busy > 0) pthread_cond_wait(&g_pool_idle, &g_pool_mutex);
+    pthread_mutex_unlock(&g_pool_mutex);
+}
+
+void yage_scaler_shutdown(void) {
+    if (g_pool_size <= 0) {
+        g_pool_size = -1;
+        return;
+    }
+    pthread_mutex_lock(&g_pool_mutex);
+    g_pool_quit = 1;
+    pthread_cond_broadcast(&g_pool_wake);
+    pthread_mutex_unlock(&g_pool_mutex);
+    for (int i = 0; i < g_pool_size; i++) pthread_join(g_pool_threads[i], NULL);
+    g_pool_size = -1;
+}
+
+#else /* _WIN32 — no pool, the display path is POSIX-only anyway */
+
+void yage_scaler_run(int mode, int factor, const uint32_t* src, int width, int height,
+                     uint32_t* dst, int dst_stride, int y0, int y1) {
+    int f = yage_scaler_factor(mode, factor);
+    if (f < 2 || !src || !dst || width <= 0 || y0 >= y1) return;
+    scale_rows(mode, f, src, width, height, dst, dst_stride, y0, y1);
+}
+
+void yage_scaler_shutdown(void) {}
+
+#endif /* _WIN32 */
@@ -0,0 +1,49 @@
+/*
+ * YAGE Pixel-Art Upscalers
+ *
+ * Post-conversion scaling of a 32-bit frame (RGBA8888 or BGRA8888 — the
+ * filters only compare and average whole pixels / bytes, so channel order
+ * does not matter):
+ *
+ *   NEAREST   integer nearest-neighbour, 2×..4×
+ *   SCALE2X   AdvMAME Scale2x — edge-preserving, no new colours
+ *   SCALE3X   AdvMAME Scale3x
+ *   XBR2X     lightweight xBR: blends a corner toward the neighbour pair
+ *             that forms the stronger diagonal edge (3×3 window only)
+ *
+ * Interior pixels are processed 4 at a time with SSE2 or NEON; frame edges
+ * replicate the border pixel.  Large jobs are split into row bands and run
+ * on a small worker pool (POSIX only) with the calling thread helping.
+ *
+ * Internal to yage_core — not part of the FFI surface.
+ */
+
+#ifndef YAGE_SCALER_H
+#define YAGE_SCALER_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Effective scale factor for a YAGE_SCALER_* mode and requested `factor`
+ * (only NEAREST honours it, clamped to 2..4).  1 for YAGE_SCALER_NONE or
+ * an unknown mode. */
+int yage_scaler_factor(int mode, int factor);
+
+/* Scale source rows [y0, y1) of the `width` × `height` frame `src` (rows
+ * packed) into `dst`, whose rows are `dst_stride` pixels apart.  Output
+ * rows [y0 * f, y1 * f) are written, f = yage_scaler_factor(mode, factor).
+ * Rows outside the range are read as neighbours but never written. */
+void yage_scaler_run(int mode, int factor, const uint32_t* src, int width, int height,
+                     uint32_t* dst, int dst_stride, int y0, int y1);
+
+/* Stop the worker pool (started lazily by yage_scaler_run). */
+void yage_scaler_shutdown(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* YAGE_SCALER_H */
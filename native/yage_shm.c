@@ -0,0 +1,208 @@
+/*
+ * YAGE Shared-Memory Frame Export — Implementation
+ *
+ * Single writer, any number of readers in other processes.  Each slot is
+ * a seqlock: the writer makes seq odd, fences, fills the slot, then makes
+ * seq even again with a release store and finally advances `latest`.
+ * Readers never write to the mapping, so nothing they do (or fail to do)
+ * can stall the frame thread.
+ *
+ * Shutdown: the producer brackets every publish with g_shm_pushing, and
+ * yage_shm_close() clears g_shm_active then waits for g_shm_pushing to
+ * drain before unmapping (both sequentially consistent, as in
+ * yage_record.c).
+ */
+
+#include "yage_shm.h"
+
+#if !defined(_WIN32) && !defined(__ANDROID__)
+#include <fcntl.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "yage_libretro.h"  /* YAGE_OUTPUT_* */
+
+#define SHM_HEADER_SIZE    64
+#define SHM_SLOT_HEADER    64
+#define SHM_DEFAULT_SLOTS  3
+#define SHM_MAX_SLOTS      16
+#define SHM_NAME_MAX       128
+
+typedef struct {
+    uint32_t      magic;
+    uint32_t      version;
+    uint32_t      header_size;
+    uint32_t      slot_count;
+    uint32_t      slot_size;
+    uint32_t      pixel_capacity;
+    _Atomic uint32_t latest;
+    uint32_t      writer_pid;
+    uint8_t       reserved[SHM_HEADER_SIZE - 32];
+} shm_header_t;
+
+typedef struct {
+    _Atomic uint32_t seq;
+    uint32_t      frame;
+    uint64_t      timestamp_ns;
+    uint32_t      width;
+    uint32_t      height;
+    uint32_t      stride;
+    uint32_t      format;
+    uint8_t       reserved[SHM_SLOT_HEADER - 32];
+} shm_slot_t;
+
+_Static_assert(sizeof(shm_header_t) == SHM_HEADER_SIZE, "shm header layout");
+_Static_assert(sizeof(shm_slot_t) == SHM_SLOT_HEADER, "shm slot layout");
+
+static atomic_int  g_shm_active  = 0;   /* producer may publish */
+static atomic_int  g_shm_pushing = 0;   /* producer inside a publish */
+static uint8_t*    g_shm_base    = NULL;
+static size_t      g_shm_size    = 0;
+static uint32_t    g_shm_frame   = 0;   /* last frame number written */
+static char        g_shm_name[SHM_NAME_MAX];
+static atomic_uint g_shm_published = 0;
+static atomic_uint g_shm_dropped   = 0;
+
+static shm_slot_t* slot_at(const shm_header_t* h, uint32_t index) {
+    return (shm_slot_t*)(g_shm_base + h->header_size + (size_t)index * h->slot_size);
+}
+
+int yage_shm_open(const char* name, int slots, size_t pixel_capacity) {
+    if (!name || !name[0] || pixel_capacity == 0) return -1;
+    if (g_shm_base) return -1;
+
+    if (name[0] == '/') snprintf(g_shm_name, sizeof(g_shm_name), "%s", name);
+    else snprintf(g_shm_name, sizeof(g_shm_name), "/%s", name);
+
+    if (slots <= 0) slots = SHM_DEFAULT_SLOTS;
+    if (slots < 2) slots = 2;
+    if (slots > SHM_MAX_SLOTS) slots = SHM_MAX_SLOTS;
+
+    size_t pixel_span = (pixel_capacity + 63) & ~(size_t)63;
+    size_t slot_size = SHM_SLOT_HEADER + pixel_span;
+    if (slot_size > 0xFFFFFFFFu) return -1;
+    size_t total = SHM_HEADER_SIZE + slot_size * (size_t)slots;
+
+    /* A stale object from a crashed session would keep its old layout */
+    shm_unlink(g_shm_name);
+    int fd = shm_open(g_shm_name, O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0) return -1;
+    if (ftruncate(fd, (off_t)total) != 0) {
+        close(fd);
+        shm_unlink(g_shm_name);
+        return -1;
+    }
+    void* map = mmap(NULL, total, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        shm_unlink(g_shm_name);
+        return -1;
+    }
+
+    /* ftruncate zero-fills: every seq starts even, latest at 0 */
+    g_shm_base = (uint8_t*)map;
+    g_shm_size = total;
+    g_shm_frame = 0;
+    atomic_store_explicit(&g_shm_published, 0, memory_order_relaxed);
+    atomic_store_explicit(&g_shm_dropped, 0, memory_order_relaxed);
+
+    shm_header_t* h = (shm_header_t*)g_shm_base;
+    h->version = YAGE_SHM_VERSION;
+    h->header_size = SHM_HEADER_SIZE;
+    h->slot_count = (uint32_t)slots;
+    h->slot_size = (uint32_t)slot_size;
+    h->pixel_capacity = (uint32_t)pixel_span;
+    h->writer_pid = (uint32_t)getpid();
+    atomic_thread_fence(memory_order_release);
+    h->magic = YAGE_SHM_MAGIC;
+
+    atomic_store(&g_shm_active, 1);
+    return 0;
+}
+
+void yage_shm_close(void) {
+    if (!g_shm_base) return;
+
+    /* No new publishes; wait out one in flight before unmapping */
+    atomic_store(&g_shm_active, 0);
+    while (atomic_load(&g_shm_pushing) > 0) {
+        struct timespec ts = { 0, 100000 };
+        nanosleep(&ts, NULL);
+    }
+
+    munmap(g_shm_base, g_shm_size);
+    shm_unlink(g_shm_name);
+    g_shm_base = NULL;
+    g_shm_size = 0;
+}
+
+int yage_shm_active(void) {
+    return atomic_load_explicit(&g_shm_active, memory_order_relaxed);
+}
+
+void yage_shm_publish(const void* pixels, int width, int height, int format) {
+    atomic_fetch_add(&g_shm_pushing, 1);
+    if (!atomic_load(&g_shm_active) || !pixels || width <= 0 || height <= 0) goto done;
+
+    shm_header_t* h = (shm_header_t*)g_shm_base;
+    size_t stride = (size_t)width * (format == YAGE_OUTPUT_RGB565 ? 2 : 4);
+    size_t bytes = stride * (size_t)height;
+    if (bytes > h->pixel_capacity) {
+        atomic_fetch_add_explicit(&g_shm_dropped, 1, memory_order_relaxed);
+        goto done;
+    }
+
+    uint32_t frame = ++g_shm_frame;
+    if (frame == 0) frame = ++g_shm_frame;   /* 0 means "no frame yet" */
+    shm_slot_t* s = slot_at(h, frame % h->slot_count);
+
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    /* Only this thread writes seq, so a relaxed read-modify is enough */
+    uint32_t seq = atomic_load_explicit(&s->seq, memory_order_relaxed);
+    atomic_store_explicit(&s->seq, seq + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+
+    s->frame = frame;
+    s->timestamp_ns = (uint64_t)now.tv_sec * 1000000000ull + (uint64_t)now.tv_nsec;
+    s->width = (uint32_t)width;
+    s->height = (uint32_t)height;
+    s->stride = (uint32_t)stride;
+    s->format = (uint32_t)format;
+    memcpy((uint8_t*)s + SHM_SLOT_HEADER, pixels, bytes);
+
+    atomic_store_explicit(&s->seq, seq + 2, memory_order_release);
+    atomic_store_explicit(&h->latest, frame, memory_order_release);
+    atomic_fetch_add_explicit(&g_shm_published, 1, memory_order_relaxed);
+
+done:
+    atomic_fetch_sub(&g_shm_pushing, 1);
+}
+
+void yage_shm_stats(uint32_t* published, uint32_t* dropped) {
+    if (published) *published = atomic_load_explicit(&g_shm_published, memory_order_relaxed);
+    if (dropped) *dropped = atomic_load_explicit(&g_shm_dropped, memory_order_relaxed);
+}
+
+#else /* _WIN32 / Android — no POSIX shared memory */
+
+int yage_shm_open(const char* name, int slots, size_t pixel_capacity) {
+    (void)name; (void)slots; (void)pixel_capacity;
+    return -1;
+}
+void yage_shm_close(void) {}
+int  yage_shm_active(void) { return 0; }
+void yage_shm_publish(const void* pixels, int width, int height, int format) {
+    (void)pixels; (void)width; (void)height; (void)format;
+}
+void yage_shm_stats(uint32_t* published, uint32_t* dropped) {
+    if (published) *published = 0;
+    if (dropped) *dropped = 0;
+}
+
+#endif
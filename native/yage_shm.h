@@ -0,0 +1,80 @@
+/*
+ * YAGE Shared-Memory Frame Export
+ *
+ * Publishes presented frames into a POSIX shared-memory object
+ * (shm_open) so capture, streaming and overlay tools on the same machine
+ * can map it and read frames in place instead of grabbing the window.
+ *
+ * Layout (little-endian, all offsets in bytes):
+ *
+ *   Header, 64 bytes at offset 0
+ *     0  u32  magic          YAGE_SHM_MAGIC — written last, once the
+ *                            ring is ready
+ *     4  u32  version        YAGE_SHM_VERSION
+ *     8  u32  header_size    offset of slot 0
+ *    12  u32  slot_count
+ *    16  u32  slot_size      distance between consecutive slots
+ *    20  u32  pixel_capacity pixel bytes a slot can hold
+ *    24  u32  latest         number of the newest complete frame, 0 = none
+ *    28  u32  writer_pid
+ *
+ *   Slot i at header_size + i × slot_size: a 64-byte slot header, then
+ *   the pixels (rows packed, `stride` bytes apart)
+ *     0  u32  seq            seqlock counter, odd while being written
+ *     4  u32  frame          frame number; frame N lives in slot
+ *                            N % slot_count
+ *     8  u64  timestamp_ns   CLOCK_MONOTONIC at publish
+ *    16  u32  width
+ *    20  u32  height
+ *    24  u32  stride
+ *    28  u32  format         YAGE_OUTPUT_* (yage_libretro.h)
+ *
+ * Reading: load `latest` (acquire), then the slot's seq (acquire).  If
+ * seq is odd or the slot's frame is not `latest`, retry.  Use the
+ * pixels, then re-read seq after an acquire fence: if it changed, the
+ * writer lapped the reader and the frame must be discarded.  A slot is
+ * rewritten only every slot_count frames, so readers have that long to
+ * consume it in place.  The writer never waits for readers.
+ *
+ * Internal to yage_core — the FFI surface is yage_frame_export_* in
+ * yage_libretro.h.  Linux / macOS only; elsewhere opening always fails.
+ */
+
+#ifndef YAGE_SHM_H
+#define YAGE_SHM_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define YAGE_SHM_MAGIC    0x52464759u   /* "YGFR" */
+#define YAGE_SHM_VERSION  1
+
+/* Create the shared-memory object `name` (a leading '/' is added if
+ * missing) holding `slots` frames of up to `pixel_capacity` bytes each,
+ * replacing any stale object of that name.  Returns 0 on success, -1 if
+ * already open or on failure. */
+int yage_shm_open(const char* name, int slots, size_t pixel_capacity);
+
+/* Stop publishing, unmap and unlink the object.  Readers that still have
+ * it mapped keep their (now frozen) view. */
+void yage_shm_close(void);
+
+/* Nonzero while the ring is open. */
+int yage_shm_active(void);
+
+/* Publish one frame (`format` is YAGE_OUTPUT_*, rows packed).  Frames
+ * larger than a slot are dropped.  Producer thread only; never blocks. */
+void yage_shm_publish(const void* pixels, int width, int height, int format);
+
+/* Frames published and dropped since the ring was opened. */
+void yage_shm_stats(uint32_t* published, uint32_t* dropped);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* YAGE_SHM_H */
@@ -0,0 +1,225 @@
+/*
+ * YAGE Audio Time-Stretch — Implementation
+ *
+ * `buf` holds the input not yet skimmed past (interleaved) and `mono` the
+ * matching L + R sums the similarity search runs on.  `pos` is the nominal
+ * start of the next sequence within buf; it may run past the end of buf
+ * at high tempo, in which case input is skipped as it arrives.  `tail` is
+ * the last `overlap` frames of the previous sequence — where the output
+ * would have continued — and the next sequence is faded in over it.
+ *
+ * Priming: right after a reset the input is passed through unchanged
+ * (less the overlap held back as the tail) until half a sequence has gone
+ * out.
+ * The stretched steps need seek + sequence frames before their first
+ * output; passing through meanwhile keeps the device fed when fast-forward
+ * starts.  pos is left on the tail, so the first search finds it in place
+ * and the hand-over is seamless.
+ *
+ * One step needs seek + sequence frames from pos, writes sequence -
+ * overlap frames (the fade plus the sequence body) and advances pos by
+ * that many frames times the tempo.  The search compares the tail with
+ * every STRETCH_COARSE-th candidate and then refines around the best one,
+ * scoring by correlation normalised by the candidate's energy.
+ */
+
+#include "yage_stretch.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define STRETCH_CHUNK   4096   /* input frames buffered per pass */
+#define STRETCH_COARSE  4      /* search stride before refinement */
+
+struct YageStretch {
+    int      sequence;    /* frames per sequence, overlap included */
+    int      overlap;
+    int      seek;
+    int      len;         /* frames in buf / mono */
+    double   pos;
+    int      have_tail;
+    int      primed;      /* frames passed through since the reset */
+    int16_t* buf;         /* seek + sequence + STRETCH_CHUNK frames */
+    float*   mono;
+    int16_t* tail;        /* overlap frames, interleaved */
+    float*   tail_mono;
+};
+
+static inline int16_t to_s16(float v) {
+    int s = (int)(v + (v >= 0.0f ? 0.5f : -0.5f));
+    if (s > 32767) s = 32767;
+    if (s < -32768) s = -32768;
+    return (int16_t)s;
+}
+
+YageStretch* yage_stretch_create(double rate) {
+    if (rate < 8000.0 || rate > 192000.0) return NULL;
+    YageStretch* st = (YageStretch*)calloc(1, sizeof(YageStretch));
+    if (!st) return NULL;
+    st->sequence = (int)(rate * YAGE_STRETCH_SEQUENCE_MS / 1000.0);
+    st->overlap = (int)(rate * YAGE_STRETCH_OVERLAP_MS / 1000.0);
+    st->seek = (int)(rate * YAGE_STRETCH_SEEK_MS / 1000.0);
+
+    size_t room = (size_t)(st->seek + st->sequence + STRETCH_CHUNK);
+    st->buf = (int16_t*)malloc(room * 2 * sizeof(int16_t));
+    st->mono = (float*)malloc(room * sizeof(float));
+    st->tail = (int16_t*)malloc((size_t)st->overlap * 2 * sizeof(int16_t));
+    st->tail_mono = (float*)malloc((size_t)st->overlap * sizeof(float));
+    if (!st->buf || !st->mono || !st->tail || !st->tail_mono) {
+        yage_stretch_destroy(st);
+        return NULL;
+    }
+    return st;
+}
+
+void yage_stretch_destroy(YageStretch* st) {
+    if (!st) return;
+    free(st->buf);
+    free(st->mono);
+    free(st->tail);
+    free(st->tail_mono);
+    free(st);
+}
+
+void yage_stretch_reset(YageStretch* st) {
+    if (!st) return;
+    st->len = 0;
+    st->pos = 0.0;
+    st->have_tail = 0;
+    st->primed = 0;
+}
+
+size_t yage_stretch_max_output(const YageStretch* st, size_t in_frames) {
+    if (!st) return 0;
+    /* Each step writes sequence - overlap frames and consumes at least as
+     * many; the last one may start just before the end of the input */
+    return in_frames + (size_t)st->len + (size_t)st->sequence;
+}
+
+static float similarity(const float* ref, const float* x, int n) {
+    float corr = 0.0f, energy = 0.0f;
+    for (int k = 0; k < n; k++) {
+        corr += ref[k] * x[k];
+        energy += x[k] * x[k];
+    }
+    return energy > 0.0f ? corr / sqrtf(energy) : 0.0f;
+}
+
+/* Offset in [0, seek) from `base` where the tail fits best */
+static int best_offset(const YageStretch* st, int base) {
+    const float* x = st->mono + base;
+    int best = 0;
+    float best_score = -INFINITY;
+    for (int off = 0; off < st->seek; off += STRETCH_COARSE) {
+        float s = similarity(st->tail_mono, x + off, st->overlap);
+        if (s > best_score) {
+            best_score = s;
+            best = off;
+        }
+    }
+    int lo = best - STRETCH_COARSE + 1, hi = best + STRETCH_COARSE - 1;
+    if (lo < 0) lo = 0;
+    if (hi > st->seek - 1) hi = st->seek - 1;
+    int coarse = best;
+    for (int off = lo; off <= hi; off++) {
+        if (off == coarse) continue;
+        float s = similarity(st->tail_mono, x + off, st->overlap);
+        if (s > best_score) {
+            best_score = s;
+            best = off;
+        }
+    }
+    return best;
+}
+
+size_t yage_stretch_process(YageStretch* st, const int16_t* in, size_t in_frames,
+                            double tempo, int16_t* out, size_t out_capacity) {
+    if (!st || !in) return 0;
+    if (tempo < 1.0) tempo = 1.0;
+    if (tempo > YAGE_STRETCH_MAX_TEMPO) tempo = YAGE_STRETCH_MAX_TEMPO;
+    const int ov = st->overlap;
+    const int body = st->sequence - ov;   /* frames written per step */
+    const int room = st->seek + st->sequence + STRETCH_CHUNK;
+    size_t produced = 0;
+
+    while (in_frames > 0) {
+        /* Input the current pos has already skipped past never lands */
+        int skip = (int)st->pos - st->len;
+        if (skip > 0) {
+            if ((size_t)skip > in_frames) skip = (int)in_frames;
+            in += 2 * (size_t)skip;
+            in_frames -= (size_t)skip;
+            st->pos -= skip;
+            continue;
+        }
+
+        int n = room - st->len;
+        if ((size_t)n > in_frames) n = (int)in_frames;
+        memcpy(st->buf + 2 * st->len, in, (size_t)n * 2 * sizeof(int16_t));
+        for (int i = 0; i < n; i++)
+            st->mono[st->len + i] = (float)in[2 * i] + (float)in[2 * i + 1];
+        in += 2 * (size_t)n;
+        in_frames -= (size_t)n;
+        st->len += n;
+
+        if (st->primed < st->sequence / 2 && st->len - ov > (int)st->pos) {
+            int from = (int)st->pos, to = st->len - ov;
+            size_t pass = (size_t)(to - from);
+            if (pass > out_capacity - produced) pass = out_capacity - produced;
+            memcpy(out + 2 * produced, st->buf + 2 * from, pass * 2 * sizeof(int16_t));
+            produced += pass;
+            memcpy(st->tail, st->buf + 2 * to, (size_t)ov * 2 * sizeof(int16_t));
+            memcpy(st->tail_mono, st->mono + to, (size_t)ov * sizeof(float));
+            st->have_tail = 1;
+            st->primed += to - from;
+            st->pos = to;
+        }
+
+        while (st->primed >= st->sequence / 2) {
+            int base = (int)st->pos;
+            if (base + st->seek + st->sequence > st->len) break;
+            int start = base + best_offset(st, base);
+            const int16_t* seq = st->buf + 2 * start;
+
+            if (produced + (size_t)body <= out_capacity) {
+                int16_t* o = out + 2 * produced;
+                for (int k = 0; k < ov; k++) {
+                    float w = (k + 0.5f) / ov;
+                    o[2 * k] = to_s16(st->tail[2 * k] + (seq[2 * k] - st->tail[2 * k]) * w);
+                    o[2 * k + 1] = to_s16(st->tail[2 * k + 1] +
+                                          (seq[2 * k + 1] - st->tail[2 * k + 1]) * w);
+                }
+                memcpy(o + 2 * ov, seq + 2 * ov, (size_t)(body - ov) * 2 * sizeof(int16_t));
+                produced += (size_t)body;
+            }
+
+            memcpy(st->tail, seq + 2 * body, (size_t)ov * 2 * sizeof(int16_t));
+            memcpy(st->tail_mono, st->mono + start + body, (size_t)ov * sizeof(float));
+            st->pos += body * tempo;
+        }
+
+        int drop = (int)st->pos;
+        if (drop > st->len) drop = st->len;
+        if (drop > 0) {
+            memmove(st->buf, st->buf + 2 * drop, (size_t)(st->len - drop) * 2 * sizeof(int16_t));
+            memmove(st->mono, st->mono + drop, (size_t)(st->len - drop) * sizeof(float));
+            st->len -= drop;
+            st->pos -= drop;
+        }
+    }
+    return produced;
+}
+
+void yage_stretch_finish(YageStretch* st, int16_t* io, size_t frames) {
+    if (!st) return;
+    if (st->have_tail && io && frames > 0) {
+        int n = frames < (size_t)st->overlap ? (int)frames : st->overlap;
+        for (int k = 0; k < n; k++) {
+            float w = (k + 0.5f) / n;
+            io[2 * k] = to_s16(st->tail[2 * k] + (io[2 * k] - st->tail[2 * k]) * w);
+            io[2 * k + 1] = to_s16(st->tail[2 * k + 1] + (io[2 * k + 1] - st->tail[2 * k + 1]) * w);
+        }
+    }
+    yage_stretch_reset(st);
+}
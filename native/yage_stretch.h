@@ -0,0 +1,68 @@
+/*
+ * YAGE Audio Time-Stretch
+ *
+ * Plays audio faster than it was produced without raising its pitch, so
+ * fast-forward still sounds like the game rather than a chipmunk version
+ * of it.  WSOLA (waveform-similarity overlap-add): the input is cut into
+ * sequences of YAGE_STRETCH_SEQUENCE_MS that are laid end to end with a
+ * YAGE_STRETCH_OVERLAP_MS cross-fade, while the read position advances
+ * `tempo` times faster than the output.  Each new sequence starts at the
+ * point within YAGE_STRETCH_SEEK_MS of its nominal position whose waveform
+ * best matches the tail it is faded into, which keeps the joins free of
+ * phase cancellation and clicks.
+ *
+ * Operates on interleaved 16-bit stereo at a fixed rate (the device rate:
+ * the engine stretches after resampling).  The tempo may change on every
+ * call.  Adds about SEQUENCE + SEEK of input of latency.
+ *
+ * Platform-independent.  Internal to yage_core — not part of the FFI
+ * surface.
+ */
+
+#ifndef YAGE_STRETCH_H
+#define YAGE_STRETCH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define YAGE_STRETCH_SEQUENCE_MS 40
+#define YAGE_STRETCH_OVERLAP_MS  8
+#define YAGE_STRETCH_SEEK_MS     15
+#define YAGE_STRETCH_MAX_TEMPO   16.0
+
+typedef struct YageStretch YageStretch;
+
+/* Stretcher for audio at `rate` Hz.  Returns NULL for rates outside
+ * 8 kHz..192 kHz or on allocation failure. */
+YageStretch* yage_stretch_create(double rate);
+void yage_stretch_destroy(YageStretch* st);
+
+/* Forget the buffered input and the pending overlap. */
+void yage_stretch_reset(YageStretch* st);
+
+/* Upper bound on the frames yage_stretch_process can return for
+ * `in_frames` input frames at any tempo of 1 or more. */
+size_t yage_stretch_max_output(const YageStretch* st, size_t in_frames);
+
+/* Consume `in_frames` stereo frames and write the stretched output, about
+ * in_frames / tempo frames once the pipeline is primed, to `out`.  `tempo`
+ * is clamped to 1..YAGE_STRETCH_MAX_TEMPO.  Returns the frames written;
+ * output beyond `out_capacity` is discarded. */
+size_t yage_stretch_process(YageStretch* st, const int16_t* in, size_t in_frames,
+                            double tempo, int16_t* out, size_t out_capacity);
+
+/* Leave time-stretching: cross-fade the pending overlap into the start of
+ * `io` (the first `frames` frames played at normal speed), in place, and
+ * reset.  The input still buffered is dropped — it was only ever going to
+ * be skimmed. */
+void yage_stretch_finish(YageStretch* st, int16_t* io, size_t frames);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* YAGE_STRETCH_H */